@@ -0,0 +1,143 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+
+#include "config-keepassx.h"
+#include "git-info.h"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QSysInfo>
+#include <QTextStream>
+#include <QThread>
+
+#include <algorithm>
+#include <cmath>
+
+Benchmark::Benchmark(int iterations)
+    : m_iterations(qMax(1, iterations))
+{
+}
+
+void Benchmark::setFilter(const QString& pattern)
+{
+    m_filter.setPattern(pattern);
+}
+
+void Benchmark::setParameters(const QJsonObject& parameters)
+{
+    m_parameters = parameters;
+}
+
+bool Benchmark::isSelected(const QString& name) const
+{
+    return m_filter.pattern().isEmpty() || m_filter.match(name).hasMatch();
+}
+
+void Benchmark::run(const QString& name, const std::function<void()>& body, const std::function<void()>& setup)
+{
+    if (!isSelected(name)) {
+        return;
+    }
+
+    Result result;
+    result.name = name;
+    result.samples.reserve(m_iterations);
+
+    QElapsedTimer timer;
+    for (int i = -1; i < m_iterations; ++i) {
+        if (setup) {
+            setup();
+        }
+        timer.start();
+        body();
+        auto elapsed = timer.nsecsElapsed();
+        // The first iteration only warms up caches and lazy initialization
+        if (i >= 0) {
+            result.samples.append(elapsed);
+        }
+    }
+
+    m_results.append(result);
+}
+
+QJsonObject Benchmark::toJson() const
+{
+    QJsonArray results;
+    for (const auto& result : m_results) {
+        auto samples = result.samples;
+        std::sort(samples.begin(), samples.end());
+
+        double mean = 0;
+        for (auto sample : samples) {
+            mean += sample;
+        }
+        mean /= samples.size();
+
+        double variance = 0;
+        for (auto sample : samples) {
+            variance += (sample - mean) * (sample - mean);
+        }
+        variance /= samples.size();
+
+        const int mid = samples.size() / 2;
+        const double median = samples.size() % 2 ? samples[mid] : (samples[mid - 1] + samples[mid]) / 2.0;
+
+        QJsonObject object;
+        object["name"] = result.name;
+        object["unit"] = QStringLiteral("ns");
+        object["iterations"] = samples.size();
+        object["min"] = static_cast<double>(samples.first());
+        object["median"] = median;
+        object["mean"] = mean;
+        object["max"] = static_cast<double>(samples.last());
+        object["stddev"] = std::sqrt(variance);
+        results.append(object);
+    }
+
+    QJsonObject environment;
+    environment["version"] = QStringLiteral(KEEPASSXC_VERSION);
+    environment["commit"] = QStringLiteral(GIT_HEAD);
+    environment["qt"] = QString(qVersion());
+    environment["os"] = QSysInfo::prettyProductName();
+    environment["cpu"] = QSysInfo::currentCpuArchitecture();
+    environment["threads"] = QThread::idealThreadCount();
+
+    QJsonObject root;
+    root["schema"] = 1;
+    root["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["environment"] = environment;
+    root["parameters"] = m_parameters;
+    root["results"] = results;
+    return root;
+}
+
+QString Benchmark::summary() const
+{
+    QString text;
+    QTextStream stream(&text);
+    for (const auto& result : m_results) {
+        auto samples = result.samples;
+        std::sort(samples.begin(), samples.end());
+        stream << result.name.leftJustified(32) << " median "
+               << QString::number(samples[samples.size() / 2] / 1e6, 'f', 3) << " ms, min "
+               << QString::number(samples.first() / 1e6, 'f', 3) << " ms\n";
+    }
+    return text;
+}
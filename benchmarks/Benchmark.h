@@ -0,0 +1,61 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef KEEPASSXC_BENCHMARK_H
+#define KEEPASSXC_BENCHMARK_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QRegularExpression>
+#include <QVector>
+
+#include <functional>
+
+/**
+ * Minimal benchmark harness producing machine-readable results.
+ *
+ * Every case runs one untimed warm-up iteration followed by a fixed number of
+ * timed iterations. The optional setup function runs before each iteration and
+ * is not included in the measurement.
+ */
+class Benchmark
+{
+public:
+    explicit Benchmark(int iterations);
+
+    void setFilter(const QString& pattern);
+    void setParameters(const QJsonObject& parameters);
+
+    bool isSelected(const QString& name) const;
+    void run(const QString& name, const std::function<void()>& body, const std::function<void()>& setup = {});
+
+    QJsonObject toJson() const;
+    QString summary() const;
+
+private:
+    struct Result
+    {
+        QString name;
+        QVector<qint64> samples;
+    };
+
+    int m_iterations;
+    QRegularExpression m_filter;
+    QJsonObject m_parameters;
+    QList<Result> m_results;
+};
+
+#endif // KEEPASSXC_BENCHMARK_H
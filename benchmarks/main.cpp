@@ -0,0 +1,346 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Benchmark.h"
+
+#include "config-keepassx.h"
+#include "core/Config.h"
+#include "core/Database.h"
+#include "core/DatabaseGenerator.h"
+#include "core/EntrySearcher.h"
+#include "core/Group.h"
+#include "core/Merger.h"
+#include "core/PasswordHealth.h"
+#include "crypto/Crypto.h"
+#include "crypto/kdf/AesKdf.h"
+#include "crypto/kdf/Argon2Kdf.h"
+#include "format/CsvExporter.h"
+#include "format/CsvParser.h"
+#include "format/Kdbx4Reader.h"
+#include "format/Kdbx4Writer.h"
+#include "format/KdbxXmlCodec.h"
+#include "format/KdbxXmlReader.h"
+#include "format/KdbxXmlWriter.h"
+#include "format/KeePass2.h"
+#include "gui/entry/EntryModel.h"
+#include "keys/CompositeKey.h"
+#include "keys/PasswordKey.h"
+
+#ifdef WITH_XC_BROWSER
+#include "browser/BrowserService.h"
+#endif
+
+#include <QBuffer>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonDocument>
+#include <QRandomGenerator>
+#include <QTemporaryFile>
+#include <QTextStream>
+
+namespace
+{
+    QSharedPointer<Kdf> fastKdf()
+    {
+        auto kdf = KeePass2::uuidToKdf(KeePass2::KDF_AES_KDBX4);
+        kdf->setRounds(1);
+        return kdf;
+    }
+
+    QByteArray writeKdbx(Database* db)
+    {
+        QBuffer buffer;
+        buffer.open(QBuffer::ReadWrite);
+        Kdbx4Writer writer;
+        if (!writer.writeDatabase(&buffer, db)) {
+            qFatal("Failed to write database: %s", qPrintable(writer.errorString()));
+        }
+        return buffer.data();
+    }
+
+    QSharedPointer<Database> readKdbx(const QByteArray& data, const QSharedPointer<const CompositeKey>& key)
+    {
+        QBuffer buffer;
+        buffer.setData(data);
+        buffer.open(QBuffer::ReadOnly);
+        auto db = QSharedPointer<Database>::create();
+        Kdbx4Reader reader;
+        if (!reader.readDatabase(&buffer, key, db.data())) {
+            qFatal("Failed to read database: %s", qPrintable(reader.errorString()));
+        }
+        return db;
+    }
+
+    void benchmarkKdf(Benchmark& benchmark, const QSharedPointer<const CompositeKey>& key)
+    {
+        AesKdf aesKdf(false);
+        aesKdf.setRounds(100000);
+        aesKdf.randomizeSeed();
+
+        Argon2Kdf argon2Kdf(Argon2Kdf::Type::Argon2id);
+        argon2Kdf.setRounds(2);
+        argon2Kdf.setMemory(64 * 1024);
+        argon2Kdf.setParallelism(2);
+        argon2Kdf.randomizeSeed();
+
+        QByteArray result;
+        benchmark.run("kdf/aes-100000", [&] { Q_UNUSED(key->transform(aesKdf, result)); });
+        benchmark.run("kdf/argon2id-64mib", [&] { Q_UNUSED(key->transform(argon2Kdf, result)); });
+    }
+
+    void benchmarkFormat(Benchmark& benchmark, Database* db, const QSharedPointer<const CompositeKey>& key)
+    {
+        const auto kdbx = writeKdbx(db);
+        benchmark.run("kdbx4/write", [&] { writeKdbx(db); });
+        benchmark.run("kdbx4/read", [&] { readKdbx(kdbx, key); });
+
+        QBuffer xml;
+        xml.open(QBuffer::ReadWrite);
+        KdbxXmlWriter xmlWriter(KeePass2::FILE_VERSION_4);
+        xmlWriter.writeDatabase(&xml, db);
+        benchmark.run(
+            "xml/read",
+            [&] {
+                KdbxXmlReader reader(KeePass2::FILE_VERSION_4);
+                reader.readDatabase(&xml);
+            },
+            [&] { xml.seek(0); });
+    }
+
+    void benchmarkCodec(Benchmark& benchmark)
+    {
+        const int size = 1024 * 1024;
+        QRandomGenerator random(1);
+
+        QString ascii(size, Qt::Uninitialized);
+        QString unicode(size, Qt::Uninitialized);
+        QByteArray binary(size, Qt::Uninitialized);
+        for (int i = 0; i < size; ++i) {
+            ascii[i] = QLatin1Char(static_cast<char>(0x20 + random.bounded(0x5F)));
+            unicode[i] = QChar(static_cast<ushort>(0x4E00 + random.bounded(0x5000)));
+            binary[i] = static_cast<char>(random.bounded(256));
+        }
+        const QString encoded = QString::fromLatin1(binary.toBase64());
+
+        benchmark.run("codec/strip-xml-ascii", [&] { KdbxXmlCodec::stripInvalidXml10Chars(ascii); });
+        benchmark.run("codec/strip-xml-unicode", [&] { KdbxXmlCodec::stripInvalidXml10Chars(unicode); });
+
+        QString buffer;
+        benchmark.run("codec/base64-encode", [&] { KdbxXmlCodec::toBase64(binary, buffer); });
+        benchmark.run("codec/base64-encode-qt", [&] { QString::fromLatin1(binary.toBase64()); });
+        benchmark.run("codec/base64-decode", [&] { KdbxXmlCodec::fromBase64(encoded); });
+        benchmark.run("codec/base64-decode-qt", [&] { QByteArray::fromBase64(encoded.toLatin1()); });
+    }
+
+    void benchmarkSearch(Benchmark& benchmark, Database* db)
+    {
+        EntrySearcher searcher;
+        benchmark.run("search/term", [&] { searcher.search("alpha", db->rootGroup()); });
+        benchmark.run("search/fields", [&] { searcher.search("url:bravo title:charlie", db->rootGroup()); });
+        benchmark.run("search/no-match", [&] { searcher.search("doesnotexist", db->rootGroup()); });
+    }
+
+    void benchmarkMerge(Benchmark& benchmark, Database* db, const QSharedPointer<const CompositeKey>& key)
+    {
+        if (!benchmark.isSelected("merge/ten-percent")) {
+            return;
+        }
+
+        // Source is a copy of the database with every tenth entry changed
+        const auto kdbx = writeKdbx(db);
+        auto source = readKdbx(kdbx, key);
+        const auto entries = source->rootGroup()->entriesRecursive();
+        for (int i = 0; i < entries.size(); i += 10) {
+            entries[i]->setPassword(QStringLiteral("changed %1").arg(i));
+        }
+
+        QSharedPointer<Database> target;
+        benchmark.run(
+            "merge/ten-percent",
+            [&] {
+                Merger merger(source.data(), target.data());
+                merger.merge();
+            },
+            [&] { target = readKdbx(kdbx, key); });
+    }
+
+    void benchmarkModel(Benchmark& benchmark, Database* db, const QSharedPointer<const CompositeKey>& key)
+    {
+        if (!benchmark.isSelected("model/bulk-move")) {
+            return;
+        }
+
+        // Move every entry out of a group that is shown in an entry model
+        const auto kdbx = writeKdbx(db);
+        QScopedPointer<EntryModel> model;
+        QSharedPointer<Database> target;
+        Group* source = nullptr;
+        benchmark.run(
+            "model/bulk-move",
+            [&] { target->moveEntries(source->entries(), target->rootGroup()); },
+            [&] {
+                model.reset(new EntryModel());
+                target = readKdbx(kdbx, key);
+                source = new Group();
+                source->setParent(target->rootGroup());
+                target->moveEntries(target->rootGroup()->entriesRecursive(), source);
+                model->setGroup(source);
+            });
+    }
+
+    void benchmarkHealth(Benchmark& benchmark, const QSharedPointer<Database>& db)
+    {
+        const auto entries = db->rootGroup()->entriesRecursive();
+        benchmark.run("health/evaluate", [&] {
+            HealthChecker checker(db);
+            checker.evaluate(entries);
+        });
+    }
+
+    void benchmarkCsv(Benchmark& benchmark, const QSharedPointer<Database>& db)
+    {
+        if (!benchmark.isSelected("csv/parse")) {
+            return;
+        }
+
+        QTemporaryFile file;
+        CsvExporter exporter;
+        if (!file.open() || !exporter.exportDatabase(&file, db)) {
+            qFatal("Failed to export CSV: %s", qPrintable(exporter.errorString()));
+        }
+        file.close();
+
+        benchmark.run("csv/parse", [&] {
+            CsvParser parser;
+            QFile input(file.fileName());
+            parser.parse(&input);
+        });
+    }
+
+    void benchmarkBrowser(Benchmark& benchmark, const QSharedPointer<Database>& db)
+    {
+#ifdef WITH_XC_BROWSER
+        const QString url("https://alpha7.example.com/login");
+        benchmark.run("browser/search-entries", [&] { browserService()->searchEntries(db, url, url); });
+#else
+        Q_UNUSED(benchmark);
+        Q_UNUSED(db);
+#endif
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("keepassxc-benchmark");
+    QCoreApplication::setApplicationVersion(KEEPASSXC_VERSION);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        QCoreApplication::translate("main", "Measure KeePassXC core operations on a synthetic database."));
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    DatabaseGenerator::Options defaults;
+    QCommandLineOption entriesOption("entries", "Number of entries.", "count", QString::number(defaults.entries));
+    QCommandLineOption groupsOption("groups", "Number of groups.", "count", QString::number(defaults.groups));
+    QCommandLineOption depthOption(
+        "depth", "Maximum depth of the group tree.", "levels", QString::number(defaults.depth));
+    QCommandLineOption historyOption(
+        "history", "Number of history items per entry.", "count", QString::number(defaults.historyItems));
+    QCommandLineOption attachmentsOption("attachments",
+                                         "Percentage of entries with an attachment.",
+                                         "percent",
+                                         QString::number(defaults.attachmentPercent));
+    QCommandLineOption attachmentSizeOption(
+        "attachment-size", "Median attachment size in bytes.", "bytes", QString::number(defaults.attachmentSize));
+    QCommandLineOption seedOption("seed", "Seed for the generated data.", "seed", QString::number(defaults.seed));
+    QCommandLineOption iterationsOption("iterations", "Timed iterations per benchmark.", "count", "10");
+    QCommandLineOption filterOption("filter", "Only run benchmarks matching this regular expression.", "regex");
+    QCommandLineOption outputOption("output", "Write the JSON results to this file instead of stdout.", "file");
+    parser.addOptions({entriesOption,
+                       groupsOption,
+                       depthOption,
+                       historyOption,
+                       attachmentsOption,
+                       attachmentSizeOption,
+                       seedOption,
+                       iterationsOption,
+                       filterOption,
+                       outputOption});
+    parser.process(app);
+
+    if (!Crypto::init()) {
+        qFatal("Fatal error while testing the cryptographic functions:\n%s", qPrintable(Crypto::errorString()));
+    }
+    // Never touch the user's configuration
+    Config::createTempFileInstance();
+
+    DatabaseGenerator::Options options;
+    options.entries = parser.value(entriesOption).toInt();
+    options.groups = parser.value(groupsOption).toInt();
+    options.depth = parser.value(depthOption).toInt();
+    options.historyItems = parser.value(historyOption).toInt();
+    options.attachmentPercent = parser.value(attachmentsOption).toInt();
+    options.attachmentSize = parser.value(attachmentSizeOption).toInt();
+    options.seed = parser.value(seedOption).toUInt();
+
+    QJsonObject parameters;
+    parameters["entries"] = options.entries;
+    parameters["groups"] = options.groups;
+    parameters["depth"] = options.depth;
+    parameters["history"] = options.historyItems;
+    parameters["attachmentPercent"] = options.attachmentPercent;
+    parameters["attachmentSize"] = options.attachmentSize;
+    parameters["seed"] = static_cast<qint64>(options.seed);
+
+    Benchmark benchmark(parser.value(iterationsOption).toInt());
+    benchmark.setFilter(parser.value(filterOption));
+    benchmark.setParameters(parameters);
+
+    auto key = QSharedPointer<CompositeKey>::create();
+    key->addKey(QSharedPointer<PasswordKey>::create("benchmark"));
+
+    auto db = QSharedPointer<Database>::create();
+    DatabaseGenerator(options).populate(db.data());
+    db->changeKdf(fastKdf());
+    db->setKey(key);
+
+    benchmarkKdf(benchmark, key);
+    benchmarkFormat(benchmark, db.data(), key);
+    benchmarkCodec(benchmark);
+    benchmarkSearch(benchmark, db.data());
+    benchmarkMerge(benchmark, db.data(), key);
+    benchmarkModel(benchmark, db.data(), key);
+    benchmarkHealth(benchmark, db);
+    benchmarkCsv(benchmark, db);
+    benchmarkBrowser(benchmark, db);
+
+    const auto json = QJsonDocument(benchmark.toJson()).toJson();
+    if (parser.isSet(outputOption)) {
+        QFile output(parser.value(outputOption));
+        if (!output.open(QFile::WriteOnly | QFile::Truncate) || output.write(json) != json.size()) {
+            qCritical("Failed to write %s: %s", qPrintable(output.fileName()), qPrintable(output.errorString()));
+            return EXIT_FAILURE;
+        }
+    } else {
+        QTextStream(stdout) << json;
+    }
+    QTextStream(stderr) << benchmark.summary();
+
+    return EXIT_SUCCESS;
+}
@@ -32,6 +32,7 @@
 #include "core/Global.h"
 #include "core/Resources.h"
 #include "core/Tools.h"
+#include "core/Trace.h"
 #include "gui/MainWindow.h"
 #include "gui/MessageBox.h"
 #include "gui/osutils/OSUtils.h"
@@ -434,6 +435,8 @@ void AutoType::startGlobalAutoType(const QString& search)
  */
 void AutoType::performGlobalAutoType(const QList<QSharedPointer<Database>>& dbList, const QString& search)
 {
+    TRACE_SPAN("AutoType::performGlobalAutoType");
+
     if (!m_plugin) {
         return;
     }
@@ -26,6 +26,7 @@
 #include "BrowserSettings.h"
 #include "core/EntryAttributes.h"
 #include "core/Tools.h"
+#include "core/Trace.h"
 #include "gui/MainWindow.h"
 #include "gui/MessageBox.h"
 #include "gui/UrlTools.h"
@@ -83,13 +84,17 @@ BrowserService::BrowserService()
     , m_keepassBrowserUUID(Tools::hexToUuid("de887cc3036343b8974b5911b8816224"))
 {
     connect(m_browserHost, &BrowserHost::clientMessageReceived, this, &BrowserService::processClientMessage);
-    connect(getMainWindow(), &MainWindow::databaseUnlocked, this, &BrowserService::databaseUnlocked);
-    connect(getMainWindow(), &MainWindow::databaseLocked, this, &BrowserService::databaseLocked);
-    connect(getMainWindow(), &MainWindow::activeDatabaseChanged, this, &BrowserService::activeDatabaseChanged);
-    connect(getMainWindow(),
-            &MainWindow::databaseUnlockDialogFinished,
-            this,
-            &BrowserService::handleDatabaseUnlockDialogFinished);
+    // There is no main window when used without the GUI, e.g. by the benchmarks
+    auto mainWindow = getMainWindow();
+    if (mainWindow) {
+        connect(mainWindow, &MainWindow::databaseUnlocked, this, &BrowserService::databaseUnlocked);
+        connect(mainWindow, &MainWindow::databaseLocked, this, &BrowserService::databaseLocked);
+        connect(mainWindow, &MainWindow::activeDatabaseChanged, this, &BrowserService::activeDatabaseChanged);
+        connect(mainWindow,
+                &MainWindow::databaseUnlockDialogFinished,
+                this,
+                &BrowserService::handleDatabaseUnlockDialogFinished);
+    }
 
     setEnabled(browserSettings()->isEnabled());
 }
@@ -371,6 +376,8 @@ QString BrowserService::getCurrentTotp(const QString& uuid)
 QJsonArray
 BrowserService::findEntries(const EntryParameters& entryParameters, const StringPairList& keyList, bool* entriesFound)
 {
+    TRACE_SPAN("BrowserService::findEntries");
+
     if (entriesFound) {
         *entriesFound = false;
     }
@@ -1008,6 +1015,10 @@ void BrowserService::removePluginData(Entry* entry) const
     }
 }
 
+/**
+ * Search a single database for entries matching the site and form URL,
+ * honoring the browser settings of its groups and entries.
+ */
 QList<Entry*> BrowserService::searchEntries(const QSharedPointer<Database>& db,
                                             const QString& siteUrl,
                                             const QString& formUrl,
@@ -37,7 +37,7 @@ BrowserSettings* BrowserSettings::instance()
 
 bool BrowserSettings::isEnabled()
 {
-    return config()->get(Config::Browser_Enabled).toBool();
+    return config()->snapshot()->getBool(Config::Browser_Enabled);
 }
 
 void BrowserSettings::setEnabled(bool enabled)
@@ -47,7 +47,7 @@ void BrowserSettings::setEnabled(bool enabled)
 
 bool BrowserSettings::showNotification()
 {
-    return config()->get(Config::Browser_ShowNotification).toBool();
+    return config()->snapshot()->getBool(Config::Browser_ShowNotification);
 }
 
 void BrowserSettings::setShowNotification(bool showNotification)
@@ -57,7 +57,7 @@ void BrowserSettings::setShowNotification(bool showNotification)
 
 bool BrowserSettings::bestMatchOnly()
 {
-    return config()->get(Config::Browser_BestMatchOnly).toBool();
+    return config()->snapshot()->getBool(Config::Browser_BestMatchOnly);
 }
 
 void BrowserSettings::setBestMatchOnly(bool bestMatchOnly)
@@ -67,7 +67,7 @@ void BrowserSettings::setBestMatchOnly(bool bestMatchOnly)
 
 bool BrowserSettings::unlockDatabase()
 {
-    return config()->get(Config::Browser_UnlockDatabase).toBool();
+    return config()->snapshot()->getBool(Config::Browser_UnlockDatabase);
 }
 
 void BrowserSettings::setUnlockDatabase(bool unlockDatabase)
@@ -77,7 +77,7 @@ void BrowserSettings::setUnlockDatabase(bool unlockDatabase)
 
 bool BrowserSettings::matchUrlScheme()
 {
-    return config()->get(Config::Browser_MatchUrlScheme).toBool();
+    return config()->snapshot()->getBool(Config::Browser_MatchUrlScheme);
 }
 
 void BrowserSettings::setMatchUrlScheme(bool matchUrlScheme)
@@ -87,7 +87,7 @@ void BrowserSettings::setMatchUrlScheme(bool matchUrlScheme)
 
 bool BrowserSettings::alwaysAllowAccess()
 {
-    return config()->get(Config::Browser_AlwaysAllowAccess).toBool();
+    return config()->snapshot()->getBool(Config::Browser_AlwaysAllowAccess);
 }
 
 void BrowserSettings::setAlwaysAllowAccess(bool alwaysAllowAccess)
@@ -97,7 +97,7 @@ void BrowserSettings::setAlwaysAllowAccess(bool alwaysAllowAccess)
 
 bool BrowserSettings::alwaysAllowUpdate()
 {
-    return config()->get(Config::Browser_AlwaysAllowUpdate).toBool();
+    return config()->snapshot()->getBool(Config::Browser_AlwaysAllowUpdate);
 }
 
 void BrowserSettings::setAlwaysAllowUpdate(bool alwaysAllowUpdate)
@@ -107,7 +107,7 @@ void BrowserSettings::setAlwaysAllowUpdate(bool alwaysAllowUpdate)
 
 bool BrowserSettings::httpAuthPermission()
 {
-    return config()->get(Config::Browser_HttpAuthPermission).toBool();
+    return config()->snapshot()->getBool(Config::Browser_HttpAuthPermission);
 }
 
 void BrowserSettings::setHttpAuthPermission(bool httpAuthPermission)
@@ -117,7 +117,7 @@ void BrowserSettings::setHttpAuthPermission(bool httpAuthPermission)
 
 bool BrowserSettings::searchInAllDatabases()
 {
-    return config()->get(Config::Browser_SearchInAllDatabases).toBool();
+    return config()->snapshot()->getBool(Config::Browser_SearchInAllDatabases);
 }
 
 void BrowserSettings::setSearchInAllDatabases(bool searchInAllDatabases)
@@ -127,7 +127,7 @@ void BrowserSettings::setSearchInAllDatabases(bool searchInAllDatabases)
 
 bool BrowserSettings::supportKphFields()
 {
-    return config()->get(Config::Browser_SupportKphFields).toBool();
+    return config()->snapshot()->getBool(Config::Browser_SupportKphFields);
 }
 
 void BrowserSettings::setSupportKphFields(bool supportKphFields)
@@ -137,7 +137,7 @@ void BrowserSettings::setSupportKphFields(bool supportKphFields)
 
 bool BrowserSettings::noMigrationPrompt()
 {
-    return config()->get(Config::Browser_NoMigrationPrompt).toBool();
+    return config()->snapshot()->getBool(Config::Browser_NoMigrationPrompt);
 }
 
 void BrowserSettings::setNoMigrationPrompt(bool prompt)
@@ -147,7 +147,7 @@ void BrowserSettings::setNoMigrationPrompt(bool prompt)
 
 bool BrowserSettings::allowLocalhostWithPasskeys()
 {
-    return config()->get(Config::Browser_AllowLocalhostWithPasskeys).toBool();
+    return config()->snapshot()->getBool(Config::Browser_AllowLocalhostWithPasskeys);
 }
 
 void BrowserSettings::setAllowLocalhostWithPasskeys(bool enabled)
@@ -157,7 +157,7 @@ void BrowserSettings::setAllowLocalhostWithPasskeys(bool enabled)
 
 bool BrowserSettings::useCustomProxy()
 {
-    return config()->get(Config::Browser_UseCustomProxy).toBool();
+    return config()->snapshot()->getBool(Config::Browser_UseCustomProxy);
 }
 
 void BrowserSettings::setUseCustomProxy(bool enabled)
@@ -167,7 +167,7 @@ void BrowserSettings::setUseCustomProxy(bool enabled)
 
 QString BrowserSettings::customProxyLocation()
 {
-    return config()->get(Config::Browser_CustomProxyLocation).toString();
+    return config()->snapshot()->getString(Config::Browser_CustomProxyLocation);
 }
 
 void BrowserSettings::setCustomProxyLocation(const QString& location)
@@ -177,7 +177,7 @@ void BrowserSettings::setCustomProxyLocation(const QString& location)
 
 bool BrowserSettings::customBrowserSupport()
 {
-    return config()->get(Config::Browser_UseCustomBrowser).toBool();
+    return config()->snapshot()->getBool(Config::Browser_UseCustomBrowser);
 }
 
 void BrowserSettings::setCustomBrowserSupport(bool enabled)
@@ -187,7 +187,7 @@ void BrowserSettings::setCustomBrowserSupport(bool enabled)
 
 int BrowserSettings::customBrowserType()
 {
-    return config()->get(Config::Browser_CustomBrowserType).toInt();
+    return config()->snapshot()->getInt(Config::Browser_CustomBrowserType);
 }
 
 void BrowserSettings::setCustomBrowserType(int type)
@@ -197,7 +197,7 @@ void BrowserSettings::setCustomBrowserType(int type)
 
 QString BrowserSettings::customBrowserLocation()
 {
-    return config()->get(Config::Browser_CustomBrowserLocation).toString();
+    return config()->snapshot()->getString(Config::Browser_CustomBrowserLocation);
 }
 
 void BrowserSettings::setCustomBrowserLocation(const QString& location)
@@ -218,7 +218,7 @@ QString BrowserSettings::proxyLocationAsInstalled() const
 #ifdef QT_DEBUG
 QString BrowserSettings::customExtensionId()
 {
-    return config()->get(Config::Browser_CustomExtensionId).toString();
+    return config()->snapshot()->getString(Config::Browser_CustomExtensionId);
 }
 
 void BrowserSettings::setCustomExtensionId(const QString& id)
@@ -229,7 +229,7 @@ void BrowserSettings::setCustomExtensionId(const QString& id)
 
 bool BrowserSettings::updateBinaryPath()
 {
-    return config()->get(Config::Browser_UpdateBinaryPath).toBool();
+    return config()->snapshot()->getBool(Config::Browser_UpdateBinaryPath);
 }
 
 void BrowserSettings::setUpdateBinaryPath(bool enabled)
@@ -239,7 +239,7 @@ void BrowserSettings::setUpdateBinaryPath(bool enabled)
 
 bool BrowserSettings::allowGetDatabaseEntriesRequest()
 {
-    return config()->get(Config::Browser_AllowGetDatabaseEntriesRequest).toBool();
+    return config()->snapshot()->getBool(Config::Browser_AllowGetDatabaseEntriesRequest);
 }
 
 void BrowserSettings::setAllowGetDatabaseEntriesRequest(bool enabled)
@@ -249,7 +249,7 @@ void BrowserSettings::setAllowGetDatabaseEntriesRequest(bool enabled)
 
 bool BrowserSettings::allowExpiredCredentials()
 {
-    return config()->get(Config::Browser_AllowExpiredCredentials).toBool();
+    return config()->snapshot()->getBool(Config::Browser_AllowExpiredCredentials);
 }
 
 void BrowserSettings::setAllowExpiredCredentials(bool enabled)
@@ -0,0 +1,369 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Batch.h"
+
+#include "Utils.h"
+#include "core/Global.h"
+#include "core/Group.h"
+#include "core/Metadata.h"
+
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPointer>
+
+const QCommandLineOption Batch::DryRunOption =
+    QCommandLineOption(QStringList() << "dry-run",
+                       QObject::tr("Execute the operations without saving the database afterwards."));
+
+const QCommandLineOption Batch::StopOnErrorOption =
+    QCommandLineOption(QStringList() << "stop-on-error",
+                       QObject::tr("Stop reading operations after the first one that fails."));
+
+namespace
+{
+    // Keys of the JSON operation and result objects
+    const QString OpKey = QStringLiteral("op");
+    const QString IdKey = QStringLiteral("id");
+    const QString OkKey = QStringLiteral("ok");
+    const QString ErrorKey = QStringLiteral("error");
+    const QString EntryKey = QStringLiteral("entry");
+    const QString GroupKey = QStringLiteral("group");
+    const QString AttachmentKey = QStringLiteral("attachment");
+    const QString OutputFileKey = QStringLiteral("file");
+    const QString DataKey = QStringLiteral("data");
+    const QString AttributesKey = QStringLiteral("attributes");
+    const QString AttachmentsKey = QStringLiteral("attachments");
+    const QString ShowProtectedKey = QStringLiteral("show-protected");
+    const QString TotpKey = QStringLiteral("totp");
+    const QString RecycledKey = QStringLiteral("recycled");
+    const QString UuidKey = QStringLiteral("uuid");
+    const QString TitleField = QStringLiteral("title");
+    const QString UsernameField = QStringLiteral("username");
+    const QString PasswordField = QStringLiteral("password");
+    const QString UrlField = QStringLiteral("url");
+    const QString NotesField = QStringLiteral("notes");
+
+    QJsonObject failure(const QString& message)
+    {
+        QJsonObject result;
+        result.insert(OkKey, false);
+        result.insert(ErrorKey, message);
+        return result;
+    }
+
+    QJsonObject success()
+    {
+        QJsonObject result;
+        result.insert(OkKey, true);
+        return result;
+    }
+
+    /**
+     * Set the standard fields present in the operation, returns whether any field was given.
+     */
+    bool applyAttributes(Entry* entry, const QJsonObject& operation)
+    {
+        bool changed = false;
+        if (operation.contains(TitleField)) {
+            entry->setTitle(operation.value(TitleField).toString());
+            changed = true;
+        }
+        if (operation.contains(UsernameField)) {
+            entry->setUsername(operation.value(UsernameField).toString());
+            changed = true;
+        }
+        if (operation.contains(PasswordField)) {
+            entry->setPassword(operation.value(PasswordField).toString());
+            changed = true;
+        }
+        if (operation.contains(UrlField)) {
+            entry->setUrl(operation.value(UrlField).toString());
+            changed = true;
+        }
+        if (operation.contains(NotesField)) {
+            entry->setNotes(operation.value(NotesField).toString());
+            changed = true;
+        }
+        return changed;
+    }
+
+    QJsonObject showEntry(Database* database, const QJsonObject& operation)
+    {
+        const auto entryPath = operation.value(EntryKey).toString();
+        auto entry = database->rootGroup()->findEntryByPath(entryPath);
+        if (!entry) {
+            return failure(QObject::tr("Could not find entry with path %1.").arg(entryPath));
+        }
+
+        bool showProtected = operation.value(ShowProtectedKey).toBool();
+        QStringList attributeNames;
+        for (const auto value : operation.value(AttributesKey).toArray()) {
+            attributeNames << value.toString();
+        }
+        // Explicitly requested attributes are always shown in clear text, as with the show command
+        if (attributeNames.isEmpty()) {
+            attributeNames = entry->attributes()->keys();
+        } else {
+            showProtected = true;
+        }
+
+        QJsonObject attributes;
+        for (const auto& attributeName : asConst(attributeNames)) {
+            if (Utils::EntryFieldNames.contains(attributeName)) {
+                attributes.insert(attributeName, Utils::getTopLevelField(entry, attributeName));
+                continue;
+            }
+
+            auto matches = Utils::findAttributes(*entry->attributes(), attributeName);
+            if (matches.isEmpty()) {
+                return failure(QObject::tr("ERROR: unknown attribute %1.").arg(attributeName));
+            } else if (matches.size() > 1) {
+                return failure(QObject::tr("ERROR: attribute %1 is ambiguous, it matches %2.")
+                                   .arg(attributeName, QLocale().createSeparatedList(matches)));
+            }
+
+            const auto& canonicalName = matches.first();
+            if (entry->attributes()->isProtected(canonicalName) && !showProtected) {
+                attributes.insert(canonicalName, QStringLiteral("PROTECTED"));
+            } else {
+                attributes.insert(canonicalName,
+                                  entry->resolveMultiplePlaceholders(entry->attributes()->value(canonicalName)));
+            }
+        }
+
+        auto result = success();
+        result.insert(AttributesKey, attributes);
+
+        QJsonObject attachments;
+        for (const auto& attachmentName : entry->attachments()->keys()) {
+            attachments.insert(attachmentName, entry->attachments()->value(attachmentName).size());
+        }
+        result.insert(AttachmentsKey, attachments);
+
+        if (operation.value(TotpKey).toBool()) {
+            if (!entry->hasTotp()) {
+                return failure(QObject::tr("Entry with path %1 has no TOTP set up.").arg(entryPath));
+            }
+            result.insert(TotpKey, entry->totp());
+        }
+
+        return result;
+    }
+
+    QJsonObject addEntry(Database* database, const QJsonObject& operation, bool& modified)
+    {
+        const auto entryPath = operation.value(EntryKey).toString();
+        auto entry = database->rootGroup()->addEntryWithPath(entryPath);
+        if (!entry) {
+            return failure(QObject::tr("Could not create entry with path %1.").arg(entryPath));
+        }
+
+        applyAttributes(entry, operation);
+        modified = true;
+
+        auto result = success();
+        result.insert(UuidKey, entry->uuidToHex());
+        return result;
+    }
+
+    QJsonObject editEntry(Database* database, const QJsonObject& operation, bool& modified)
+    {
+        const auto entryPath = operation.value(EntryKey).toString();
+        auto entry = database->rootGroup()->findEntryByPath(entryPath);
+        if (!entry) {
+            return failure(QObject::tr("Could not find entry with path %1.").arg(entryPath));
+        }
+
+        entry->beginUpdate();
+        bool changed = applyAttributes(entry, operation);
+        entry->endUpdate();
+
+        if (!changed) {
+            return failure(QObject::tr("Not changing any field for entry %1.").arg(entryPath));
+        }
+
+        modified = true;
+        return success();
+    }
+
+    QJsonObject removeEntry(Database* database, const QJsonObject& operation, bool& modified)
+    {
+        const auto entryPath = operation.value(EntryKey).toString();
+        QPointer<Entry> entry = database->rootGroup()->findEntryByPath(entryPath);
+        if (!entry) {
+            return failure(QObject::tr("Entry %1 not found.").arg(entryPath));
+        }
+
+        bool recycled = true;
+        auto* recycleBin = database->metadata()->recycleBin();
+        if (!database->metadata()->recycleBinEnabled() || (recycleBin && recycleBin->findEntryByUuid(entry->uuid()))) {
+            delete entry;
+            recycled = false;
+        } else {
+            database->recycleEntry(entry);
+        }
+        modified = true;
+
+        auto result = success();
+        result.insert(RecycledKey, recycled);
+        return result;
+    }
+
+    QJsonObject moveEntry(Database* database, const QJsonObject& operation, bool& modified)
+    {
+        const auto entryPath = operation.value(EntryKey).toString();
+        const auto destinationPath = operation.value(GroupKey).toString();
+
+        auto entry = database->rootGroup()->findEntryByPath(entryPath);
+        if (!entry) {
+            return failure(QObject::tr("Could not find entry with path %1.").arg(entryPath));
+        }
+
+        auto destinationGroup = database->rootGroup()->findGroupByPath(destinationPath);
+        if (!destinationGroup) {
+            return failure(QObject::tr("Could not find group with path %1.").arg(destinationPath));
+        }
+
+        if (destinationGroup == entry->parent()) {
+            return failure(QObject::tr("Entry is already in group %1.").arg(destinationPath));
+        }
+
+        entry->beginUpdate();
+        entry->setGroup(destinationGroup);
+        entry->endUpdate();
+        modified = true;
+
+        return success();
+    }
+
+    QJsonObject exportAttachment(Database* database, const QJsonObject& operation)
+    {
+        const auto entryPath = operation.value(EntryKey).toString();
+        auto entry = database->rootGroup()->findEntryByPath(entryPath);
+        if (!entry) {
+            return failure(QObject::tr("Could not find entry with path %1.").arg(entryPath));
+        }
+
+        const auto attachmentName = operation.value(AttachmentKey).toString();
+        auto attachments = entry->attachments();
+        if (!attachments->hasKey(attachmentName)) {
+            return failure(QObject::tr("Could not find attachment with name %1.").arg(attachmentName));
+        }
+
+        auto result = success();
+        const auto exportFileName = operation.value(OutputFileKey).toString();
+        if (exportFileName.isEmpty()) {
+            // Without a target file the content is returned inline
+            result.insert(DataKey, QString::fromLatin1(attachments->value(attachmentName).toBase64()));
+            return result;
+        }
+
+        QFile exportFile(exportFileName);
+        if (!exportFile.open(QIODevice::WriteOnly)) {
+            return failure(QObject::tr("Could not open output file %1.").arg(exportFileName));
+        }
+        const auto data = attachments->value(attachmentName);
+        if (exportFile.write(data) != data.size()) {
+            return failure(QObject::tr("Could not write output file %1: %2.")
+                               .arg(exportFileName, exportFile.errorString()));
+        }
+        return result;
+    }
+
+    QJsonObject executeOperation(Database* database, const QJsonObject& operation, bool& modified)
+    {
+        const auto op = operation.value(OpKey).toString();
+        if (op == QLatin1String("show")) {
+            return showEntry(database, operation);
+        } else if (op == QLatin1String("add")) {
+            return addEntry(database, operation, modified);
+        } else if (op == QLatin1String("edit")) {
+            return editEntry(database, operation, modified);
+        } else if (op == QLatin1String("rm")) {
+            return removeEntry(database, operation, modified);
+        } else if (op == QLatin1String("mv")) {
+            return moveEntry(database, operation, modified);
+        } else if (op == QLatin1String("attachment-export")) {
+            return exportAttachment(database, operation);
+        }
+        return failure(QObject::tr("Unknown operation %1.").arg(op));
+    }
+} // namespace
+
+Batch::Batch()
+{
+    name = QString("batch");
+    description = QObject::tr("Execute newline-delimited JSON operations read from standard input.");
+    options.append(Batch::DryRunOption);
+    options.append(Batch::StopOnErrorOption);
+}
+
+int Batch::executeWithDatabase(QSharedPointer<Database> database, QSharedPointer<QCommandLineParser> parser)
+{
+    auto& out = Utils::STDOUT;
+    auto& err = Utils::STDERR;
+    auto& in = Utils::STDIN;
+
+    bool stopOnError = parser->isSet(Batch::StopOnErrorOption);
+    bool modified = false;
+    bool encounteredError = false;
+
+    while (!in.atEnd()) {
+        const auto line = in.readLine().trimmed();
+        if (line.isEmpty()) {
+            continue;
+        }
+
+        QJsonParseError parseError;
+        auto document = QJsonDocument::fromJson(line.toUtf8(), &parseError);
+
+        QJsonObject result;
+        if (parseError.error != QJsonParseError::NoError || !document.isObject()) {
+            result = failure(QObject::tr("Invalid operation: %1").arg(parseError.errorString()));
+        } else {
+            auto operation = document.object();
+            result = executeOperation(database.data(), operation, modified);
+            if (operation.contains(IdKey)) {
+                result.insert(IdKey, operation.value(IdKey));
+            }
+        }
+
+        out << QJsonDocument(result).toJson(QJsonDocument::Compact) << Qt::endl;
+
+        if (!result.value(OkKey).toBool()) {
+            encounteredError = true;
+            if (stopOnError) {
+                break;
+            }
+        }
+    }
+
+    // All modifications are written with a single save once the stream is exhausted
+    if (modified && !parser->isSet(Batch::DryRunOption)) {
+        QString errorMessage;
+        if (!database->save(Database::Atomic, {}, &errorMessage)) {
+            err << QObject::tr("Writing the database failed: %1").arg(errorMessage) << Qt::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    return encounteredError ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -21,6 +21,7 @@
 #include "AttachmentExport.h"
 #include "AttachmentImport.h"
 #include "AttachmentRemove.h"
+#include "Batch.h"
 #include "Clip.h"
 #include "Close.h"
 #include "DatabaseCreate.h"
@@ -32,6 +33,7 @@
 #include "Exit.h"
 #include "Export.h"
 #include "Generate.h"
+#include "GenerateDatabase.h"
 #include "Help.h"
 #include "Import.h"
 #include "List.h"
@@ -42,6 +44,7 @@
 #include "RemoveGroup.h"
 #include "Search.h"
 #include "Show.h"
+#include "ShowTotp.h"
 #include "Utils.h"
 
 #include <QCommandLineParser>
@@ -175,6 +178,7 @@ namespace Commands
         s_commands.insert(QStringLiteral("edit"), QSharedPointer<Command>(new Edit()));
         s_commands.insert(QStringLiteral("estimate"), QSharedPointer<Command>(new Estimate()));
         s_commands.insert(QStringLiteral("generate"), QSharedPointer<Command>(new Generate()));
+        s_commands.insert(QStringLiteral("generate-db"), QSharedPointer<Command>(new GenerateDatabase()));
         s_commands.insert(QStringLiteral("help"), QSharedPointer<Command>(new Help()));
         s_commands.insert(QStringLiteral("ls"), QSharedPointer<Command>(new List()));
         s_commands.insert(QStringLiteral("merge"), QSharedPointer<Command>(new Merge()));
@@ -185,11 +189,13 @@ namespace Commands
         s_commands.insert(QStringLiteral("rmdir"), QSharedPointer<Command>(new RemoveGroup()));
         s_commands.insert(QStringLiteral("search"), QSharedPointer<Command>(new Search()));
         s_commands.insert(QStringLiteral("show"), QSharedPointer<Command>(new Show()));
+        s_commands.insert(QStringLiteral("totp"), QSharedPointer<Command>(new ShowTotp()));
 
         if (interactive) {
             s_commands.insert(QStringLiteral("exit"), QSharedPointer<Command>(new Exit("exit")));
             s_commands.insert(QStringLiteral("quit"), QSharedPointer<Command>(new Exit("quit")));
         } else {
+            s_commands.insert(QStringLiteral("batch"), QSharedPointer<Command>(new Batch()));
             s_commands.insert(QStringLiteral("export"), QSharedPointer<Command>(new Export()));
             s_commands.insert(QStringLiteral("import"), QSharedPointer<Command>(new Import()));
         }
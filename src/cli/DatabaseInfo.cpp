@@ -51,7 +51,7 @@ int DatabaseInfo::executeWithDatabase(QSharedPointer<Database> database, QShared
         out << QObject::tr("Recycle bin is not enabled.") << Qt::endl;
     }
 
-    DatabaseStats stats(database);
+    DatabaseStats stats(database->snapshot());
     out << QObject::tr("Location") << ": " << database->filePath() << Qt::endl;
     out << QObject::tr("Database created") << ": " << Clock::toString(database->rootGroup()->timeInfo().creationTime())
         << Qt::endl;
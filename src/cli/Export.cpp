@@ -20,19 +20,26 @@
 #include "TextStream.h"
 #include "Utils.h"
 #include "core/Global.h"
+#include "core/Tools.h"
 #include "format/CsvExporter.h"
 
 #include <QCommandLineParser>
+#include <QElapsedTimer>
 
 const QCommandLineOption Export::FormatOption = QCommandLineOption(
     QStringList() << "f" << "format",
     QObject::tr("Format to use when exporting. Available choices are 'xml' or 'csv'. Defaults to 'xml'."),
     QStringLiteral("xml|csv"));
 
+const QCommandLineOption Export::StatsOption =
+    QCommandLineOption(QStringList() << "stats",
+                       QObject::tr("Report the exported size and throughput to standard error."));
+
 Export::Export()
 {
     name = QStringLiteral("export");
     options.append(Export::FormatOption);
+    options.append(Export::StatsOption);
     description = QObject::tr("Exports the content of a database to standard output in the specified format.");
 }
 
@@ -41,6 +48,11 @@ int Export::executeWithDatabase(QSharedPointer<Database> database, QSharedPointe
     TextStream out(Utils::STDOUT.device());
     auto& err = Utils::STDERR;
 
+    QElapsedTimer timer;
+    timer.start();
+    qint64 rows = -1;
+    qint64 bytes = 0;
+
     QString format = parser->value(Export::FormatOption);
     if (format.isEmpty() || format.startsWith(QStringLiteral("xml"), Qt::CaseInsensitive)) {
         QByteArray xmlData;
@@ -50,13 +62,31 @@ int Export::executeWithDatabase(QSharedPointer<Database> database, QSharedPointe
             return EXIT_FAILURE;
         }
         out.write(xmlData.constData());
+        bytes = xmlData.size();
     } else if (format.startsWith(QStringLiteral("csv"), Qt::CaseInsensitive)) {
+        // Stream the rows straight to the output device instead of building the whole export in memory
         CsvExporter csvExporter;
-        out << csvExporter.exportDatabase(database);
+        if (!csvExporter.exportDatabase(Utils::STDOUT.device(), database)) {
+            err << QObject::tr("Unable to export database to CSV: %1").arg(csvExporter.errorString()) << Qt::endl;
+            return EXIT_FAILURE;
+        }
+        rows = csvExporter.exportedRows();
+        bytes = csvExporter.exportedBytes();
     } else {
         err << QObject::tr("Unsupported format %1").arg(format) << Qt::endl;
         return EXIT_FAILURE;
     }
 
+    if (parser->isSet(Export::StatsOption)) {
+        out.flush();
+        auto elapsed = qMax<qint64>(timer.elapsed(), 1);
+        auto message = rows >= 0 ? QObject::tr("Exported %n row(s), %1 in %2 ms (%3/s)", "", static_cast<int>(rows))
+                                 : QObject::tr("Exported %1 in %2 ms (%3/s)");
+        err << message.arg(Tools::humanReadableFileSize(bytes),
+                           QString::number(elapsed),
+                           Tools::humanReadableFileSize(bytes * 1000 / elapsed))
+            << Qt::endl;
+    }
+
     return EXIT_SUCCESS;
 }
@@ -28,6 +28,7 @@ public:
     int executeWithDatabase(QSharedPointer<Database> db, QSharedPointer<QCommandLineParser> parser) override;
 
     static const QCommandLineOption FormatOption;
+    static const QCommandLineOption StatsOption;
 };
 
 #endif // KEEPASSXC_EXPORT_H
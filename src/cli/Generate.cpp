@@ -54,6 +54,11 @@ const QCommandLineOption Generate::ExcludeSimilarCharsOption =
 
 const QCommandLineOption Generate::IncludeEveryGroupOption =
     QCommandLineOption(QStringList() << "every-group", QObject::tr("Include characters from every selected group"));
+
+const QCommandLineOption Generate::CountOption =
+    QCommandLineOption(QStringList() << "count",
+                       QObject::tr("Number of values to generate, one per line."),
+                       QObject::tr("count", "CLI parameter"));
 Generate::Generate()
 {
     name = QString("generate");
@@ -68,6 +73,23 @@ Generate::Generate()
     options.append(Generate::ExcludeSimilarCharsOption);
     options.append(Generate::IncludeEveryGroupOption);
     options.append(Generate::CustomCharacterSetOption);
+    options.append(Generate::CountOption);
+}
+
+/**
+ * Parses the count option of the parser object, returns 0 if the value is invalid.
+ */
+int Generate::parseCount(QSharedPointer<QCommandLineParser> parser)
+{
+    QString count = parser->value(Generate::CountOption);
+    if (count.isEmpty()) {
+        return 1;
+    }
+    if (count.toInt() <= 0) {
+        Utils::STDERR << QObject::tr("Invalid count %1").arg(count) << Qt::endl;
+        return 0;
+    }
+    return count.toInt();
 }
 
 /**
@@ -147,9 +169,16 @@ int Generate::execute(const QStringList& arguments)
         return EXIT_FAILURE;
     }
 
+    int count = Generate::parseCount(parser);
+    if (count <= 0) {
+        return EXIT_FAILURE;
+    }
+
     auto& out = Utils::STDOUT;
-    QString password = passwordGenerator->generatePassword();
-    out << password << Qt::endl;
+    for (int i = 0; i < count; ++i) {
+        out << passwordGenerator->generatePassword() << '\n';
+    }
+    out.flush();
 
     return EXIT_SUCCESS;
 }
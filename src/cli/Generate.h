@@ -40,6 +40,9 @@ public:
     static const QCommandLineOption ExcludeSimilarCharsOption;
     static const QCommandLineOption IncludeEveryGroupOption;
     static const QCommandLineOption CustomCharacterSetOption;
+    static const QCommandLineOption CountOption;
+
+    static int parseCount(QSharedPointer<QCommandLineParser> parser);
 };
 
 #endif // KEEPASSXC_GENERATE_H
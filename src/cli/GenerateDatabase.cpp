@@ -0,0 +1,175 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "GenerateDatabase.h"
+
+#include "DatabaseCreate.h"
+#include "Utils.h"
+
+#include "core/DatabaseGenerator.h"
+#include "core/Group.h"
+
+#include <QCommandLineParser>
+#include <QFileInfo>
+
+#include <limits>
+
+const QCommandLineOption GenerateDatabase::EntriesOption =
+    QCommandLineOption(QStringList() << "entries",
+                       QObject::tr("Number of entries (default: 1000)."),
+                       QObject::tr("count"));
+
+const QCommandLineOption GenerateDatabase::GroupsOption =
+    QCommandLineOption(QStringList() << "groups", QObject::tr("Number of groups (default: 50)."), QObject::tr("count"));
+
+const QCommandLineOption GenerateDatabase::DepthOption =
+    QCommandLineOption(QStringList() << "depth",
+                       QObject::tr("Maximum depth of the group tree, 0 keeps all entries "
+                                   "in the root group (default: 3)."),
+                       QObject::tr("levels"));
+
+const QCommandLineOption GenerateDatabase::HistoryOption =
+    QCommandLineOption(QStringList() << "history",
+                       QObject::tr("Number of history items per entry (default: 2)."),
+                       QObject::tr("count"));
+
+const QCommandLineOption GenerateDatabase::AttachmentsOption =
+    QCommandLineOption(QStringList() << "attachments",
+                       QObject::tr("Percentage of entries with an attachment (default: 10)."),
+                       QObject::tr("percent"));
+
+const QCommandLineOption GenerateDatabase::AttachmentSizeOption =
+    QCommandLineOption(QStringList() << "attachment-size",
+                       QObject::tr("Median attachment size, actual sizes vary between a quarter and four times this "
+                                   "value (default: 4096)."),
+                       QObject::tr("bytes"));
+
+const QCommandLineOption GenerateDatabase::IconsOption =
+    QCommandLineOption(QStringList() << "icons",
+                       QObject::tr("Number of custom icons (default: 0)."),
+                       QObject::tr("count"));
+
+const QCommandLineOption GenerateDatabase::ReferencesOption =
+    QCommandLineOption(QStringList() << "references",
+                       QObject::tr("Percentage of entries referencing another entry (default: 5)."),
+                       QObject::tr("percent"));
+
+const QCommandLineOption GenerateDatabase::TagsOption =
+    QCommandLineOption(QStringList() << "tags",
+                       QObject::tr("Number of distinct tags (default: 20)."),
+                       QObject::tr("count"));
+
+const QCommandLineOption GenerateDatabase::SeedOption =
+    QCommandLineOption(QStringList() << "seed",
+                       QObject::tr("Seed for the generated content, the same seed always produces the same content "
+                                   "(default: 1)."),
+                       QObject::tr("seed"));
+
+GenerateDatabase::GenerateDatabase()
+{
+    name = QString("generate-db");
+    description = QObject::tr("Create a database filled with reproducible synthetic content.");
+    positionalArguments.append({QString("database"), QObject::tr("Path of the new database."), QString("")});
+    options.append(GenerateDatabase::EntriesOption);
+    options.append(GenerateDatabase::GroupsOption);
+    options.append(GenerateDatabase::DepthOption);
+    options.append(GenerateDatabase::HistoryOption);
+    options.append(GenerateDatabase::AttachmentsOption);
+    options.append(GenerateDatabase::AttachmentSizeOption);
+    options.append(GenerateDatabase::IconsOption);
+    options.append(GenerateDatabase::ReferencesOption);
+    options.append(GenerateDatabase::TagsOption);
+    options.append(GenerateDatabase::SeedOption);
+    options.append(DatabaseCreate::SetKeyFileOption);
+    options.append(DatabaseCreate::SetKeyFileShortOption);
+    options.append(DatabaseCreate::SetPasswordOption);
+    options.append(DatabaseCreate::DecryptionTimeOption);
+}
+
+int GenerateDatabase::execute(const QStringList& arguments)
+{
+    QSharedPointer<QCommandLineParser> parser = getCommandLineParser(arguments);
+    if (parser.isNull()) {
+        return EXIT_FAILURE;
+    }
+
+    auto& out = parser->isSet(Command::QuietOption) ? Utils::DEVNULL : Utils::STDOUT;
+    auto& err = Utils::STDERR;
+
+    const QStringList args = parser->positionalArguments();
+    const QString& databaseFilename = args.at(0);
+    if (QFileInfo::exists(databaseFilename)) {
+        err << QObject::tr("File %1 already exists.").arg(databaseFilename) << Qt::endl;
+        return EXIT_FAILURE;
+    }
+
+    DatabaseGenerator::Options options;
+    bool valid = true;
+    auto readOption = [&](const QCommandLineOption& option, int& value, int maximum) {
+        if (!valid || !parser->isSet(option)) {
+            return;
+        }
+        bool ok;
+        const auto text = parser->value(option);
+        const int number = text.toInt(&ok);
+        if (!ok || number < 0 || number > maximum) {
+            err << QObject::tr("Invalid value %1 for --%2.").arg(text, option.names().first()) << Qt::endl;
+            valid = false;
+            return;
+        }
+        value = number;
+    };
+    readOption(GenerateDatabase::EntriesOption, options.entries, std::numeric_limits<int>::max());
+    readOption(GenerateDatabase::GroupsOption, options.groups, std::numeric_limits<int>::max());
+    readOption(GenerateDatabase::DepthOption, options.depth, 100);
+    readOption(GenerateDatabase::HistoryOption, options.historyItems, 1000);
+    readOption(GenerateDatabase::AttachmentsOption, options.attachmentPercent, 100);
+    readOption(GenerateDatabase::AttachmentSizeOption, options.attachmentSize, 64 * 1024 * 1024);
+    readOption(GenerateDatabase::IconsOption, options.customIcons, 10000);
+    readOption(GenerateDatabase::ReferencesOption, options.referencePercent, 100);
+    readOption(GenerateDatabase::TagsOption, options.tags, 10000);
+
+    if (parser->isSet(GenerateDatabase::SeedOption)) {
+        bool ok;
+        options.seed = parser->value(GenerateDatabase::SeedOption).toUInt(&ok);
+        if (!ok) {
+            err << QObject::tr("Invalid value %1 for --%2.")
+                       .arg(parser->value(GenerateDatabase::SeedOption), GenerateDatabase::SeedOption.names().first())
+                << Qt::endl;
+            valid = false;
+        }
+    }
+    if (!valid) {
+        return EXIT_FAILURE;
+    }
+
+    QSharedPointer<Database> db = DatabaseCreate::initializeDatabaseFromOptions(parser);
+    if (!db) {
+        return EXIT_FAILURE;
+    }
+
+    DatabaseGenerator generator(options);
+    generator.populate(db.data());
+
+    QString errorMessage;
+    if (!db->saveAs(databaseFilename, Database::Atomic, {}, &errorMessage)) {
+        err << QObject::tr("Failed to save the database: %1.").arg(errorMessage) << Qt::endl;
+        return EXIT_FAILURE;
+    }
+
+    out << QObject::tr("Successfully generated database with %n entries.", nullptr, options.entries) << Qt::endl;
+    return EXIT_SUCCESS;
+}
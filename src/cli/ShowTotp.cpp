@@ -0,0 +1,96 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ShowTotp.h"
+
+#include "Utils.h"
+#include "core/Group.h"
+#include "core/Totp.h"
+
+#include <QCommandLineParser>
+
+const QCommandLineOption ShowTotp::AllOption =
+    QCommandLineOption(QStringList() << "all", QObject::tr("Show the current TOTP of every entry that has one."));
+
+const QCommandLineOption ShowTotp::NextOption =
+    QCommandLineOption(QStringList() << "n" << "next",
+                       QObject::tr("Also show the next TOTP and the seconds until the current one expires."));
+
+ShowTotp::ShowTotp()
+{
+    name = QString("totp");
+    description = QObject::tr("Show the current TOTP of one or all entries.");
+    options.append(ShowTotp::AllOption);
+    options.append(ShowTotp::NextOption);
+    optionalArguments.append({QString("entry"), QObject::tr("Path of the entry to show."), QString("[entry]")});
+}
+
+int ShowTotp::executeWithDatabase(QSharedPointer<Database> database, QSharedPointer<QCommandLineParser> parser)
+{
+    auto& out = Utils::STDOUT;
+    auto& err = Utils::STDERR;
+
+    const QStringList args = parser->positionalArguments();
+    const bool showAll = parser->isSet(ShowTotp::AllOption);
+    const bool showNext = parser->isSet(ShowTotp::NextOption);
+
+    if (showAll == (args.size() > 1)) {
+        err << QObject::tr("Specify either an entry or --all.") << Qt::endl;
+        return EXIT_FAILURE;
+    }
+
+    QList<const Entry*> entries;
+    if (showAll) {
+        for (const Entry* entry : database->rootGroup()->entriesRecursive()) {
+            if (entry->hasTotp() && !entry->isRecycled()) {
+                entries.append(entry);
+            }
+        }
+    } else {
+        const QString& entryPath = args.at(1);
+        const Entry* entry = database->rootGroup()->findEntryByPath(entryPath);
+        if (!entry) {
+            err << QObject::tr("Could not find entry with path %1.").arg(entryPath) << Qt::endl;
+            return EXIT_FAILURE;
+        }
+        if (!entry->hasTotp()) {
+            err << QObject::tr("Entry with path %1 has no TOTP set up.").arg(entryPath) << Qt::endl;
+            return EXIT_FAILURE;
+        }
+        entries.append(entry);
+    }
+
+    QList<QSharedPointer<Totp::Settings>> settings;
+    settings.reserve(entries.size());
+    for (const Entry* entry : asConst(entries)) {
+        settings.append(entry->totpSettings());
+    }
+
+    // Generate all codes against the same point in time
+    const auto codes = Totp::generateCodes(settings);
+    for (int i = 0; i < codes.size(); ++i) {
+        if (showAll) {
+            out << entries.at(i)->path().prepend('/') << ": ";
+        }
+        out << codes.at(i).current;
+        if (showNext) {
+            out << " " << codes.at(i).next << " " << codes.at(i).validFor;
+        }
+        out << Qt::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -27,6 +27,7 @@
 #include "core/Config.h"
 #include "core/Metadata.h"
 #include "core/Tools.h"
+#include "core/Trace.h"
 #include "crypto/Crypto.h"
 
 #if defined(WITH_ASAN) && defined(WITH_LSAN)
@@ -208,6 +209,8 @@ int main(int argc, char** argv)
 
     QCommandLineOption debugInfoOption(QStringList() << "debug-info", QObject::tr("Displays debugging information."));
     parser.addOption(debugInfoOption);
+    QCommandLineOption traceOption("trace", QObject::tr("Write a performance trace to the given file."), "file");
+    parser.addOption(traceOption);
     parser.addHelpOption();
     parser.addVersionOption();
     // TODO : use the setOptionsAfterPositionalArgumentsMode (Qt 5.6) function
@@ -231,6 +234,27 @@ int main(int argc, char** argv)
         parser.showHelp();
     }
 
+    // The command parsers don't know about --trace, so strip it before handing the arguments over
+    QString traceFile = qEnvironmentVariable(Trace::EnvironmentVariable);
+    if (parser.isSet(traceOption)) {
+        traceFile = parser.value(traceOption);
+        for (int i = 1; i < arguments.size() && arguments.at(i).startsWith("-");) {
+            if (arguments.at(i) == "--trace") {
+                arguments.erase(arguments.begin() + i, arguments.begin() + qMin(i + 2, arguments.size()));
+            } else if (arguments.at(i).startsWith("--trace=")) {
+                arguments.removeAt(i);
+            } else {
+                ++i;
+            }
+        }
+    }
+    if (!traceFile.isEmpty()) {
+        QString traceError;
+        if (!Trace::start(traceFile, &traceError)) {
+            err << traceError << Qt::endl;
+        }
+    }
+
     QString commandName = parser.positionalArguments().at(0);
     if (commandName == "open") {
         return enterInteractiveMode(arguments);
@@ -233,12 +233,60 @@ QPointer<Config> Config::m_instance(nullptr);
 
 QVariant Config::get(ConfigKey key)
 {
-    auto cfg = configStrings[key];
-    auto defaultValue = configStrings[key].defaultValue;
+    return snapshot()->get(key);
+}
+
+QVariant Config::readValue(ConfigKey key) const
+{
+    const auto& cfg = configStrings[key];
+    QVariant value;
     if (m_localSettings && cfg.type == Local) {
-        return m_localSettings->value(cfg.name, defaultValue);
+        value = m_localSettings->value(cfg.name, cfg.defaultValue);
+    } else {
+        value = m_settings->value(cfg.name, cfg.defaultValue);
+    }
+
+    // Values read back from the ini file are strings, convert them to the type of the default once
+    if (cfg.defaultValue.isValid() && value.userType() != cfg.defaultValue.userType()) {
+        auto converted = value;
+        if (converted.convert(cfg.defaultValue.userType())) {
+            return converted;
+        }
+    }
+    return value;
+}
+
+void Config::reloadSnapshot()
+{
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->m_values.resize(Deleted + 1);
+    for (auto it = configStrings.constBegin(); it != configStrings.constEnd(); ++it) {
+        snapshot->m_values[it.key()] = readValue(it.key());
     }
-    return m_settings->value(cfg.name, defaultValue);
+
+    QMutexLocker locker(&m_snapshotMutex);
+    publishSnapshot(std::move(snapshot));
+}
+
+void Config::updateSnapshot(ConfigKey key)
+{
+    QMutexLocker locker(&m_snapshotMutex);
+    // Readers may still use the current snapshot, replace it with an updated copy
+    auto updated = std::make_shared<Snapshot>(*snapshot());
+    updated->m_values[key] = readValue(key);
+    publishSnapshot(std::move(updated));
+}
+
+/**
+ * Make the snapshot current. Readers holding the previous one keep it alive.
+ */
+void Config::publishSnapshot(std::shared_ptr<const Snapshot> snapshot)
+{
+#ifdef __cpp_lib_atomic_shared_ptr
+    m_snapshot.store(std::move(snapshot), std::memory_order_release);
+#else
+    std::atomic_store_explicit(&m_snapshot, std::move(snapshot), std::memory_order_release);
+#endif
 }
 
 QVariant Config::getDefault(Config::ConfigKey key)
@@ -269,6 +317,7 @@ void Config::set(ConfigKey key, const QVariant& value)
         m_settings->setValue(cfg.name, value);
     }
 
+    updateSnapshot(key);
     emit changed(key);
 }
 
@@ -281,6 +330,7 @@ void Config::remove(ConfigKey key)
         m_settings->remove(cfg.name);
     }
 
+    updateSnapshot(key);
     emit changed(key);
 }
 
@@ -305,6 +355,7 @@ void Config::resetToDefaults()
     if (m_localSettings) {
         m_localSettings->clear();
     }
+    reloadSnapshot();
 }
 
 bool Config::importSettings(const QString& fileName)
@@ -334,6 +385,7 @@ bool Config::importSettings(const QString& fileName)
     }
 
     sync();
+    reloadSnapshot();
 
     return true;
 }
@@ -547,7 +599,10 @@ void Config::init(const QString& configFileName, const QString& localConfigFileN
         m_localSettings.reset(new QSettings(localConfigFileName, QSettings::IniFormat));
     }
 
+    reloadSnapshot();
     migrate();
+    // Migration also moves values between the settings files directly
+    reloadSnapshot();
     connect(qApp, &QCoreApplication::aboutToQuit, this, &Config::sync);
 }
 
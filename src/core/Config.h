@@ -19,10 +19,15 @@
 #ifndef KEEPASSX_CONFIG_H
 #define KEEPASSX_CONFIG_H
 
+#include <QMutex>
 #include <QPointer>
+#include <QSharedPointer>
 #include <QVariant>
 #include <QVector>
 
+#include <atomic>
+#include <memory>
+
 class QSettings;
 
 class Config : public QObject
@@ -212,7 +217,55 @@ public:
         QString shortcut;
     };
 
+    /**
+     * Immutable copy of all configuration values.
+     * Values are converted to the type of their default once, so reading
+     * them does not touch QSettings or parse strings.
+     */
+    class Snapshot
+    {
+    public:
+        QVariant get(ConfigKey key) const
+        {
+            return m_values.value(key);
+        }
+
+        bool getBool(ConfigKey key) const
+        {
+            return m_values.value(key).toBool();
+        }
+
+        int getInt(ConfigKey key) const
+        {
+            return m_values.value(key).toInt();
+        }
+
+        QString getString(ConfigKey key) const
+        {
+            return m_values.value(key).toString();
+        }
+
+    private:
+        QVector<QVariant> m_values;
+
+        friend class Config;
+    };
+
     ~Config() override;
+
+    /**
+     * Current configuration values. Snapshots are only replaced when a setting
+     * changes, the returned one can be kept to read several values consistently.
+     */
+    std::shared_ptr<const Snapshot> snapshot() const
+    {
+#ifdef __cpp_lib_atomic_shared_ptr
+        return m_snapshot.load(std::memory_order_acquire);
+#else
+        return std::atomic_load_explicit(&m_snapshot, std::memory_order_acquire);
+#endif
+    }
+
     QVariant get(ConfigKey key);
     QVariant getDefault(ConfigKey key);
     QString getFileName();
@@ -242,6 +295,10 @@ private:
     explicit Config(QObject* parent);
     void init(const QString& configFileName, const QString& localConfigFileName);
     void migrate();
+    QVariant readValue(ConfigKey key) const;
+    void reloadSnapshot();
+    void updateSnapshot(ConfigKey key);
+    void publishSnapshot(std::shared_ptr<const Snapshot> snapshot);
     static QPair<QString, QString> defaultConfigFiles();
 
     static QPointer<Config> m_instance;
@@ -249,6 +306,15 @@ private:
     QScopedPointer<QSettings> m_settings;
     QScopedPointer<QSettings> m_localSettings;
     QHash<QString, QVariant> m_defaults;
+
+    // Serializes writers, readers only load m_snapshot
+    QMutex m_snapshotMutex;
+    // Superseded snapshots are freed once the last reader releases them
+#ifdef __cpp_lib_atomic_shared_ptr
+    std::atomic<std::shared_ptr<const Snapshot>> m_snapshot;
+#else
+    std::shared_ptr<const Snapshot> m_snapshot;
+#endif
 };
 
 inline Config* config()
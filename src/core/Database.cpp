@@ -19,18 +19,26 @@
 #include "Database.h"
 
 #include "core/AsyncTask.h"
+#include "core/DatabaseSnapshot.h"
 #include "core/FileWatcher.h"
 #include "core/Group.h"
+#include "core/LatencyStats.h"
+#include "core/PasswordHealthIndex.h"
+#include "core/Trace.h"
 #include "crypto/Random.h"
 #include "format/KdbxXmlReader.h"
 #include "format/KeePass2Reader.h"
 #include "format/KeePass2Writer.h"
 
+#include <QBuffer>
+#include <QElapsedTimer>
+#include <QEventLoop>
 #include <QFileInfo>
 #include <QJsonObject>
 #include <QRegularExpression>
 #include <QSaveFile>
 #include <QTemporaryFile>
+#include <QThread>
 #include <QTimer>
 
 #ifdef Q_OS_WIN
@@ -39,6 +47,106 @@
 
 QHash<QUuid, QPointer<Database>> Database::s_uuidMap;
 
+namespace
+{
+    LatencyStats& saveLatencyStats()
+    {
+        static LatencyStats stats;
+        return stats;
+    }
+
+    bool writeData(QIODevice* device, const QByteArray& data, QString* error)
+    {
+        if (device->write(data) != data.size()) {
+            if (error) {
+                *error = device->errorString();
+            }
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Copy a group with its entries, their history and its subgroups. Unlike
+     * Group::clone(), the location of the copied entries and groups keeps its
+     * timestamp. The copy is never edited, so its timestamps stay frozen.
+     */
+    Group* copyGroupForSave(const Group* group)
+    {
+        auto copy = group->clone(Entry::CloneNoFlags, Group::CloneNoFlags);
+        copy->setUpdateTimeinfo(false);
+
+        for (const auto* entry : group->entries()) {
+            auto copiedEntry = entry->clone(Entry::CloneIncludeHistory);
+            copiedEntry->setUpdateTimeinfo(false);
+            copiedEntry->setGroup(copy);
+            if (entry == group->lastTopVisibleEntry()) {
+                copy->setLastTopVisibleEntry(copiedEntry);
+            }
+        }
+
+        for (const auto* child : group->children()) {
+            copyGroupForSave(child)->setParent(copy);
+        }
+
+        return copy;
+    }
+
+    /**
+     * Keep the attachment digests that were computed while writing a copy
+     * of the database, so the next save does not hash the attachments again.
+     */
+    void copyAttachmentDigests(Group* rootGroup, const Group* writtenRootGroup)
+    {
+        QHash<QUuid, const Entry*> writtenEntries;
+        for (const auto* entry : writtenRootGroup->entriesRecursive()) {
+            writtenEntries.insert(entry->uuid(), entry);
+        }
+
+        for (auto* entry : rootGroup->entriesRecursive()) {
+            const auto* written = writtenEntries.value(entry->uuid());
+            if (!written) {
+                continue;
+            }
+
+            entry->attachments()->copyDigestsFrom(written->attachments());
+            const auto history = entry->historyItems();
+            const auto& writtenHistory = written->historyItems();
+            for (int i = 0; i < qMin(history.size(), writtenHistory.size()); ++i) {
+                history.at(i)->attachments()->copyDigestsFrom(writtenHistory.at(i)->attachments());
+            }
+        }
+    }
+} // namespace
+
+/**
+ * State of a single save operation that is passed between the
+ * calling thread and the worker threads.
+ */
+struct Database::SaveJob
+{
+    QString filePath;
+    QString realFilePath;
+    SaveAction action = Atomic;
+    QString backupFilePath;
+    bool isNewFile = false;
+    bool isHidden = false;
+
+    // Freshly seeded copy of the KDF, transformedKey is calculated on a worker thread
+    QSharedPointer<const CompositeKey> key;
+    QSharedPointer<Kdf> kdf;
+    QVariantMap kdfParameters;
+    QByteArray transformedKey;
+
+    // Copy of the database that is serialized on a worker thread and the modification count it represents
+    QSharedPointer<Database> copy;
+    quint64 modificationCount = 0;
+    QByteArray data;
+
+    QString error;
+    QElapsedTimer timer;
+};
+
 Database::Database()
     : m_metadata(new Metadata(this))
     , m_data()
@@ -52,6 +160,8 @@ Database::Database()
         if (!value) {
             stopModifiedTimer();
         }
+        // Changes are not reported while modified signals are blocked
+        m_snapshot.reset();
     });
     connect(&m_modifiedTimer, &QTimer::timeout, this, &Database::emitModified);
 
@@ -87,6 +197,8 @@ Database::Database(const QString& filePath)
 
 Database::~Database()
 {
+    // A running background save only uses its own copy of the data and is left to finish on its own
+    m_backgroundSaving = false;
     releaseData();
 }
 
@@ -127,6 +239,8 @@ bool Database::open(QSharedPointer<const CompositeKey> key, QString* error)
  */
 bool Database::open(const QString& filePath, QSharedPointer<const CompositeKey> key, QString* error)
 {
+    TRACE_SPAN("Database::open");
+
     QFile dbFile(filePath);
     if (!dbFile.exists()) {
         if (error) {
@@ -194,6 +308,10 @@ bool Database::hasMinorVersionMismatch() const
 
 bool Database::isSaving()
 {
+    if (m_backgroundSaving) {
+        return true;
+    }
+
     bool locked = m_saveMutex.tryLock();
     if (locked) {
         m_saveMutex.unlock();
@@ -252,6 +370,135 @@ bool Database::saveAs(const QString& filePath, SaveAction action, const QString&
         return false;
     }
 
+    auto job = QSharedPointer<SaveJob>::create();
+    job->filePath = filePath;
+    job->action = action;
+    job->backupFilePath = backupFilePath;
+    if (!beginSave(*job, error)) {
+        return false;
+    }
+
+    // Prevent destructive operations while saving
+    QMutexLocker locker(&m_saveMutex);
+
+    bool ok = AsyncTask::runAndWaitForFuture(
+        [job] { return transformKeyForSave(*job) && serializeForSave(*job) && performSave(*job); });
+    finishSave(*job, ok);
+    if (!ok && error) {
+        *error = job->error;
+    }
+
+    locker.unlock();
+    if (m_backgroundSavePending) {
+        QTimer::singleShot(0, this, &Database::startPendingSave);
+    }
+
+    return ok;
+}
+
+/**
+ * Save the database to its current file path without blocking the event loop.
+ *
+ * A copy of the database is taken on the calling thread, so the file always
+ * represents the state of the database when the save started. The key is
+ * transformed, the copy is serialized and the file is written on a worker
+ * thread. Requests made while a save is running are coalesced into a single
+ * save that starts once the running save is done. saveFinished() is emitted
+ * for every save started by this function.
+ *
+ * @param action how the file is written, see saveAs()
+ * @param backupFilePath Absolute path to the location where the backup should be stored. Passing an empty string
+ * disables backup.
+ */
+void Database::saveInBackground(SaveAction action, const QString& backupFilePath)
+{
+    if (isSaving()) {
+        // The next save covers every change made until it starts, so only the latest request is kept
+        m_backgroundSavePending = true;
+        m_pendingSaveAction = action;
+        m_pendingBackupFilePath = backupFilePath;
+        return;
+    }
+
+    startBackgroundSave(action, backupFilePath);
+}
+
+/**
+ * Wait for a background save to finish, including a follow-up save that was
+ * requested while it was running. Events are processed in the meantime.
+ *
+ * @return true if no save is running anymore, false if a synchronous save is
+ * in progress further up the call stack
+ */
+bool Database::waitForBackgroundSave()
+{
+    while (m_backgroundSaving) {
+        QEventLoop loop;
+        connect(this, &Database::saveFinished, &loop, &QEventLoop::quit);
+        loop.exec();
+    }
+
+    return !isSaving();
+}
+
+/**
+ * Durations of the recent save operations of all databases, from the
+ * request until the file is written.
+ */
+const LatencyStats& Database::saveLatency()
+{
+    return saveLatencyStats();
+}
+
+void Database::startBackgroundSave(SaveAction action, const QString& backupFilePath)
+{
+    if (m_data.filePath.isEmpty()) {
+        emit saveFinished(false, tr("Could not save, database does not point to a valid file."));
+        return;
+    }
+
+    auto job = QSharedPointer<SaveJob>::create();
+    job->filePath = m_data.filePath;
+    job->action = action;
+    job->backupFilePath = backupFilePath;
+    if (!beginSave(*job, &job->error)) {
+        emit saveFinished(false, job->error);
+        return;
+    }
+
+    m_backgroundSaving = true;
+    auto finish = [this, job](bool ok) {
+        finishSave(*job, ok);
+        m_backgroundSaving = false;
+        emit saveFinished(ok, job->error);
+        startPendingSave();
+    };
+
+    AsyncTask::runThenCallback(
+        [job] { return transformKeyForSave(*job) && serializeForSave(*job) && performSave(*job); }, this, finish);
+}
+
+void Database::startPendingSave()
+{
+    if (!m_backgroundSavePending || isSaving()) {
+        return;
+    }
+
+    m_backgroundSavePending = false;
+    // Nothing left to save if a previous save already covered all changes
+    if (m_modified) {
+        startBackgroundSave(m_pendingSaveAction, m_pendingBackupFilePath);
+    }
+}
+
+/**
+ * Validate the save request and gather everything the worker threads need.
+ * Runs on the thread that owns the database.
+ */
+bool Database::beginSave(SaveJob& job, QString* error)
+{
+    job.timer.start();
+
     // Never save an uninitialized database
     if (!isInitialized()) {
         if (error) {
@@ -260,7 +507,7 @@ bool Database::saveAs(const QString& filePath, SaveAction action, const QString&
         return false;
     }
 
-    if (filePath == m_data.filePath) {
+    if (job.filePath == m_data.filePath) {
         // Fail-safe check to make sure we don't overwrite underlying file changes
         // that have not yet triggered a file reload/merge operation.
         if (!m_fileWatcher->hasSameFileChecksum()) {
@@ -278,42 +525,162 @@ bool Database::saveAs(const QString& filePath, SaveAction action, const QString&
     int length = Random::instance()->randomUIntRange(64, 512);
     m_metadata->customData()->set(CustomData::RandomSlug, Random::instance()->randomArray(length).toHex());
 
-    // Prevent destructive operations while saving
-    QMutexLocker locker(&m_saveMutex);
-
-    QFileInfo fileInfo(filePath);
-    auto realFilePath = fileInfo.exists() ? fileInfo.canonicalFilePath() : fileInfo.absoluteFilePath();
-    bool isNewFile = !QFile::exists(realFilePath);
-
+    QFileInfo fileInfo(job.filePath);
+    job.realFilePath = fileInfo.exists() ? fileInfo.canonicalFilePath() : fileInfo.absoluteFilePath();
+    job.isNewFile = !QFile::exists(job.realFilePath);
 #ifdef Q_OS_WIN
-    bool isHidden = fileInfo.isHidden();
+    job.isHidden = fileInfo.isHidden();
 #endif
 
-    bool ok = AsyncTask::runAndWaitForFuture([&] { return performSave(realFilePath, action, backupFilePath, error); });
+    // Saving reseeds the KDF, do it on a copy so the expensive transformation can run on a worker thread
+    job.key = m_data.key;
+    job.kdfParameters = KeePass2::kdfToParameters(m_data.kdf);
+    job.kdf = m_data.kdf->clone();
+    job.kdf->randomizeSeed();
+
+    // Serialize a copy so the database can be edited while the file is written
+    job.copy = copyForSave();
+    job.modificationCount = m_modificationCount;
+    return true;
+}
+
+/**
+ * Copy everything the writer needs into a new database that is not connected
+ * to this one, so it can be serialized on a worker thread. Strings and
+ * attachments of the copied entries share their data with this database.
+ */
+QSharedPointer<Database> Database::copyForSave() const
+{
+    // The last reference may be dropped on a worker thread
+    QSharedPointer<Database> copy(new Database(), [](Database* db) {
+        if (db->thread() == QThread::currentThread()) {
+            delete db;
+        } else {
+            db->deleteLater();
+        }
+    });
+    copy->setEmitModified(false);
+
+    copy->m_data.formatVersion = m_data.formatVersion;
+    copy->m_data.cipher = m_data.cipher;
+    copy->m_data.compressionAlgorithm = m_data.compressionAlgorithm;
+    copy->m_data.key = m_data.key;
+    copy->m_data.kdf = m_data.kdf->clone();
+    copy->m_data.masterSeed->setRawKey(m_data.masterSeed->rawKey());
+    copy->m_data.transformedDatabaseKey->setRawKey(m_data.transformedDatabaseKey->rawKey());
+    copy->m_data.challengeResponseKey->setRawKey(m_data.challengeResponseKey->rawKey());
+    copy->m_data.publicCustomData = m_data.publicCustomData;
+    copy->m_deletedObjects = m_deletedObjects;
+
+    delete copy->setRootGroup(copyGroupForSave(m_rootGroup));
+
+    auto copiedGroup = [&copy](const Group* group) {
+        return group ? copy->m_rootGroup->findGroupByUuid(group->uuid()) : nullptr;
+    };
+
+    auto metadata = copy->m_metadata;
+    metadata->setUpdateDatetime(false);
+    metadata->copyAttributesFrom(m_metadata);
+    metadata->customData()->copyDataFrom(m_metadata->customData());
+    for (const auto& uuid : m_metadata->customIconsOrder()) {
+        metadata->addCustomIcon(uuid, m_metadata->customIcon(uuid));
+    }
+    metadata->setRecycleBin(copiedGroup(m_metadata->recycleBin()));
+    metadata->setRecycleBinChanged(m_metadata->recycleBinChanged());
+    metadata->setEntryTemplatesGroup(copiedGroup(m_metadata->entryTemplatesGroup()));
+    metadata->setEntryTemplatesGroupChanged(m_metadata->entryTemplatesGroupChanged());
+    metadata->setLastSelectedGroup(copiedGroup(m_metadata->lastSelectedGroup()));
+    metadata->setLastTopVisibleGroup(copiedGroup(m_metadata->lastTopVisibleGroup()));
+    metadata->setDatabaseKeyChanged(m_metadata->databaseKeyChanged());
+    metadata->setSettingsChanged(m_metadata->settingsChanged());
+
+    return copy;
+}
+
+bool Database::transformKeyForSave(SaveJob& job)
+{
+    TRACE_SPAN("Database::transformKeyForSave");
+
+    QString keyError;
+    if (!job.key->transform(*job.kdf, job.transformedKey, &keyError)) {
+        job.error = tr("Unable to calculate database key: %1").arg(keyError);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Serialize the copy of the database into memory using the key transformed
+ * by transformKeyForSave(). Only uses the given job, so it is safe to call
+ * from a worker thread. This includes the challenge-response of KDBX 3.1 files.
+ */
+bool Database::serializeForSave(SaveJob& job)
+{
+    TRACE_SPAN("Database::serializeForSave");
+
+    // Offer the transformed key to the writer, it is adopted by setKey() unless the key or KDF changed
+    auto& data = job.copy->m_data;
+    data.cachedKey = job.key;
+    data.cachedKdfParameters = KeePass2::kdfToParameters(job.kdf);
+    data.cachedTransformedKey.reset(new PasswordKey());
+    data.cachedTransformedKey->setRawKey(job.transformedKey);
+    data.cachedSeededKdf = job.kdf;
+    data.cachedSeededKdfBase = job.kdfParameters;
+
+    QBuffer buffer(&job.data);
+    buffer.open(QIODevice::WriteOnly);
+    return job.copy->writeDatabase(&buffer, &job.error);
+}
+
+void Database::finishSave(SaveJob& job, bool ok)
+{
     if (ok) {
-        setFilePath(filePath);
-        markAsClean();
-        if (isNewFile) {
-            QFile::setPermissions(realFilePath, QFile::ReadUser | QFile::WriteUser);
+        // Adopt the KDF seed and the keys the file was written with, unless the key or the KDF changed since
+        const auto& written = job.copy->m_data;
+        if (m_data.key == job.key && KeePass2::kdfToParameters(m_data.kdf) == job.kdfParameters) {
+            m_data.kdf = written.kdf;
+            m_data.masterSeed->setRawKey(written.masterSeed->rawKey());
+            m_data.transformedDatabaseKey->setRawKey(written.transformedDatabaseKey->rawKey());
+            m_data.challengeResponseKey->setRawKey(written.challengeResponseKey->rawKey());
+        }
+        m_data.formatVersion = written.formatVersion;
+        copyAttachmentDigests(m_rootGroup, job.copy->m_rootGroup);
+
+        setFilePath(job.filePath);
+        // Changes made while the file was written are not part of it
+        if (job.modificationCount == m_modificationCount) {
+            markAsClean();
+        }
+        if (job.isNewFile) {
+            QFile::setPermissions(job.realFilePath, QFile::ReadUser | QFile::WriteUser);
         }
 
 #ifdef Q_OS_WIN
-        if (isHidden) {
-            SetFileAttributes(realFilePath.toStdString().c_str(), FILE_ATTRIBUTE_HIDDEN);
+        if (job.isHidden) {
+            SetFileAttributes(job.realFilePath.toStdString().c_str(), FILE_ATTRIBUTE_HIDDEN);
         }
 #endif
 
-        m_fileWatcher->start(realFilePath, 30, 1);
+        m_fileWatcher->start(job.realFilePath, 30, 1);
     } else {
         // Saving failed, don't rewatch file since it does not represent our database
         markAsModified();
     }
 
-    return ok;
+    saveLatencyStats().record(job.timer.elapsed());
 }
 
-bool Database::performSave(const QString& filePath, SaveAction action, const QString& backupFilePath, QString* error)
+/**
+ * Write the serialized database to disk. Only uses the given job,
+ * so it is safe to call from a worker thread.
+ */
+bool Database::performSave(SaveJob& job)
 {
+    TRACE_SPAN("Database::performSave");
+
+    const auto& filePath = job.realFilePath;
+    const auto& backupFilePath = job.backupFilePath;
+
     if (!backupFilePath.isNull()) {
         backupDatabase(filePath, backupFilePath);
     }
@@ -321,12 +688,12 @@ bool Database::performSave(const QString& filePath, SaveAction action, const QSt
     QFileInfo info(filePath);
     auto createTime = info.exists() ? info.birthTime() : QDateTime::currentDateTime();
 
-    switch (action) {
+    switch (job.action) {
     case Atomic: {
         QSaveFile saveFile(filePath);
         if (saveFile.open(QIODevice::WriteOnly)) {
             // write the database to the file
-            if (!writeDatabase(&saveFile, error)) {
+            if (!writeData(&saveFile, job.data, &job.error)) {
                 return false;
             }
 
@@ -339,16 +706,14 @@ bool Database::performSave(const QString& filePath, SaveAction action, const QSt
             }
         }
 
-        if (error) {
-            *error = saveFile.errorString();
-        }
+        job.error = saveFile.errorString();
         break;
     }
     case TempFile: {
         QTemporaryFile tempFile;
         if (tempFile.open()) {
             // write the database to the file
-            if (!writeDatabase(&tempFile, error)) {
+            if (!writeData(&tempFile, job.data, &job.error)) {
                 return false;
             }
             tempFile.close(); // flush to disk
@@ -371,31 +736,25 @@ bool Database::performSave(const QString& filePath, SaveAction action, const QSt
                 // Failed to copy new database in place, and
                 // failed to restore from backup or backups disabled
                 tempFile.setAutoRemove(false);
-                if (error) {
-                    *error = tr("%1\nBackup database located at %2").arg(tempFile.errorString(), tempFile.fileName());
-                }
+                job.error = tr("%1\nBackup database located at %2").arg(tempFile.errorString(), tempFile.fileName());
                 return false;
             }
         }
 
-        if (error) {
-            *error = tempFile.errorString();
-        }
+        job.error = tempFile.errorString();
         break;
     }
     case DirectWrite: {
         // Open the original database file for direct-write
         QFile dbFile(filePath);
         if (dbFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-            if (!writeDatabase(&dbFile, error)) {
+            if (!writeData(&dbFile, job.data, &job.error)) {
                 return false;
             }
             dbFile.close();
             return true;
         }
-        if (error) {
-            *error = dbFile.errorString();
-        }
+        job.error = dbFile.errorString();
         break;
     }
     }
@@ -482,6 +841,8 @@ bool Database::import(const QString& xmlExportPath, QString* error)
 
 void Database::releaseData()
 {
+    // Let a background save finish, it would report a save of the released data otherwise
+    waitForBackgroundSave();
     // Prevent data release while saving
     Q_ASSERT(!isSaving());
     QMutexLocker locker(&m_saveMutex);
@@ -589,6 +950,10 @@ Group* Database::setRootGroup(Group* group)
         emit databaseDiscarded();
     }
 
+    // The health index is bound to the groups of the old root
+    m_healthIndex.reset();
+    m_snapshot.reset();
+
     auto oldRoot = m_rootGroup;
     m_rootGroup = group;
     m_rootGroup->setParent(this);
@@ -642,6 +1007,7 @@ void Database::setFilePath(const QString& filePath)
     if (filePath != m_data.filePath) {
         QString oldPath = m_data.filePath;
         m_data.filePath = filePath;
+        m_snapshot.reset();
         // Don't watch for changes until the next open or save operation
         m_fileWatcher->stop();
         emit filePathChanged(oldPath, filePath);
@@ -711,6 +1077,35 @@ const QStringList& Database::tagList() const
     return m_tagList;
 }
 
+/**
+ * Password health index of this database. The index is built
+ * on first use and then kept up to date as entries change.
+ * Must be called from the thread that owns the database.
+ */
+PasswordHealthIndex* Database::healthIndex()
+{
+    // The index follows entry changes on this thread, workers may only read an index built before
+    Q_ASSERT(QThread::currentThread() == thread());
+    if (!m_healthIndex && m_rootGroup) {
+        m_healthIndex.reset(new PasswordHealthIndex(this));
+    }
+    return m_healthIndex.data();
+}
+
+/**
+ * Immutable copy of the current groups and entries for use on other
+ * threads. The copy is reused until the database is modified.
+ * Must be called from the thread that owns the database.
+ */
+QSharedPointer<const DatabaseSnapshot> Database::snapshot()
+{
+    Q_ASSERT(QThread::currentThread() == thread());
+    if (!m_snapshot) {
+        m_snapshot = QSharedPointer<const DatabaseSnapshot>::create(this);
+    }
+    return m_snapshot;
+}
+
 void Database::updateCommonUsernames(int topN)
 {
     m_commonUsernames.clear();
@@ -771,6 +1166,33 @@ QByteArray Database::transformedDatabaseKey() const
     return m_data.transformedDatabaseKey->rawKey();
 }
 
+/**
+ * Offer the transformed key of another open copy of this database to
+ * the next call of setKey(). The KDF is skipped if that call uses the
+ * same composite key and the KDF parameters, including the seed, are
+ * unchanged.
+ *
+ * Every save randomizes the seed, so this only covers files whose header
+ * is unchanged since the other copy read or wrote it: a file that was
+ * touched or restored by a sync client, and a file saved by the other copy
+ * itself, which adopts the seed it wrote. Reloading a file saved by another
+ * program still runs the KDF.
+ *
+ * @param other open database whose transformed key may be reused
+ */
+void Database::reuseTransformedKeyFrom(const Database& other)
+{
+    m_data.clearTransformedKeyCache();
+    if (!other.m_data.key || other.m_data.key->isEmpty() || !other.m_data.kdf) {
+        return;
+    }
+
+    m_data.cachedKey = other.m_data.key;
+    m_data.cachedKdfParameters = KeePass2::kdfToParameters(other.m_data.kdf);
+    m_data.cachedTransformedKey.reset(new PasswordKey());
+    m_data.cachedTransformedKey->setRawKey(other.m_data.transformedDatabaseKey->rawKey());
+}
+
 QByteArray Database::challengeResponseKey() const
 {
     Q_ASSERT(m_data.challengeResponseKey);
@@ -815,6 +1237,31 @@ void Database::setCompressionAlgorithm(Database::CompressionAlgorithm algo)
     m_data.compressionAlgorithm = algo;
 }
 
+/**
+ * Get the gzip compression level used when saving, from 1 (fastest) to 9 (smallest).
+ * The level is stored in the encrypted metadata since the KDBX header has no field for it.
+ */
+int Database::compressionLevel() const
+{
+    bool ok = false;
+    int level = m_metadata->customData()->value(CustomData::CompressionLevel).toInt(&ok);
+    return ok ? qBound(1, level, 9) : DefaultCompressionLevel;
+}
+
+void Database::setCompressionLevel(int level)
+{
+    level = qBound(1, level, 9);
+    if (level == compressionLevel()) {
+        return;
+    }
+
+    if (level == DefaultCompressionLevel) {
+        m_metadata->customData()->remove(CustomData::CompressionLevel);
+    } else {
+        m_metadata->customData()->set(CustomData::CompressionLevel, QString::number(level));
+    }
+}
+
 /**
  * Set and transform a new encryption key.
  *
@@ -837,7 +1284,13 @@ bool Database::setKey(const QSharedPointer<const CompositeKey>& key,
     }
 
     if (updateTransformSalt) {
-        m_data.kdf->randomizeSeed();
+        // Adopt the KDF seeded ahead of a save unless the key or the KDF settings changed since
+        if (transformKey && m_data.cachedSeededKdf && m_data.cachedKey == key
+            && m_data.cachedSeededKdfBase == KeePass2::kdfToParameters(m_data.kdf)) {
+            m_data.kdf = m_data.cachedSeededKdf;
+        } else {
+            m_data.kdf->randomizeSeed();
+        }
         Q_ASSERT(!m_data.kdf->seed().isEmpty());
     }
 
@@ -848,11 +1301,19 @@ bool Database::setKey(const QSharedPointer<const CompositeKey>& key,
 
     QByteArray transformedDatabaseKey;
 
+    // The cached transformed key is only offered once
+    const bool reuseCachedKey = transformKey && m_data.cachedTransformedKey && m_data.cachedKey == key
+                                && m_data.cachedKdfParameters == KeePass2::kdfToParameters(m_data.kdf);
+
     if (!transformKey) {
         transformedDatabaseKey = QByteArray(oldTransformedDatabaseKey.rawKey());
+    } else if (reuseCachedKey) {
+        transformedDatabaseKey = m_data.cachedTransformedKey->rawKey();
     } else if (!key->transform(*m_data.kdf, transformedDatabaseKey, &m_keyError)) {
+        m_data.clearTransformedKeyCache();
         return false;
     }
+    m_data.clearTransformedKeyCache();
 
     m_data.key = key;
     if (!transformedDatabaseKey.isEmpty()) {
@@ -926,9 +1387,45 @@ void Database::recycleGroup(Group* group)
     }
 }
 
+void Database::recycleEntries(const QList<Entry*>& entries)
+{
+    if (!m_metadata->recycleBinEnabled()) {
+        deleteEntries(entries);
+        return;
+    }
+
+    if (!m_metadata->recycleBin()) {
+        createRecycleBin();
+    }
+    moveEntries(entries, metadata()->recycleBin());
+}
+
+/**
+ * Move entries into a group as a single bulk update.
+ * Entries without a parent group are added to the group.
+ */
+void Database::moveEntries(const QList<Entry*>& entries, Group* group)
+{
+    Q_ASSERT(group);
+
+    beginBulkUpdate();
+    for (Entry* entry : entries) {
+        entry->setGroup(group);
+    }
+    endBulkUpdate();
+}
+
+void Database::deleteEntries(const QList<Entry*>& entries)
+{
+    beginBulkUpdate();
+    qDeleteAll(entries);
+    endBulkUpdate();
+}
+
 void Database::emptyRecycleBin()
 {
     if (m_metadata->recycleBinEnabled() && m_metadata->recycleBin()) {
+        beginBulkUpdate();
         // destroying direct entries of the recycle bin
         QList<Entry*> subEntries = m_metadata->recycleBin()->entries();
         for (Entry* entry : subEntries) {
@@ -939,9 +1436,45 @@ void Database::emptyRecycleBin()
         for (Group* group : subGroups) {
             delete group;
         }
+        endBulkUpdate();
     }
 }
 
+/**
+ * Start a bulk update of the database. Until the matching endBulkUpdate(),
+ * every group whose entry list changes emits Group::entriesAboutToChange()
+ * once and Group::entriesChanged() at the end, allowing views to refresh in
+ * a single pass instead of once per entry. Per-entry signals are still emitted.
+ *
+ * Bulk updates can be nested, only the outermost call finishes the update.
+ */
+void Database::beginBulkUpdate()
+{
+    ++m_bulkUpdateDepth;
+}
+
+void Database::endBulkUpdate()
+{
+    Q_ASSERT(m_bulkUpdateDepth > 0);
+    if (m_bulkUpdateDepth <= 0 || --m_bulkUpdateDepth > 0) {
+        return;
+    }
+
+    const auto groups = m_bulkUpdateGroups;
+    m_bulkUpdateGroups.clear();
+    for (const auto& group : groups) {
+        // Groups deleted during the update have already finished it
+        if (group) {
+            group->endEntriesChange();
+        }
+    }
+}
+
+bool Database::isBulkUpdating() const
+{
+    return m_bulkUpdateDepth > 0;
+}
+
 bool Database::isModified() const
 {
     return m_modified;
@@ -955,6 +1488,8 @@ bool Database::hasNonDataChanges() const
 void Database::markAsModified()
 {
     m_modified = true;
+    ++m_modificationCount;
+    m_snapshot.reset();
     if (modifiedSignalEnabled() && !m_modifiedTimer.isActive()) {
         // Small time delay prevents numerous consecutive saves due to repeated signals
         startModifiedTimer();
@@ -972,9 +1507,21 @@ void Database::markAsClean()
     }
 }
 
+/**
+ * Clear the modified state without reporting a save, for changes that
+ * brought the database in line with its file, see DatabaseReloader.
+ */
+void Database::markAsUnmodified()
+{
+    m_modified = false;
+    stopModifiedTimer();
+    m_hasNonDataChange = false;
+}
+
 void Database::markNonDataChange()
 {
     m_hasNonDataChange = true;
+    m_snapshot.reset();
     emit databaseNonDataChanged();
 }
 
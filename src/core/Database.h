@@ -32,11 +32,14 @@
 #include "keys/CompositeKey.h"
 #include "keys/PasswordKey.h"
 
+class DatabaseSnapshot;
 class Entry;
 enum class EntryReferenceType;
 class FileWatcher;
 class Group;
+class LatencyStats;
 class Metadata;
+class PasswordHealthIndex;
 class QIODevice;
 
 struct DeletedObject
@@ -62,6 +65,7 @@ public:
         CompressionGZip = 1
     };
     static const quint32 CompressionAlgorithmMax = CompressionGZip;
+    static const int DefaultCompressionLevel = 6;
 
     enum SaveAction
     {
@@ -75,10 +79,19 @@ public:
     ~Database() override;
 
 private:
+    struct SaveJob;
+
     bool writeDatabase(QIODevice* device, QString* error = nullptr);
-    bool backupDatabase(const QString& filePath, const QString& destinationFilePath);
-    bool restoreDatabase(const QString& filePath, const QString& fromBackupFilePath);
-    bool performSave(const QString& filePath, SaveAction flags, const QString& backupFilePath, QString* error);
+    static bool backupDatabase(const QString& filePath, const QString& destinationFilePath);
+    static bool restoreDatabase(const QString& filePath, const QString& fromBackupFilePath);
+    static bool transformKeyForSave(SaveJob& job);
+    static bool serializeForSave(SaveJob& job);
+    static bool performSave(SaveJob& job);
+    bool beginSave(SaveJob& job, QString* error);
+    void finishSave(SaveJob& job, bool ok);
+    QSharedPointer<Database> copyForSave() const;
+    void startBackgroundSave(SaveAction action, const QString& backupFilePath);
+    void startPendingSave();
 
 public:
     bool open(QSharedPointer<const CompositeKey> key, QString* error = nullptr);
@@ -88,6 +101,9 @@ public:
                 SaveAction action = Atomic,
                 const QString& backupFilePath = QString(),
                 QString* error = nullptr);
+    void saveInBackground(SaveAction action = Atomic, const QString& backupFilePath = QString());
+    bool waitForBackgroundSave();
+    static const LatencyStats& saveLatency();
     bool extract(QByteArray&, QString* error = nullptr);
     bool import(const QString& xmlExportPath, QString* error = nullptr);
 
@@ -126,7 +142,14 @@ public:
 
     void recycleGroup(Group* group);
     void recycleEntry(Entry* entry);
+    void recycleEntries(const QList<Entry*>& entries);
+    void moveEntries(const QList<Entry*>& entries, Group* group);
+    void deleteEntries(const QList<Entry*>& entries);
     void emptyRecycleBin();
+
+    void beginBulkUpdate();
+    void endBulkUpdate();
+    bool isBulkUpdating() const;
     QList<DeletedObject> deletedObjects();
     const QList<DeletedObject>& deletedObjects() const;
     void addDeletedObject(const DeletedObject& delObj);
@@ -139,6 +162,9 @@ public:
     const QStringList& tagList() const;
     void removeTag(const QString& tag);
 
+    PasswordHealthIndex* healthIndex();
+    QSharedPointer<const DatabaseSnapshot> snapshot();
+
     QSharedPointer<const CompositeKey> key() const;
     bool setKey(const QSharedPointer<const CompositeKey>& key,
                 bool updateChangedTime = true,
@@ -151,11 +177,14 @@ public:
     void setCipher(const QUuid& cipher);
     Database::CompressionAlgorithm compressionAlgorithm() const;
     void setCompressionAlgorithm(Database::CompressionAlgorithm algo);
+    int compressionLevel() const;
+    void setCompressionLevel(int level);
 
     QSharedPointer<Kdf> kdf() const;
     void setKdf(QSharedPointer<Kdf> kdf);
     bool changeKdf(const QSharedPointer<Kdf>& kdf);
     QByteArray transformedDatabaseKey() const;
+    void reuseTransformedKeyFrom(const Database& other);
 
     void markAsTemporaryDatabase();
     bool isTemporaryDatabase();
@@ -165,6 +194,7 @@ public:
 public slots:
     void markAsModified();
     void markAsClean();
+    void markAsUnmodified();
     void updateCommonUsernames(int topN = 10);
     void updateTagList();
     void markNonDataChange();
@@ -180,6 +210,7 @@ signals:
     void groupMoved();
     void databaseOpened();
     void databaseSaved();
+    void saveFinished(bool success, const QString& error);
     void databaseDiscarded();
     void databaseFileChanged();
     void databaseNonDataChanged();
@@ -200,6 +231,15 @@ private:
         QSharedPointer<const CompositeKey> key;
         QSharedPointer<Kdf> kdf;
 
+        // Transformed key of another copy of this database, see reuseTransformedKeyFrom()
+        QSharedPointer<const CompositeKey> cachedKey;
+        QVariantMap cachedKdfParameters;
+        QScopedPointer<PasswordKey> cachedTransformedKey;
+        // Freshly seeded KDF the cached key was transformed with ahead of a save,
+        // replaces the KDF as long as its settings did not change in the meantime
+        QSharedPointer<Kdf> cachedSeededKdf;
+        QVariantMap cachedSeededKdfBase;
+
         QVariantMap publicCustomData;
 
         DatabaseData()
@@ -221,11 +261,21 @@ private:
             challengeResponseKey.reset(new PasswordKey());
 
             key.reset();
+            clearTransformedKeyCache();
 
             // Default to AES KDF, KDBX4 databases overwrite this
             kdf.reset(new AesKdf(true));
             kdf->randomizeSeed();
         }
+
+        void clearTransformedKeyCache()
+        {
+            cachedKey.reset();
+            cachedKdfParameters.clear();
+            cachedTransformedKey.reset();
+            cachedSeededKdf.reset();
+            cachedSeededKdfBase.clear();
+        }
     };
 
     void createRecycleBin();
@@ -239,17 +289,29 @@ private:
     QList<DeletedObject> m_deletedObjects;
     QTimer m_modifiedTimer;
     QMutex m_saveMutex;
+    bool m_backgroundSaving = false;
+    bool m_backgroundSavePending = false;
+    SaveAction m_pendingSaveAction = Atomic;
+    QString m_pendingBackupFilePath;
+    // Incremented on every modification to detect changes made while saving
+    quint64 m_modificationCount = 0;
     QPointer<FileWatcher> m_fileWatcher;
     bool m_modified = false;
     bool m_hasNonDataChange = false;
     QString m_keyError;
     bool m_isTemporaryDatabase = false;
+    int m_bulkUpdateDepth = 0;
+    QList<QPointer<Group>> m_bulkUpdateGroups;
 
     QStringList m_commonUsernames;
     QStringList m_tagList;
+    QScopedPointer<PasswordHealthIndex> m_healthIndex;
+    QSharedPointer<const DatabaseSnapshot> m_snapshot;
 
     QUuid m_uuid;
     static QHash<QUuid, QPointer<Database>> s_uuidMap;
+
+    friend class Group;
 };
 
 #endif // KEEPASSX_DATABASE_H
@@ -0,0 +1,264 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "DatabaseGenerator.h"
+
+#include "core/Database.h"
+#include "core/Entry.h"
+#include "core/Group.h"
+#include "core/Metadata.h"
+
+#include <QHash>
+#include <QtEndian>
+
+#include <cmath>
+#include <zlib.h>
+
+namespace
+{
+    const QStringList Words = {"alpha", "bravo",  "charlie", "delta",  "echo",    "foxtrot", "golf",
+                               "hotel", "india",  "juliett", "kilo",   "lima",    "mike",    "november",
+                               "oscar", "papa",   "quebec",  "romeo",  "sierra",  "tango",   "uniform",
+                               "victor", "whiskey", "xray",  "yankee", "zulu"};
+
+    // Timestamps are spread over five years starting at a fixed date
+    const QDateTime BaseTime(QDate(2020, 1, 1), QTime(0, 0), Qt::UTC);
+    constexpr int TimeSpanSeconds = 5 * 365 * 24 * 3600;
+
+    // Passwords follow the seed, so they must not come from PasswordGenerator and its CSPRNG
+    const QString PasswordChars = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+                                  "!\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~";
+    constexpr int PasswordLength = 20;
+
+    constexpr int HostCount = 200;
+    constexpr int IconSize = 16;
+
+    void appendPngChunk(QByteArray& png, const char* type, const QByteArray& data)
+    {
+        QByteArray chunk(type, 4);
+        chunk.append(data);
+
+        char length[4];
+        qToBigEndian(static_cast<quint32>(data.size()), length);
+        char crc[4];
+        qToBigEndian(static_cast<quint32>(crc32(0, reinterpret_cast<const Bytef*>(chunk.constData()), chunk.size())),
+                     crc);
+
+        png.append(length, 4);
+        png.append(chunk);
+        png.append(crc, 4);
+    }
+} // namespace
+
+DatabaseGenerator::DatabaseGenerator(const Options& options)
+    : m_options(options)
+    , m_random(options.seed)
+{
+}
+
+void DatabaseGenerator::populate(Database* db)
+{
+    Q_ASSERT(db);
+
+    db->metadata()->setName(QStringLiteral("Generated database %1").arg(m_options.seed));
+    db->rootGroup()->setUuid(randomUuid());
+
+    QList<QUuid> icons;
+    for (int i = 0; i < m_options.customIcons; ++i) {
+        icons.append(randomUuid());
+        db->metadata()->addCustomIcon(icons.last(), randomIcon(), QStringLiteral("Icon %1").arg(i), randomTime());
+    }
+
+    // Groups pick a random parent that is still shallower than the maximum depth,
+    // a depth of zero keeps everything in the root group
+    QList<Group*> groups;
+    QList<int> parents;
+    QHash<Group*, int> levels;
+    groups.append(db->rootGroup());
+    parents.append(0);
+    levels.insert(db->rootGroup(), 0);
+    const int groupCount = m_options.depth > 0 ? m_options.groups : 0;
+    for (int i = 0; i < groupCount; ++i) {
+        auto parent = groups.at(parents.at(m_random.bounded(parents.size())));
+
+        auto group = new Group();
+        group->setUpdateTimeinfo(false);
+        group->setUuid(randomUuid());
+        group->setName(QStringLiteral("%1 %2").arg(Words.at(m_random.bounded(Words.size()))).arg(i));
+        group->setNotes(randomText(0, 10));
+        if (!icons.isEmpty() && m_random.bounded(4) == 0) {
+            group->setIcon(icons.at(m_random.bounded(icons.size())));
+        }
+        group->setParent(parent);
+        group->setTimeInfo(randomTimeInfo());
+        group->setUpdateTimeinfo(true);
+
+        const int level = levels.value(parent) + 1;
+        levels.insert(group, level);
+        groups.append(group);
+        if (level < m_options.depth) {
+            parents.append(groups.size() - 1);
+        }
+    }
+
+    QList<Entry*> entries;
+    for (int i = 0; i < m_options.entries; ++i) {
+        auto entry = new Entry();
+        entry->setUpdateTimeinfo(false);
+        entry->setUuid(randomUuid());
+
+        const auto word = Words.at(m_random.bounded(Words.size()));
+        const int host = m_random.bounded(HostCount);
+        entry->setTitle(QStringLiteral("%1 %2").arg(word).arg(i));
+        entry->setUsername(QStringLiteral("%1%2@example.com").arg(word).arg(i));
+        entry->setPassword(randomPassword());
+        entry->setUrl(QStringLiteral("https://%1%2.example.com/login").arg(word).arg(host));
+        entry->setNotes(randomText(0, 40));
+
+        QStringList tags;
+        for (int t = m_random.bounded(4); t > 0 && m_options.tags > 0; --t) {
+            tags.append(QStringLiteral("tag%1").arg(m_random.bounded(m_options.tags)));
+        }
+        tags.removeDuplicates();
+        entry->setTags(tags.join(","));
+
+        if (!icons.isEmpty() && m_random.bounded(4) == 0) {
+            entry->setIcon(icons.at(m_random.bounded(icons.size())));
+        }
+        if (m_random.bounded(100) < m_options.attachmentPercent) {
+            entry->attachments()->set(QStringLiteral("%1-%2.bin").arg(word).arg(i), randomAttachment());
+        }
+
+        auto timeInfo = randomTimeInfo();
+        for (int h = 0; h < m_options.historyItems; ++h) {
+            entry->setTimeInfo(timeInfo);
+            entry->addHistoryItem(entry->clone(Entry::CloneNoFlags));
+            entry->setPassword(randomPassword());
+            timeInfo.setLastModificationTime(timeInfo.lastModificationTime().addDays(1 + m_random.bounded(90)));
+        }
+
+        entry->setGroup(groups.at(m_random.bounded(groups.size())));
+        entry->setTimeInfo(timeInfo);
+        entries.append(entry);
+    }
+
+    // References point at earlier entries so they never form cycles
+    for (int i = 1; i < entries.size(); ++i) {
+        if (m_random.bounded(100) >= m_options.referencePercent) {
+            continue;
+        }
+        auto entry = entries.at(i);
+        const auto target = entries.at(m_random.bounded(i));
+        if (m_random.bounded(2) == 0) {
+            entry->setUsername(QStringLiteral("{REF:U@I:%1}").arg(target->uuidToHex()));
+        } else {
+            entry->setPassword(QStringLiteral("{REF:P@I:%1}").arg(target->uuidToHex()));
+        }
+    }
+
+    for (auto entry : asConst(entries)) {
+        entry->setUpdateTimeinfo(true);
+    }
+}
+
+QUuid DatabaseGenerator::randomUuid()
+{
+    QByteArray bytes(16, '\0');
+    m_random.fillRange(reinterpret_cast<quint32*>(bytes.data()), 4);
+    // Mark as a version 4, RFC 4122 variant UUID
+    bytes[6] = static_cast<char>((bytes[6] & 0x0F) | 0x40);
+    bytes[8] = static_cast<char>((bytes[8] & 0x3F) | 0x80);
+    return QUuid::fromRfc4122(bytes);
+}
+
+QDateTime DatabaseGenerator::randomTime()
+{
+    return BaseTime.addSecs(m_random.bounded(TimeSpanSeconds));
+}
+
+QString DatabaseGenerator::randomPassword()
+{
+    QString password;
+    password.reserve(PasswordLength);
+    for (int i = 0; i < PasswordLength; ++i) {
+        password.append(PasswordChars.at(m_random.bounded(PasswordChars.size())));
+    }
+    return password;
+}
+
+TimeInfo DatabaseGenerator::randomTimeInfo()
+{
+    const auto created = randomTime();
+    TimeInfo timeInfo;
+    timeInfo.setCreationTime(created);
+    timeInfo.setLastModificationTime(created);
+    timeInfo.setLastAccessTime(created);
+    timeInfo.setLocationChanged(created);
+    if (m_random.bounded(20) == 0) {
+        timeInfo.setExpires(true);
+        timeInfo.setExpiryTime(created.addDays(365));
+    }
+    return timeInfo;
+}
+
+QString DatabaseGenerator::randomText(int minWords, int maxWords)
+{
+    QStringList words;
+    for (int count = m_random.bounded(minWords, maxWords + 1); count > 0; --count) {
+        words.append(Words.at(m_random.bounded(Words.size())));
+    }
+    return words.join(" ");
+}
+
+QByteArray DatabaseGenerator::randomAttachment()
+{
+    // Sizes vary between a quarter and four times the configured median
+    const double scale = std::pow(2.0, m_random.generateDouble() * 4.0 - 2.0);
+    const int size = qMax(1, static_cast<int>(m_options.attachmentSize * scale));
+
+    QByteArray data(size, '\0');
+    m_random.fillRange(reinterpret_cast<quint32*>(data.data()), size / int(sizeof(quint32)));
+    return data;
+}
+
+QByteArray DatabaseGenerator::randomIcon()
+{
+    // A solid color RGB PNG, small enough to build by hand without QtGui
+    const char red = static_cast<char>(m_random.bounded(256));
+    const char green = static_cast<char>(m_random.bounded(256));
+    const char blue = static_cast<char>(m_random.bounded(256));
+
+    QByteArray header(13, '\0');
+    qToBigEndian(static_cast<quint32>(IconSize), header.data());
+    qToBigEndian(static_cast<quint32>(IconSize), header.data() + 4);
+    header[8] = 8; // bit depth
+    header[9] = 2; // truecolor
+
+    QByteArray pixels;
+    for (int y = 0; y < IconSize; ++y) {
+        pixels.append('\0'); // no filter
+        for (int x = 0; x < IconSize; ++x) {
+            pixels.append(red).append(green).append(blue);
+        }
+    }
+
+    QByteArray png("\x89PNG\r\n\x1a\n", 8);
+    appendPngChunk(png, "IHDR", header);
+    // qCompress prefixes the zlib stream with the uncompressed length
+    appendPngChunk(png, "IDAT", qCompress(pixels).mid(4));
+    appendPngChunk(png, "IEND", {});
+    return png;
+}
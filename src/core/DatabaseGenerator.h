@@ -0,0 +1,69 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef KEEPASSXC_DATABASEGENERATOR_H
+#define KEEPASSXC_DATABASEGENERATOR_H
+
+#include <QDateTime>
+#include <QRandomGenerator>
+#include <QUuid>
+
+class Database;
+class TimeInfo;
+
+/**
+ * Populate a database with synthetic, reproducible content.
+ *
+ * The same options and seed always produce the same groups, entries,
+ * history, attachments, icons, tags and references, including UUIDs and
+ * timestamps. The data is meant for performance work and bug reports and
+ * must never be used to generate real credentials.
+ */
+class DatabaseGenerator
+{
+public:
+    struct Options
+    {
+        int entries = 1000;
+        int groups = 50;
+        int depth = 3;
+        int historyItems = 2;
+        int attachmentPercent = 10;
+        int attachmentSize = 4096;
+        int customIcons = 0;
+        int referencePercent = 5;
+        int tags = 20;
+        quint32 seed = 1;
+    };
+
+    explicit DatabaseGenerator(const Options& options);
+
+    void populate(Database* db);
+
+private:
+    QUuid randomUuid();
+    QDateTime randomTime();
+    QString randomPassword();
+    TimeInfo randomTimeInfo();
+    QString randomText(int minWords, int maxWords);
+    QByteArray randomAttachment();
+    QByteArray randomIcon();
+
+    Options m_options;
+    QRandomGenerator m_random;
+};
+
+#endif // KEEPASSXC_DATABASEGENERATOR_H
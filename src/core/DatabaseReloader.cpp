@@ -0,0 +1,279 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DatabaseReloader.h"
+
+#include "core/Database.h"
+#include "core/Group.h"
+#include "core/Metadata.h"
+
+#include <QSet>
+
+namespace
+{
+    // KDF parameters without the seed, which changes on every save
+    QVariantMap kdfSettings(const QSharedPointer<Kdf>& kdf)
+    {
+        auto parameters = KeePass2::kdfToParameters(kdf);
+        parameters.remove(KeePass2::KDFPARAM_AES_SEED);
+        parameters.remove(KeePass2::KDFPARAM_ARGON2_SALT);
+        return parameters;
+    }
+} // namespace
+
+DatabaseReloader::DatabaseReloader(const Database* sourceDb, Database* targetDb)
+    : m_sourceDb(sourceDb)
+    , m_targetDb(targetDb)
+{
+}
+
+/**
+ * Whether the target can be updated in place. This requires the same root
+ * group and unchanged KDF settings, because the target keeps its own key.
+ */
+bool DatabaseReloader::canReloadInPlace() const
+{
+    if (!m_sourceDb || !m_targetDb || !m_sourceDb->rootGroup() || !m_targetDb->rootGroup()) {
+        return false;
+    }
+    if (m_sourceDb->rootGroup()->uuid() != m_targetDb->rootGroup()->uuid()) {
+        return false;
+    }
+    return kdfSettings(m_sourceDb->kdf()) == kdfSettings(m_targetDb->kdf());
+}
+
+/**
+ * Apply the source database to the target.
+ *
+ * @return false if the target cannot be updated in place, in which case it is left untouched
+ */
+bool DatabaseReloader::reload()
+{
+    if (!canReloadInPlace()) {
+        return false;
+    }
+
+    m_changes = 0;
+    m_initialTargetGroups = m_targetDb->rootGroup()->groupsRecursive(true);
+    m_targetGroups.clear();
+    for (auto group : asConst(m_initialTargetGroups)) {
+        m_targetGroups.insert(group->uuid(), group);
+    }
+    m_targetEntries.clear();
+    for (auto entry : m_targetDb->rootGroup()->entriesRecursive()) {
+        m_targetEntries.insert(entry->uuid(), entry);
+    }
+
+    // Create and move groups first so entries always have a destination,
+    // then drop whatever the source no longer has
+    syncGroups();
+    syncEntries();
+    removeStaleItems();
+    syncGroupOrder();
+    syncEntryOrder();
+    syncGroupData();
+    syncMetadata();
+
+    m_targetDb->setCipher(m_sourceDb->cipher());
+    m_targetDb->setCompressionAlgorithm(m_sourceDb->compressionAlgorithm());
+    m_targetDb->setFormatVersion(m_sourceDb->formatVersion());
+    m_targetDb->setPublicCustomData(m_sourceDb->publicCustomData());
+    m_targetDb->setDeletedObjects(m_sourceDb->deletedObjects());
+
+    return true;
+}
+
+/**
+ * Number of groups and entries that were added, moved, changed or removed
+ * by the last reload.
+ */
+int DatabaseReloader::changes() const
+{
+    return m_changes;
+}
+
+void DatabaseReloader::syncGroups()
+{
+    for (const auto* sourceGroup : m_sourceDb->rootGroup()->groupsRecursive(false)) {
+        // Groups are visited parents first, so the parent is always known
+        auto parent = m_targetGroups.value(sourceGroup->parentGroup()->uuid());
+        Q_ASSERT(parent);
+
+        auto group = m_targetGroups.value(sourceGroup->uuid());
+        if (!group) {
+            group = new Group();
+            group->setUpdateTimeinfo(false);
+            group->setUuid(sourceGroup->uuid());
+            group->copyDataFrom(sourceGroup);
+            group->setParent(parent);
+            group->setUpdateTimeinfo(true);
+            m_targetGroups.insert(group->uuid(), group);
+            ++m_changes;
+        } else if (group->parentGroup() != parent) {
+            group->setUpdateTimeinfo(false);
+            group->setParent(parent);
+            group->setUpdateTimeinfo(true);
+            ++m_changes;
+        }
+    }
+}
+
+void DatabaseReloader::syncEntries()
+{
+    for (const auto* sourceGroup : m_sourceDb->rootGroup()->groupsRecursive(true)) {
+        auto group = m_targetGroups.value(sourceGroup->uuid());
+        for (const auto* sourceEntry : sourceGroup->entries()) {
+            auto entry = m_targetEntries.value(sourceEntry->uuid());
+            if (!entry) {
+                entry = sourceEntry->clone(Entry::CloneIncludeHistory);
+                entry->setUpdateTimeinfo(false);
+                entry->setGroup(group);
+                entry->setUpdateTimeinfo(true);
+                m_targetEntries.insert(entry->uuid(), entry);
+                ++m_changes;
+                continue;
+            }
+
+            bool changed = false;
+            if (entry->group() != group) {
+                entry->setUpdateTimeinfo(false);
+                entry->setGroup(group);
+                entry->setUpdateTimeinfo(true);
+                changed = true;
+            }
+            if (!entry->equals(sourceEntry)) {
+                entry->syncFrom(sourceEntry);
+                changed = true;
+            }
+            if (changed) {
+                ++m_changes;
+            }
+        }
+    }
+}
+
+void DatabaseReloader::removeStaleItems()
+{
+    QSet<QUuid> sourceEntries;
+    for (const auto* entry : m_sourceDb->rootGroup()->entriesRecursive()) {
+        sourceEntries.insert(entry->uuid());
+    }
+    for (auto it = m_targetEntries.begin(); it != m_targetEntries.end();) {
+        if (sourceEntries.contains(it.key())) {
+            ++it;
+            continue;
+        }
+        delete it.value();
+        it = m_targetEntries.erase(it);
+        ++m_changes;
+    }
+
+    // Children before parents, everything left in a stale group is stale too
+    QSet<QUuid> sourceGroups;
+    for (const auto* group : m_sourceDb->rootGroup()->groupsRecursive(true)) {
+        sourceGroups.insert(group->uuid());
+    }
+    for (int i = m_initialTargetGroups.size() - 1; i >= 0; --i) {
+        auto group = m_initialTargetGroups.at(i);
+        if (!sourceGroups.contains(group->uuid())) {
+            m_targetGroups.remove(group->uuid());
+            delete group;
+            ++m_changes;
+        }
+    }
+    m_initialTargetGroups.clear();
+}
+
+void DatabaseReloader::syncGroupOrder()
+{
+    for (const auto* sourceGroup : m_sourceDb->rootGroup()->groupsRecursive(true)) {
+        auto group = m_targetGroups.value(sourceGroup->uuid());
+        const auto& sourceChildren = sourceGroup->children();
+        for (int i = 0; i < sourceChildren.size(); ++i) {
+            auto child = m_targetGroups.value(sourceChildren.at(i)->uuid());
+            if (group->children().indexOf(child) != i) {
+                child->setUpdateTimeinfo(false);
+                child->setParent(group, i);
+                child->setUpdateTimeinfo(true);
+            }
+        }
+    }
+}
+
+void DatabaseReloader::syncEntryOrder()
+{
+    for (const auto* sourceGroup : m_sourceDb->rootGroup()->groupsRecursive(true)) {
+        auto group = m_targetGroups.value(sourceGroup->uuid());
+        const auto& sourceEntries = sourceGroup->entries();
+        for (int i = 0; i < sourceEntries.size(); ++i) {
+            // Rows before i are in place already, so the entry can only be further down
+            auto entry = m_targetEntries.value(sourceEntries.at(i)->uuid());
+            int row = group->entries().indexOf(entry);
+            if (row > i) {
+                ++m_changes;
+            }
+            for (; row > i; --row) {
+                group->moveEntryUp(entry);
+            }
+        }
+    }
+}
+
+void DatabaseReloader::syncGroupData()
+{
+    for (const auto* sourceGroup : m_sourceDb->rootGroup()->groupsRecursive(true)) {
+        auto group = m_targetGroups.value(sourceGroup->uuid());
+        group->setUpdateTimeinfo(false);
+        group->copyDataFrom(sourceGroup);
+        group->setUpdateTimeinfo(true);
+    }
+}
+
+void DatabaseReloader::syncMetadata()
+{
+    const auto sourceMetadata = m_sourceDb->metadata();
+    auto metadata = m_targetDb->metadata();
+
+    metadata->copyAttributesFrom(sourceMetadata);
+    metadata->customData()->copyDataFrom(sourceMetadata->customData());
+
+    // Icons missing from the source or changed there are removed, then the missing ones are copied
+    for (const auto& uuid : metadata->customIconsOrder()) {
+        if (!sourceMetadata->hasCustomIcon(uuid) || !(sourceMetadata->customIcon(uuid) == metadata->customIcon(uuid))) {
+            metadata->removeCustomIcon(uuid);
+        }
+    }
+    QSet<QUuid> icons;
+    for (const auto& uuid : sourceMetadata->customIconsOrder()) {
+        icons.insert(uuid);
+    }
+    metadata->copyCustomIcons(icons, sourceMetadata);
+
+    if (sourceMetadata->recycleBin()) {
+        metadata->setRecycleBin(m_targetGroups.value(sourceMetadata->recycleBin()->uuid()));
+    } else {
+        metadata->setRecycleBin(nullptr);
+    }
+    metadata->setRecycleBinChanged(sourceMetadata->recycleBinChanged());
+
+    if (sourceMetadata->entryTemplatesGroup()) {
+        metadata->setEntryTemplatesGroup(m_targetGroups.value(sourceMetadata->entryTemplatesGroup()->uuid()));
+    } else {
+        metadata->setEntryTemplatesGroup(nullptr);
+    }
+    metadata->setEntryTemplatesGroupChanged(sourceMetadata->entryTemplatesGroupChanged());
+}
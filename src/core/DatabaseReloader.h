@@ -0,0 +1,64 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEEPASSXC_DATABASERELOADER_H
+#define KEEPASSXC_DATABASERELOADER_H
+
+#include <QHash>
+#include <QUuid>
+
+class Database;
+class Entry;
+class Group;
+
+/**
+ * Apply a freshly loaded copy of a database to the open instance in place.
+ *
+ * Unlike Merger, the target ends up identical to the source: groups and
+ * entries are matched by UUID, only changed items are touched, items
+ * missing from the source are removed and the order of groups and entries
+ * follows the source. Models attached to the target
+ * receive the regular fine-grained change signals, so views keep their
+ * selection and scroll position.
+ */
+class DatabaseReloader
+{
+public:
+    DatabaseReloader(const Database* sourceDb, Database* targetDb);
+
+    bool canReloadInPlace() const;
+    bool reload();
+    int changes() const;
+
+private:
+    void syncGroups();
+    void syncEntries();
+    void removeStaleItems();
+    void syncGroupOrder();
+    void syncEntryOrder();
+    void syncGroupData();
+    void syncMetadata();
+
+    const Database* m_sourceDb;
+    Database* m_targetDb;
+    QList<Group*> m_initialTargetGroups;
+    QHash<QUuid, Group*> m_targetGroups;
+    QHash<QUuid, Entry*> m_targetEntries;
+    int m_changes = 0;
+};
+
+#endif // KEEPASSXC_DATABASERELOADER_H
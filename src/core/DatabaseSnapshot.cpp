@@ -0,0 +1,117 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DatabaseSnapshot.h"
+
+#include "core/Clock.h"
+#include "core/Group.h"
+#include "core/Metadata.h"
+
+bool DatabaseSnapshot::Entry::isExpired() const
+{
+    return timeInfo.expires() && timeInfo.expiryTime() < Clock::currentDateTime();
+}
+
+/**
+ * Copy the groups and entries of the database. Must be called from
+ * the thread that owns the database.
+ */
+DatabaseSnapshot::DatabaseSnapshot(const Database* db)
+    : m_filePath(db->filePath())
+{
+    const auto root = db->rootGroup();
+    if (!root) {
+        return;
+    }
+
+    const auto recycleBin = db->metadata()->recycleBin();
+    const auto groups = root->groupsRecursive(true);
+    QHash<const ::Group*, int> groupIndex;
+    groupIndex.reserve(groups.size());
+    m_groups.reserve(groups.size());
+
+    for (const auto group : groups) {
+        Group data;
+        data.uuid = group->uuid();
+        data.name = group->name();
+        data.parent = groupIndex.value(group->parentGroup(), -1);
+        data.timeInfo = group->timeInfo();
+        data.recycled = group == recycleBin || (data.parent >= 0 && m_groups.at(data.parent).recycled);
+
+        groupIndex.insert(group, m_groups.size());
+        m_groups.append(data);
+
+        for (const auto entry : group->entries()) {
+            Entry entryData;
+            entryData.uuid = entry->uuid();
+            entryData.group = m_groups.size() - 1;
+            entryData.title = entry->title();
+            entryData.username = entry->username();
+            entryData.password = entry->password();
+            entryData.url = entry->url();
+            entryData.notes = entry->notes();
+            entryData.tags = entry->tagList();
+            entryData.timeInfo = entry->timeInfo();
+            entryData.passwordIsReference = entry->isAttributeReference(EntryAttributes::PasswordKey);
+            entryData.excludeFromReports = entry->excludeFromReports();
+            entryData.recycled = data.recycled;
+
+            if (!entryData.recycled && !entryData.passwordIsReference && !entryData.password.isEmpty()) {
+                m_passwordUsers[entryData.password].append(m_entries.size());
+            }
+            m_entries.append(entryData);
+        }
+    }
+}
+
+const QString& DatabaseSnapshot::filePath() const
+{
+    return m_filePath;
+}
+
+const QVector<DatabaseSnapshot::Group>& DatabaseSnapshot::groups() const
+{
+    return m_groups;
+}
+
+const QVector<DatabaseSnapshot::Entry>& DatabaseSnapshot::entries() const
+{
+    return m_entries;
+}
+
+/**
+ * Names of the group and its parents, starting with the root group.
+ *
+ * @see ::Group::hierarchy()
+ */
+QStringList DatabaseSnapshot::hierarchy(int group) const
+{
+    QStringList hierarchy;
+    for (int index = group; index >= 0; index = m_groups.at(index).parent) {
+        hierarchy.prepend(m_groups.at(index).name);
+    }
+    return hierarchy;
+}
+
+/**
+ * Entries outside of the recycle bin that use the given password,
+ * passwords that reference other entries are not considered.
+ */
+QVector<int> DatabaseSnapshot::entriesUsingPassword(const QString& password) const
+{
+    return m_passwordUsers.value(password);
+}
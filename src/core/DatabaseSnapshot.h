@@ -0,0 +1,86 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEEPASSXC_DATABASESNAPSHOT_H
+#define KEEPASSXC_DATABASESNAPSHOT_H
+
+#include <QHash>
+#include <QStringList>
+#include <QUuid>
+#include <QVector>
+
+#include "core/TimeInfo.h"
+
+class Database;
+
+/**
+ * Immutable copy of the groups and entries of a database.
+ *
+ * Snapshots consist of plain values that share their string data with
+ * the database, so taking one is cheap and it can be handed to worker
+ * threads while the database keeps changing. Use Database::snapshot()
+ * to get the current snapshot of a database.
+ */
+class DatabaseSnapshot
+{
+public:
+    struct Group
+    {
+        QUuid uuid;
+        QString name;
+        int parent = -1;
+        TimeInfo timeInfo;
+        bool recycled = false;
+    };
+
+    struct Entry
+    {
+        QUuid uuid;
+        int group = -1;
+        QString title;
+        QString username;
+        QString password;
+        QString url;
+        QString notes;
+        QStringList tags;
+        TimeInfo timeInfo;
+        bool passwordIsReference = false;
+        bool excludeFromReports = false;
+        bool recycled = false;
+
+        bool isExpired() const;
+    };
+
+    explicit DatabaseSnapshot(const Database* db);
+
+    const QString& filePath() const;
+    const QVector<Group>& groups() const;
+    const QVector<Entry>& entries() const;
+
+    QStringList hierarchy(int group) const;
+    QVector<int> entriesUsingPassword(const QString& password) const;
+
+private:
+    QString m_filePath;
+    // Parents are stored before their children, the root group comes first
+    QVector<Group> m_groups;
+    QVector<Entry> m_entries;
+    // Entries outside of the recycle bin by plain password
+    QHash<QString, QVector<int>> m_passwordUsers;
+};
+
+#endif // KEEPASSXC_DATABASESNAPSHOT_H
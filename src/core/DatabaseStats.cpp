@@ -16,12 +16,12 @@
  */
 #include "DatabaseStats.h"
 
-// Ctor does all the work
-DatabaseStats::DatabaseStats(QSharedPointer<Database> db)
-    : modified(QFileInfo(db->filePath()).lastModified())
-    , m_db(db)
+// Ctor does all the work, it can run on any thread
+DatabaseStats::DatabaseStats(QSharedPointer<const DatabaseSnapshot> snapshot)
+    : modified(QFileInfo(snapshot->filePath()).lastModified())
+    , m_snapshot(std::move(snapshot))
 {
-    gatherStats(db->rootGroup()->groupsRecursive(true));
+    gatherStats();
 }
 
 // Get average password length
@@ -64,56 +64,54 @@ bool DatabaseStats::isAvgPwdTooShort() const
     return averagePwdLength() < 10;
 }
 
-void DatabaseStats::gatherStats(const QList<Group*>& groups)
+void DatabaseStats::gatherStats()
 {
-    auto checker = HealthChecker(m_db);
+    auto checker = HealthChecker(m_snapshot);
 
-    for (const auto* group : groups) {
+    for (const auto& group : m_snapshot->groups()) {
         // Don't count anything in the recycle bin
-        if (group->isRecycled()) {
+        if (!group.recycled) {
+            ++groupCount;
+        }
+    }
+
+    for (const auto& entry : m_snapshot->entries()) {
+        // Don't count anything in the recycle bin
+        if (entry.recycled) {
             continue;
         }
 
-        ++groupCount;
+        ++entryCount;
 
-        for (const auto* entry : group->entries()) {
-            // Don't count anything in the recycle bin
-            if (entry->isRecycled()) {
-                continue;
+        if (entry.isExpired()) {
+            ++expiredEntries;
+        }
+
+        // Get password statistics
+        const auto& pwd = entry.password;
+        if (!pwd.isEmpty()) {
+            if (!m_passwords.contains(pwd)) {
+                ++uniquePasswords;
+            } else {
+                ++reusedPasswords;
             }
 
-            ++entryCount;
+            if (pwd.size() < PasswordHealth::Length::Short) {
+                ++shortPasswords;
+            }
 
-            if (entry->isExpired()) {
-                ++expiredEntries;
+            // Speed up Zxcvbn process by excluding very long passwords and most passphrases
+            if (pwd.size() < PasswordHealth::Length::Long
+                && checker.evaluate(entry)->quality() <= PasswordHealth::Quality::Weak) {
+                ++weakPasswords;
             }
 
-            // Get password statistics
-            const auto pwd = entry->password();
-            if (!pwd.isEmpty()) {
-                if (!m_passwords.contains(pwd)) {
-                    ++uniquePasswords;
-                } else {
-                    ++reusedPasswords;
-                }
-
-                if (pwd.size() < PasswordHealth::Length::Short) {
-                    ++shortPasswords;
-                }
-
-                // Speed up Zxcvbn process by excluding very long passwords and most passphrases
-                if (pwd.size() < PasswordHealth::Length::Long
-                    && checker.evaluate(entry)->quality() <= PasswordHealth::Quality::Weak) {
-                    ++weakPasswords;
-                }
-
-                if (entry->excludeFromReports()) {
-                    ++excludedEntries;
-                }
-
-                totalPasswordLength += pwd.size();
-                m_passwords[pwd]++;
+            if (entry.excludeFromReports) {
+                ++excludedEntries;
             }
+
+            totalPasswordLength += pwd.size();
+            m_passwords[pwd]++;
         }
     }
 }
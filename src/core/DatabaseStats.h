@@ -18,7 +18,7 @@
 #ifndef KEEPASSXC_DATABASESTATS_H
 #define KEEPASSXC_DATABASESTATS_H
 #include "PasswordHealth.h"
-#include "core/Group.h"
+#include "core/DatabaseSnapshot.h"
 #include <QFileInfo>
 #include <cmath>
 class DatabaseStats
@@ -36,7 +36,7 @@ public:
     int reusedPasswords = 0; // Number of non-unique passwords
     int totalPasswordLength = 0; // Total length of all passwords
 
-    explicit DatabaseStats(QSharedPointer<Database> db);
+    explicit DatabaseStats(QSharedPointer<const DatabaseSnapshot> snapshot);
 
     int averagePwdLength() const;
 
@@ -51,9 +51,9 @@ public:
     bool isAvgPwdTooShort() const;
 
 private:
-    QSharedPointer<Database> m_db;
+    QSharedPointer<const DatabaseSnapshot> m_snapshot;
     QHash<QString, int> m_passwords;
 
-    void gatherStats(const QList<Group*>& groups);
+    void gatherStats();
 };
 #endif // KEEPASSXC_DATABASESTATS_H
@@ -349,12 +349,13 @@ QList<QString> Entry::autoTypeSequences(const QString& windowTitle) const
     }
 
     // Try to match window title
-    if (config()->get(Config::AutoTypeEntryTitleMatch).toBool() && windowMatchesTitle(resolvePlaceholder(title()))) {
+    const auto settings = config()->snapshot();
+    if (settings->getBool(Config::AutoTypeEntryTitleMatch) && windowMatchesTitle(resolvePlaceholder(title()))) {
         sequenceList << effectiveAutoTypeSequence();
     }
 
     // Try to match url in window title
-    if (config()->get(Config::AutoTypeEntryURLMatch).toBool() && windowMatchesUrl(resolvePlaceholder(url()))) {
+    if (settings->getBool(Config::AutoTypeEntryURLMatch) && windowMatchesUrl(resolvePlaceholder(url()))) {
         sequenceList << effectiveAutoTypeSequence();
     }
 
@@ -1000,6 +1001,29 @@ void Entry::copyDataFrom(const Entry* other)
     setUpdateTimeinfo(true);
 }
 
+/**
+ * Make this entry an exact copy of another version of itself, including
+ * history and time info, and notify views of the change. Used to apply
+ * external changes to an open database in place.
+ */
+void Entry::syncFrom(const Entry* other)
+{
+    Q_ASSERT(other->uuid() == m_uuid);
+
+    copyDataFrom(other);
+
+    setUpdateTimeinfo(false);
+    const auto history = m_history;
+    removeHistoryItems(history);
+    for (const auto* item : other->m_history) {
+        addHistoryItem(item->clone(CloneNoFlags));
+    }
+    m_data.passwordHealth.reset();
+    emitModified();
+    emitDataChanged();
+    setUpdateTimeinfo(true);
+}
+
 void Entry::beginUpdate()
 {
     Q_ASSERT(m_tmpHistoryItem.isNull());
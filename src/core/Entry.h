@@ -241,6 +241,7 @@ public:
      */
     Entry* clone(CloneFlags flags = CloneDefault) const;
     void copyDataFrom(const Entry* other);
+    void syncFrom(const Entry* other);
     QString maskPasswordPlaceholders(const QString& str) const;
     Entry* resolveReference(const QString& str) const;
     QString resolveMultiplePlaceholders(const QString& str) const;
@@ -20,6 +20,7 @@
 #include "config-keepassx.h"
 #include "core/Global.h"
 #include "core/Tools.h"
+#include "crypto/CryptoHash.h"
 #include "crypto/Random.h"
 
 #include <QDesktopServices>
@@ -59,6 +60,31 @@ QByteArray EntryAttachments::value(const QString& key) const
     return m_attachments.value(key);
 }
 
+/**
+ * SHA-256 digest of an attachment, used to deduplicate binaries on save.
+ * It is computed on first use and kept until the attachment changes, so
+ * saving does not re-hash attachments that were not modified.
+ *
+ * @param key attachment name
+ * @return digest or an empty array if there is no such attachment
+ */
+QByteArray EntryAttachments::digest(const QString& key) const
+{
+    auto it = m_digests.constFind(key);
+    if (it != m_digests.constEnd()) {
+        return it.value();
+    }
+
+    auto attachment = m_attachments.constFind(key);
+    if (attachment == m_attachments.constEnd()) {
+        return {};
+    }
+
+    const auto digest = CryptoHash::hash(attachment.value(), CryptoHash::Sha256);
+    m_digests.insert(key, digest);
+    return digest;
+}
+
 void EntryAttachments::set(const QString& key, const QByteArray& value)
 {
     bool shouldEmitModified = false;
@@ -70,6 +96,7 @@ void EntryAttachments::set(const QString& key, const QByteArray& value)
 
     if (addAttachment || m_attachments.value(key) != value) {
         m_attachments.insert(key, value);
+        m_digests.remove(key);
         shouldEmitModified = true;
     }
 
@@ -94,6 +121,7 @@ void EntryAttachments::remove(const QString& key)
     emit aboutToBeRemoved(key);
 
     m_attachments.remove(key);
+    m_digests.remove(key);
 
     if (m_openedAttachments.contains(key)) {
         disconnectAndEraseExternalFile(m_openedAttachments.value(key));
@@ -146,6 +174,7 @@ void EntryAttachments::clear()
     emit aboutToBeReset();
 
     m_attachments.clear();
+    m_digests.clear();
 
     const auto externalPath = m_openedAttachments.values();
     for (auto& path : externalPath) {
@@ -189,12 +218,29 @@ void EntryAttachments::copyDataFrom(const EntryAttachments* other)
         }
 
         m_attachments = other->m_attachments;
+        m_digests = other->m_digests;
 
         emit reset();
         emitModified();
     }
 }
 
+/**
+ * Take over the digests computed by a copy of these attachments, e.g. while
+ * it was saved. Only attachments that still share their data with the copy
+ * are considered, comparing the data itself would cost as much as hashing it.
+ */
+void EntryAttachments::copyDigestsFrom(const EntryAttachments* other)
+{
+    for (auto it = other->m_digests.constBegin(); it != other->m_digests.constEnd(); ++it) {
+        const auto attachment = m_attachments.constFind(it.key());
+        if (attachment != m_attachments.constEnd() && !m_digests.contains(it.key())
+            && attachment.value().constData() == other->m_attachments.value(it.key()).constData()) {
+            m_digests.insert(it.key(), it.value());
+        }
+    }
+}
+
 bool EntryAttachments::operator==(const EntryAttachments& other) const
 {
     return m_attachments == other.m_attachments;
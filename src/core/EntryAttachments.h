@@ -39,6 +39,7 @@ public:
     bool hasKey(const QString& key) const;
     QSet<QByteArray> values() const;
     QByteArray value(const QString& key) const;
+    QByteArray digest(const QString& key) const;
     void set(const QString& key, const QByteArray& value);
     void remove(const QString& key);
     void remove(const QStringList& keys);
@@ -46,6 +47,7 @@ public:
     bool isEmpty() const;
     void clear();
     void copyDataFrom(const EntryAttachments* other);
+    void copyDigestsFrom(const EntryAttachments* other);
     bool operator==(const EntryAttachments& other) const;
     bool operator!=(const EntryAttachments& other) const;
     int attachmentsSize() const;
@@ -68,6 +70,7 @@ private:
     void disconnectAndEraseExternalFile(const QString& path);
 
     QMap<QString, QByteArray> m_attachments;
+    mutable QHash<QString, QByteArray> m_digests;
     QHash<QString, QString> m_openedAttachments;
     QHash<QString, QString> m_openedAttachmentsInverse;
     QHash<QString, QSharedPointer<FileWatcher>> m_attachmentFileWatchers;
@@ -19,14 +19,33 @@
 
 #include "core/AsyncTask.h"
 
+#include <QCryptographicHash>
+#include <QFileInfo>
+
+#ifdef Q_OS_UNIX
+#include <sys/stat.h>
+#endif
 #ifdef Q_OS_LINUX
 #include <sys/statfs.h>
 #endif
 
+namespace
+{
+    constexpr qint64 ReadChunkSize = 64 * 1024;
+
+#ifdef Q_OS_UNIX
+    qint64 toNsecs(const struct timespec& time)
+    {
+        return static_cast<qint64>(time.tv_sec) * 1000000000 + time.tv_nsec;
+    }
+#endif
+} // namespace
+
 FileWatcher::FileWatcher(QObject* parent)
     : QObject(parent)
 {
-    connect(&m_fileWatcher, SIGNAL(fileChanged(QString)), SLOT(checkFileChanged()));
+    // Notifications from the file system always warrant a checksum, polling only does when the metadata changed
+    connect(&m_fileWatcher, &QFileSystemWatcher::fileChanged, this, [this] { checkFileChanged(true); });
     connect(&m_fileChecksumTimer, SIGNAL(timeout()), SLOT(checkFileChanged()));
     connect(&m_fileChangeDelayTimer, &QTimer::timeout, this, [this] { emit fileChanged(m_filePath); });
     m_fileChangeDelayTimer.setSingleShot(true);
@@ -62,7 +81,7 @@ void FileWatcher::start(const QString& filePath, int checksumIntervalSeconds, in
 
     // Handle file checksum
     m_fileChecksumSizeBytes = checksumSizeKibibytes * 1024;
-    m_fileChecksum = calculateChecksum();
+    updateChecksum(calculateChecksum(m_filePath, m_fileChecksumSizeBytes, {}, {}));
     if (checksumIntervalSeconds > 0) {
         m_fileChecksumTimer.start(checksumIntervalSeconds * 1000);
     }
@@ -77,6 +96,7 @@ void FileWatcher::stop()
     }
     m_filePath.clear();
     m_fileChecksum.clear();
+    m_fileStat = {};
     m_fileChecksumTimer.stop();
     m_fileChangeDelayTimer.stop();
 }
@@ -104,10 +124,29 @@ bool FileWatcher::shouldIgnoreChanges()
 
 bool FileWatcher::hasSameFileChecksum()
 {
-    return calculateChecksum() == m_fileChecksum;
+    // Always hash here, this guards against overwriting external changes on save
+    auto checksum = calculateChecksum(m_filePath, m_fileChecksumSizeBytes, m_fileChecksum, {});
+    m_lastCheckBytesRead = checksum.bytesRead;
+    m_totalBytesRead += checksum.bytesRead;
+    return checksum.digest == m_fileChecksum;
+}
+
+qint64 FileWatcher::lastCheckBytesRead() const
+{
+    return m_lastCheckBytesRead;
+}
+
+qint64 FileWatcher::totalBytesRead() const
+{
+    return m_totalBytesRead;
 }
 
-void FileWatcher::checkFileChanged()
+int FileWatcher::skippedChecksums() const
+{
+    return m_skippedChecksums;
+}
+
+void FileWatcher::checkFileChanged(bool force)
 {
     if (shouldIgnoreChanges()) {
         return;
@@ -116,31 +155,144 @@ void FileWatcher::checkFileChanged()
     // Prevent reentrance
     m_ignoreFileChange = true;
 
-    AsyncTask::runThenCallback([this] { return calculateChecksum(); },
-                               this,
-                               [this](QByteArray checksum) {
-                                   if (checksum != m_fileChecksum) {
-                                       m_fileChecksum = checksum;
-                                       m_fileChangeDelayTimer.start(0);
-                                   }
+    auto path = m_filePath;
+    auto sizeBytes = m_fileChecksumSizeBytes;
+    auto lastChecksum = m_fileChecksum;
+    auto lastStat = force ? FileStat() : m_fileStat;
+    AsyncTask::runThenCallback(
+        [=] { return calculateChecksum(path, sizeBytes, lastChecksum, lastStat); },
+        this,
+        [this, path](const Checksum& checksum) {
+            if (path == m_filePath) {
+                bool changed = checksum.digest != m_fileChecksum;
+                updateChecksum(checksum);
+                if (changed) {
+                    m_fileChangeDelayTimer.start(0);
+                }
+            }
 
-                                   m_ignoreFileChange = false;
-                               });
+            m_ignoreFileChange = false;
+        });
 }
 
-QByteArray FileWatcher::calculateChecksum()
+void FileWatcher::updateChecksum(const Checksum& checksum)
 {
-    QFile file(m_filePath);
-    if (!m_filePath.isEmpty() && file.open(QFile::ReadOnly)) {
-        QCryptographicHash hash(QCryptographicHash::Sha256);
-        if (m_fileChecksumSizeBytes > 0) {
-            hash.addData(file.read(m_fileChecksumSizeBytes));
-        } else {
-            hash.addData(&file);
-        }
-        return hash.result();
+    m_fileChecksum = checksum.digest;
+    m_fileStat = checksum.stat;
+    m_lastCheckBytesRead = checksum.bytesRead;
+    m_totalBytesRead += checksum.bytesRead;
+    if (checksum.skipped) {
+        ++m_skippedChecksums;
+    }
+}
+
+FileWatcher::FileStat FileWatcher::statFile(const QString& path)
+{
+    FileStat stat;
+    if (path.isEmpty()) {
+        return stat;
+    }
+
+#ifdef Q_OS_UNIX
+    struct stat statBuf;
+    if (::stat(QFile::encodeName(path).constData(), &statBuf) == 0) {
+        stat.exists = true;
+        stat.size = statBuf.st_size;
+#if defined(Q_OS_MACOS)
+        stat.modified = toNsecs(statBuf.st_mtimespec);
+        stat.changed = toNsecs(statBuf.st_ctimespec);
+#else
+        stat.modified = toNsecs(statBuf.st_mtim);
+        stat.changed = toNsecs(statBuf.st_ctim);
+#endif
+        stat.inode = statBuf.st_ino;
+    }
+#else
+    QFileInfo info(path);
+    if (info.exists()) {
+        stat.exists = true;
+        stat.size = info.size();
+        stat.modified = info.lastModified().toMSecsSinceEpoch() * 1000000;
+        stat.changed = info.metadataChangeTime().toMSecsSinceEpoch() * 1000000;
     }
+#endif
+    return stat;
+}
+
+bool FileWatcher::FileStat::operator==(const FileStat& other) const
+{
+    return exists == other.exists && size == other.size && modified == other.modified && changed == other.changed
+           && inode == other.inode;
+}
+
+bool FileWatcher::FileStat::operator!=(const FileStat& other) const
+{
+    return !(*this == other);
+}
+
+/**
+ * Calculate the checksum of the watched file, hashing only when its metadata differs from lastStat.
+ *
+ * Metadata is only trusted once a hashing check saw it unchanged from the check before. A write
+ * within the same timestamp tick as the last hash keeps the metadata, it is caught by that second
+ * hash. This relies on the file's own timestamps only, the local clock may differ from the one of
+ * a network share.
+ *
+ * With a bounded sizeBytes only the head and the tail of the file are read. For KDBX files
+ * this covers the header, which carries a fresh master seed and IV on every save, and the
+ * final HMAC block. Otherwise the whole file is hashed in chunks.
+ */
+FileWatcher::Checksum FileWatcher::calculateChecksum(const QString& path,
+                                                     int sizeBytes,
+                                                     const QByteArray& lastChecksum,
+                                                     const FileStat& lastStat)
+{
+    Checksum checksum;
+    checksum.stat = statFile(path);
     // If we fail to open the file return the last known checksum, this
     // prevents unnecessary merge requests on intermittent network shares
-    return m_fileChecksum;
+    checksum.digest = lastChecksum;
+
+    if (!checksum.stat.exists) {
+        checksum.stat = lastStat;
+        return checksum;
+    }
+
+    checksum.stat.stable = lastStat.exists && checksum.stat == lastStat;
+    if (!lastChecksum.isEmpty() && checksum.stat.stable && lastStat.stable) {
+        checksum.skipped = true;
+        return checksum;
+    }
+
+    QFile file(path);
+    if (!file.open(QFile::ReadOnly)) {
+        checksum.stat = lastStat;
+        return checksum;
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    if (sizeBytes > 0) {
+        auto head = file.read(sizeBytes);
+        hash.addData(head);
+        checksum.bytesRead += head.size();
+
+        const auto fileSize = file.size();
+        if (fileSize > sizeBytes && file.seek(qMax<qint64>(sizeBytes, fileSize - sizeBytes))) {
+            auto tail = file.read(sizeBytes);
+            hash.addData(tail);
+            checksum.bytesRead += tail.size();
+        }
+        hash.addData(QByteArray::number(fileSize));
+    } else {
+        while (!file.atEnd()) {
+            auto chunk = file.read(ReadChunkSize);
+            if (chunk.isEmpty()) {
+                break;
+            }
+            hash.addData(chunk);
+            checksum.bytesRead += chunk.size();
+        }
+    }
+    checksum.digest = hash.result();
+    return checksum;
 }
@@ -34,6 +34,10 @@ public:
 
     bool hasSameFileChecksum();
 
+    qint64 lastCheckBytesRead() const;
+    qint64 totalBytesRead() const;
+    int skippedChecksums() const;
+
 signals:
     void fileChanged(const QString& path);
 
@@ -42,15 +46,45 @@ public slots:
     void resume();
 
 private slots:
-    void checkFileChanged();
+    void checkFileChanged(bool force = false);
 
 private:
-    QByteArray calculateChecksum();
+    struct FileStat
+    {
+        bool exists = false;
+        qint64 size = -1;
+        // Nanoseconds since the epoch, as precise as the file system provides
+        qint64 modified = -1;
+        qint64 changed = -1;
+        quint64 inode = 0;
+        // Equal to the metadata of the check before
+        bool stable = false;
+
+        bool operator==(const FileStat& other) const;
+        bool operator!=(const FileStat& other) const;
+    };
+
+    struct Checksum
+    {
+        QByteArray digest;
+        FileStat stat;
+        qint64 bytesRead = 0;
+        bool skipped = false;
+    };
+
+    static FileStat statFile(const QString& path);
+    static Checksum
+    calculateChecksum(const QString& path, int sizeBytes, const QByteArray& lastChecksum, const FileStat& lastStat);
+    void updateChecksum(const Checksum& checksum);
     bool shouldIgnoreChanges();
 
     QString m_filePath;
     QFileSystemWatcher m_fileWatcher;
     QByteArray m_fileChecksum;
+    FileStat m_fileStat;
+    qint64 m_lastCheckBytesRead = 0;
+    qint64 m_totalBytesRead = 0;
+    int m_skippedChecksums = 0;
     QTimer m_fileChangeDelayTimer;
     QTimer m_fileIgnoreDelayTimer;
     QTimer m_fileChecksumTimer;
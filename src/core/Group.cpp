@@ -61,6 +61,8 @@ Group::~Group()
     for (Entry* entry : entries) {
         delete entry;
     }
+    // Close a pending bulk update while listeners can still access this group
+    endEntriesChange();
 
     const QList<Group*> children = m_children;
     for (Group* group : children) {
@@ -989,6 +991,7 @@ void Group::addEntry(Entry* entry)
     Q_ASSERT(entry);
     Q_ASSERT(!m_entries.contains(entry));
 
+    const bool bulkUpdate = beginEntriesChange();
     emit entryAboutToAdd(entry);
 
     m_entries << entry;
@@ -997,7 +1000,9 @@ void Group::addEntry(Entry* entry)
         connect(entry, &Entry::modified, m_db, &Database::markAsModified);
     }
 
-    emitModified();
+    if (!bulkUpdate) {
+        emitModified();
+    }
     emit entryAdded(entry);
 }
 
@@ -1007,17 +1012,53 @@ void Group::removeEntry(Entry* entry)
                Q_FUNC_INFO,
                QString("Group %1 does not contain %2").arg(this->name(), entry->title()).toLatin1());
 
+    const bool bulkUpdate = beginEntriesChange();
     emit entryAboutToRemove(entry);
 
     entry->disconnect(this);
     if (m_db) {
         entry->disconnect(m_db);
     }
-    m_entries.removeAll(entry);
-    emitModified();
+    // Entries are unique within a group, no need to scan the whole list
+    m_entries.removeOne(entry);
+    if (!bulkUpdate) {
+        emitModified();
+    }
     emit entryRemoved(entry);
 }
 
+/**
+ * Announce a change of the entry list if the database is in a bulk update.
+ * The first call emits entriesAboutToChange(), endEntriesChange() emits the
+ * matching entriesChanged() once the bulk update is finished.
+ *
+ * @return true if the change is part of a bulk update
+ */
+bool Group::beginEntriesChange()
+{
+    if (!m_db || !m_db->isBulkUpdating()) {
+        return false;
+    }
+
+    if (!m_entriesChanging) {
+        m_entriesChanging = true;
+        m_db->m_bulkUpdateGroups.append(this);
+        emit entriesAboutToChange();
+    }
+    return true;
+}
+
+void Group::endEntriesChange()
+{
+    if (!m_entriesChanging) {
+        return;
+    }
+
+    m_entriesChanging = false;
+    emitModified();
+    emit entriesChanged();
+}
+
 void Group::moveEntryUp(Entry* entry)
 {
     int row = m_entries.indexOf(entry);
@@ -1223,14 +1264,23 @@ void Group::sortChildrenRecursively(bool reverse)
     if (database()) {
         recycleBin = database()->metadata()->recycleBin();
     }
-    std::sort(m_children.begin(), m_children.end(), [=](const Group* childGroup1, const Group* childGroup2) -> bool {
-        if (childGroup1 == recycleBin) {
-            return false;
+
+    // Fold the names once instead of during every comparison, the recycle bin is always sorted last
+    using SortKey = QPair<QString, Group*>;
+    QVector<SortKey> keys;
+    keys.reserve(m_children.size());
+    for (auto child : asConst(m_children)) {
+        keys.append({child->name().toCaseFolded(), child});
+    }
+    std::sort(keys.begin(), keys.end(), [=](const SortKey& left, const SortKey& right) {
+        if (left.second == recycleBin || right.second == recycleBin) {
+            return right.second == recycleBin && left.second != recycleBin;
         }
-        QString name1 = childGroup1->name();
-        QString name2 = childGroup2->name();
-        return reverse ? name1.compare(name2, Qt::CaseInsensitive) > 0 : name1.compare(name2, Qt::CaseInsensitive) < 0;
+        return reverse ? right.first < left.first : left.first < right.first;
     });
+    for (int i = 0; i < keys.size(); ++i) {
+        m_children[i] = keys.at(i).second;
+    }
 
     for (auto child : m_children) {
         child->sortChildrenRecursively(reverse);
@@ -199,6 +199,8 @@ signals:
     void entryAboutToMoveDown(int row);
     void entryMovedDown();
     void entryDataChanged(Entry* entry);
+    void entriesAboutToChange();
+    void entriesChanged();
 
 private slots:
     void updateTimeinfo();
@@ -209,6 +211,8 @@ private:
     void setParent(Database* db);
 
     void connectDatabaseSignalsRecursive(Database* db);
+    bool beginEntriesChange();
+    void endEntriesChange();
     void cleanupParent();
     void recCreateDelObjects();
 
@@ -227,8 +231,10 @@ private:
     QPointer<Group> m_parent;
 
     bool m_updateTimeinfo;
+    bool m_entriesChanging = false;
 
     friend Group* Database::setRootGroup(Group* group);
+    friend void Database::endBulkUpdate();
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(Group::CloneFlags)
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LatencyStats.h"
+
+#include <QObject>
+
+#include <algorithm>
+
+LatencyStats::LatencyStats(int capacity)
+    : m_capacity(qMax(1, capacity))
+{
+    m_samples.reserve(m_capacity);
+}
+
+void LatencyStats::record(qint64 msecs)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_samples.size() < m_capacity) {
+        m_samples.append(msecs);
+    } else {
+        m_samples[m_next] = msecs;
+    }
+    m_next = (m_next + 1) % m_capacity;
+}
+
+void LatencyStats::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_samples.clear();
+    m_next = 0;
+}
+
+int LatencyStats::count() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_samples.size();
+}
+
+QVector<qint64> LatencyStats::sortedSamples() const
+{
+    QMutexLocker locker(&m_mutex);
+    auto samples = m_samples;
+    locker.unlock();
+
+    std::sort(samples.begin(), samples.end());
+    return samples;
+}
+
+/**
+ * Nearest-rank percentile of the recorded samples.
+ *
+ * @param percent percentile between 0 and 100
+ * @return duration in milliseconds, 0 if nothing was recorded
+ */
+qint64 LatencyStats::percentile(int percent) const
+{
+    const auto samples = sortedSamples();
+    if (samples.isEmpty()) {
+        return 0;
+    }
+
+    const int rank = (qBound(0, percent, 100) * samples.size() + 99) / 100;
+    return samples.at(qBound(0, rank - 1, samples.size() - 1));
+}
+
+qint64 LatencyStats::maximum() const
+{
+    return percentile(100);
+}
+
+QString LatencyStats::summary() const
+{
+    const int samples = count();
+    if (samples == 0) {
+        return QObject::tr("No samples");
+    }
+
+    return QObject::tr("%1 sample(s), median %2 ms, 95th percentile %3 ms, maximum %4 ms", nullptr, samples)
+        .arg(samples)
+        .arg(percentile(50))
+        .arg(percentile(95))
+        .arg(maximum());
+}
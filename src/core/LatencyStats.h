@@ -0,0 +1,53 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEEPASSXC_LATENCYSTATS_H
+#define KEEPASSXC_LATENCYSTATS_H
+
+#include <QMutex>
+#include <QVector>
+
+/**
+ * Thread-safe record of the most recent durations of an operation.
+ *
+ * Only the last samples are kept so that the percentiles reflect the
+ * current behavior of the application rather than its whole lifetime.
+ */
+class LatencyStats
+{
+public:
+    explicit LatencyStats(int capacity = 128);
+
+    void record(qint64 msecs);
+    void clear();
+
+    int count() const;
+    qint64 percentile(int percent) const;
+    qint64 maximum() const;
+    QString summary() const;
+
+private:
+    QVector<qint64> sortedSamples() const;
+
+    mutable QMutex m_mutex;
+    // Ring buffer of the most recent samples
+    QVector<qint64> m_samples;
+    int m_capacity;
+    int m_next = 0;
+};
+
+#endif // KEEPASSXC_LATENCYSTATS_H
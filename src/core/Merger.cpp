@@ -20,6 +20,7 @@
 #include "core/Global.h"
 #include "core/Metadata.h"
 #include "core/Tools.h"
+#include "core/Trace.h"
 
 Merger::Merger(const Database* sourceDb, Database* targetDb)
     : m_mode(Group::Default)
@@ -66,6 +67,8 @@ void Merger::setSkipDatabaseCustomData(bool state)
 
 QStringList Merger::merge()
 {
+    TRACE_SPAN("Merger::merge");
+
     // Order of merge steps is important - it is possible that we
     // create some items before deleting them afterwards
     ChangeList changes;
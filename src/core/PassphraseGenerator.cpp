@@ -17,9 +17,14 @@
 
 #include "PassphraseGenerator.h"
 
+#include <QDateTime>
 #include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
 #include <QSet>
 #include <QTextStream>
+#include <QVector>
 #include <cmath>
 
 #include "core/Resources.h"
@@ -29,6 +34,29 @@ const int PassphraseGenerator::DefaultWordCount = 7;
 const char* PassphraseGenerator::DefaultSeparator = " ";
 const char* PassphraseGenerator::DefaultWordList = "eff_large.wordlist";
 
+/**
+ * Wordlist compiled into a single UTF-8 blob plus an offset table.
+ * Word i spans [offsets[i], offsets[i + 1]) in the blob.
+ */
+struct PassphraseGenerator::WordList
+{
+    QByteArray blob;
+    QVector<int> offsets;
+    QDateTime lastModified;
+    qint64 fileSize = -1;
+
+    int size() const
+    {
+        return offsets.isEmpty() ? 0 : offsets.size() - 1;
+    }
+
+    QString word(int index) const
+    {
+        const int offset = offsets.at(index);
+        return QString::fromUtf8(blob.constData() + offset, offsets.at(index + 1) - offset);
+    }
+};
+
 PassphraseGenerator::PassphraseGenerator()
     : m_wordCount(DefaultWordCount)
     , m_wordCase(LOWERCASE)
@@ -39,14 +67,14 @@ PassphraseGenerator::PassphraseGenerator()
 
 double PassphraseGenerator::estimateEntropy(int wordCount)
 {
-    if (m_wordlist.isEmpty()) {
+    if (!m_wordlist || m_wordlist->size() == 0) {
         return 0.0;
     }
     if (wordCount < 1) {
         wordCount = m_wordCount;
     }
 
-    return std::log2(m_wordlist.size()) * wordCount;
+    return std::log2(m_wordlist->size()) * wordCount;
 }
 
 void PassphraseGenerator::setWordCount(int wordCount)
@@ -61,16 +89,51 @@ void PassphraseGenerator::setWordCase(PassphraseWordCase wordCase)
 
 void PassphraseGenerator::setWordList(const QString& path)
 {
-    m_wordlist.clear();
-    // Initially load wordlist into a set to avoid duplicates
-    QSet<QString> wordset;
+    m_wordlist = loadWordList(path);
+
+    if (!m_wordlist) {
+        qWarning("Couldn't load passphrase wordlist: %s", qPrintable(path));
+    } else if (m_wordlist->size() < m_minimum_wordlist_length) {
+        qWarning("Wordlist is less than minimum acceptable size: %s", qPrintable(path));
+    }
+}
+
+/**
+ * Load and compile the wordlist at the given path. The result is cached for
+ * the lifetime of the process and only reparsed if the file changes on disk.
+ *
+ * @param path wordlist file
+ * @return compiled wordlist or null if the file could not be read
+ */
+QSharedPointer<const PassphraseGenerator::WordList> PassphraseGenerator::loadWordList(const QString& path)
+{
+    const QFileInfo info(path);
+    const QString key = info.absoluteFilePath();
+
+    static QMutex s_wordListCacheMutex;
+    static QHash<QString, QSharedPointer<const WordList>> s_wordListCache;
+
+    QMutexLocker locker(&s_wordListCacheMutex);
+    auto cached = s_wordListCache.value(key);
+    if (cached && cached->lastModified == info.lastModified() && cached->fileSize == info.size()) {
+        return cached;
+    }
 
     QFile file(path);
     if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning("Couldn't load passphrase wordlist: %s", qPrintable(path));
-        return;
+        s_wordListCache.remove(key);
+        return {};
     }
 
+    QSharedPointer<WordList> wordlist(new WordList());
+    wordlist->lastModified = info.lastModified();
+    wordlist->fileSize = info.size();
+    wordlist->blob.reserve(static_cast<int>(info.size()));
+    wordlist->offsets.append(0);
+
+    // Use a set to avoid duplicates while keeping the file order in the blob
+    QSet<QString> wordset;
+
     QTextStream in(&file);
     in.setCodec("UTF-8");
     QString line = in.readLine();
@@ -91,17 +154,19 @@ void PassphraseGenerator::setWordList(const QString& path)
         }
         line = line.trimmed();
         line.replace(rx, "\\2");
-        if (!line.isEmpty()) {
+        if (!line.isEmpty() && !wordset.contains(line)) {
             wordset.insert(line);
+            wordlist->blob.append(line.toUtf8());
+            wordlist->offsets.append(wordlist->blob.size());
         }
         line = in.readLine();
     }
 
-    m_wordlist = wordset.toList();
+    wordlist->blob.squeeze();
+    wordlist->offsets.squeeze();
 
-    if (m_wordlist.size() < m_minimum_wordlist_length) {
-        qWarning("Wordlist is less than minimum acceptable size: %s", qPrintable(path));
-    }
+    s_wordListCache.insert(key, wordlist);
+    return wordlist;
 }
 
 void PassphraseGenerator::setDefaultWordList()
@@ -118,38 +183,47 @@ void PassphraseGenerator::setWordSeparator(const QString& separator)
 QString PassphraseGenerator::generatePassphrase() const
 {
     // In case there was an error loading the wordlist
-    if (!isValid() || m_wordlist.empty()) {
+    if (!isValid() || m_wordlist->size() == 0) {
         return {};
     }
 
-    QStringList words;
-    int randomIndex = randomGen()->randomUInt(static_cast<quint32>(m_wordCount));
+    const auto random = randomGen();
+    const int wordlistSize = m_wordlist->size();
+    int randomIndex = random->randomUInt(static_cast<quint32>(m_wordCount));
+
+    QString passphrase;
+    passphrase.reserve(m_wordCount * (m_separator.size() + 10));
+    QString word;
     for (int i = 0; i < m_wordCount; ++i) {
-        int wordIndex = randomGen()->randomUInt(static_cast<quint32>(m_wordlist.size()));
-        auto tmpWord = m_wordlist.at(wordIndex);
+        int wordIndex = random->randomUInt(static_cast<quint32>(wordlistSize));
+        word = m_wordlist->word(wordIndex);
 
-        // convert case
+        // convert case, the rvalue overloads reuse the decoded buffer
         switch (m_wordCase) {
         case UPPERCASE:
-            tmpWord = tmpWord.toUpper();
+            word = std::move(word).toUpper();
             break;
         case TITLECASE:
-            tmpWord = tmpWord.replace(0, 1, tmpWord.left(1).toUpper());
+            word.replace(0, 1, word.left(1).toUpper());
             break;
         case MIXEDCASE:
-            tmpWord = i == randomIndex ? tmpWord.toUpper() : tmpWord.toLower();
+            word = i == randomIndex ? std::move(word).toUpper() : std::move(word).toLower();
             break;
         case LOWERCASE:
-            tmpWord = tmpWord.toLower();
+            word = std::move(word).toLower();
             break;
         }
-        words.append(tmpWord);
+
+        if (i > 0) {
+            passphrase.append(m_separator);
+        }
+        passphrase.append(word);
     }
 
-    return words.join(m_separator);
+    return passphrase;
 }
 
 bool PassphraseGenerator::isValid() const
 {
-    return m_wordCount > 0 && m_wordlist.size() >= m_minimum_wordlist_length;
+    return m_wordCount > 0 && m_wordlist && m_wordlist->size() >= m_minimum_wordlist_length;
 }
@@ -18,7 +18,8 @@
 #ifndef KEEPASSX_PASSPHRASEGENERATOR_H
 #define KEEPASSX_PASSPHRASEGENERATOR_H
 
-#include <QList>
+#include <QSharedPointer>
+#include <QString>
 
 class PassphraseGenerator
 {
@@ -53,7 +54,12 @@ private:
     int m_minimum_wordlist_length = 4000;
     PassphraseWordCase m_wordCase;
     QString m_separator;
-    QList<QString> m_wordlist;
+
+    // Compiled wordlist shared between all generators using the same file
+    struct WordList;
+    QSharedPointer<const WordList> m_wordlist;
+
+    static QSharedPointer<const WordList> loadWordList(const QString& path);
 
     friend class TestPassphraseGenerator;
 };
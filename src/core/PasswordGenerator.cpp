@@ -18,6 +18,7 @@
 
 #include "PasswordGenerator.h"
 
+#include "core/Global.h"
 #include "crypto/Random.h"
 
 const int PasswordGenerator::DefaultLength = 32;
@@ -30,6 +31,7 @@ PasswordGenerator::PasswordGenerator()
     , m_flags(PasswordGenerator::GeneratorFlag::DefaultFlags)
     , m_custom(PasswordGenerator::DefaultCustomCharacterSet)
     , m_excluded(PasswordGenerator::DefaultExcludedChars)
+    , m_tablesValid(false)
 {
 }
 
@@ -41,53 +43,52 @@ void PasswordGenerator::setLength(int length)
 void PasswordGenerator::setCharClasses(const PasswordGenerator::CharClasses& classes)
 {
     m_classes = classes;
+    m_tablesValid = false;
 }
 
 void PasswordGenerator::setCustomCharacterSet(const QString& customCharacterSet)
 {
     m_custom = customCharacterSet;
+    m_tablesValid = false;
 }
 void PasswordGenerator::setExcludedCharacterSet(const QString& excludedCharacterSet)
 {
     m_excluded = excludedCharacterSet;
+    m_tablesValid = false;
 }
 
 void PasswordGenerator::setFlags(const GeneratorFlags& flags)
 {
     m_flags = flags;
+    m_tablesValid = false;
 }
 
 QString PasswordGenerator::generatePassword() const
 {
     Q_ASSERT(isValid());
 
-    const QVector<PasswordGroup> groups = passwordGroups();
-
-    QVector<QChar> passwordChars;
-    for (const PasswordGroup& group : groups) {
-        for (QChar ch : group) {
-            passwordChars.append(ch);
-        }
-    }
+    updateCharacterTables();
+    const auto random = randomGen();
 
     QString password;
+    password.reserve(m_length);
 
     if (m_flags & CharFromEveryGroup) {
-        for (const auto& group : groups) {
-            int pos = randomGen()->randomUInt(static_cast<quint32>(group.size()));
+        for (const auto& group : asConst(m_groups)) {
+            int pos = random->randomUInt(static_cast<quint32>(group.size()));
 
             password.append(group[pos]);
         }
 
-        for (int i = groups.size(); i < m_length; i++) {
-            int pos = randomGen()->randomUInt(static_cast<quint32>(passwordChars.size()));
+        for (int i = m_groups.size(); i < m_length; i++) {
+            int pos = random->randomUInt(static_cast<quint32>(m_chars.size()));
 
-            password.append(passwordChars[pos]);
+            password.append(m_chars[pos]);
         }
 
         // shuffle chars
         for (int i = (password.size() - 1); i >= 1; i--) {
-            int j = randomGen()->randomUInt(static_cast<quint32>(i + 1));
+            int j = random->randomUInt(static_cast<quint32>(i + 1));
 
             QChar tmp = password[i];
             password[i] = password[j];
@@ -95,15 +96,25 @@ QString PasswordGenerator::generatePassword() const
         }
     } else {
         for (int i = 0; i < m_length; i++) {
-            int pos = randomGen()->randomUInt(static_cast<quint32>(passwordChars.size()));
+            int pos = random->randomUInt(static_cast<quint32>(m_chars.size()));
 
-            password.append(passwordChars[pos]);
+            password.append(m_chars[pos]);
         }
     }
 
     return password;
 }
 
+QStringList PasswordGenerator::generatePasswords(int count) const
+{
+    QStringList passwords;
+    passwords.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        passwords.append(generatePassword());
+    }
+    return passwords;
+}
+
 bool PasswordGenerator::isValid() const
 {
     if (m_classes == CharClass::NoClass && m_custom.isEmpty()) {
@@ -116,7 +127,22 @@ bool PasswordGenerator::isValid() const
         return false;
     }
 
-    return !passwordGroups().isEmpty();
+    updateCharacterTables();
+    return !m_groups.isEmpty();
+}
+
+void PasswordGenerator::updateCharacterTables() const
+{
+    if (m_tablesValid) {
+        return;
+    }
+
+    m_groups = passwordGroups();
+    m_chars.clear();
+    for (const PasswordGroup& group : asConst(m_groups)) {
+        m_chars.append(group);
+    }
+    m_tablesValid = true;
 }
 
 QVector<PasswordGroup> PasswordGenerator::passwordGroups() const
@@ -297,8 +323,8 @@ QVector<PasswordGroup> PasswordGenerator::passwordGroups() const
 int PasswordGenerator::numCharClasses() const
 {
     // Actually compute the non empty password groups
-    auto non_empty_groups = passwordGroups();
-    return non_empty_groups.size();
+    updateCharacterTables();
+    return m_groups.size();
 }
 
 int PasswordGenerator::getMinLength() const
@@ -315,6 +341,7 @@ void PasswordGenerator::reset()
     m_custom = DefaultCustomCharacterSet;
     m_excluded = DefaultExcludedChars;
     m_length = DefaultLength;
+    m_tablesValid = false;
 }
 int PasswordGenerator::getLength() const
 {
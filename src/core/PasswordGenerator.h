@@ -20,6 +20,7 @@
 #define KEEPASSX_PASSWORDGENERATOR_H
 
 #include <QObject>
+#include <QStringList>
 #include <QVector>
 
 typedef QVector<QChar> PasswordGroup;
@@ -75,6 +76,7 @@ public:
     const QString& getExcludedCharacterSet() const;
 
     QString generatePassword() const;
+    QStringList generatePasswords(int count) const;
 
     static const int DefaultLength;
     static const char* DefaultCustomCharacterSet;
@@ -82,6 +84,7 @@ public:
 
 private:
     QVector<PasswordGroup> passwordGroups() const;
+    void updateCharacterTables() const;
     int numCharClasses() const;
 
     int m_length;
@@ -89,6 +92,11 @@ private:
     GeneratorFlags m_flags;
     QString m_custom;
     QString m_excluded;
+
+    // Character tables derived from the settings above, rebuilt lazily after a change
+    mutable bool m_tablesValid;
+    mutable QVector<PasswordGroup> m_groups;
+    mutable PasswordGroup m_chars;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(PasswordGenerator::CharClasses)
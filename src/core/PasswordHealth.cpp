@@ -15,16 +15,71 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <QReadWriteLock>
 #include <QString>
+#include <QtConcurrent>
 
 #include "Clock.h"
 #include "Group.h"
 #include "PasswordHealth.h"
+#include "PasswordHealthIndex.h"
+#include "crypto/CryptoHash.h"
+#include "crypto/Random.h"
 #include "zxcvbn.h"
 
 namespace
 {
     const static int ZXCVBN_ESTIMATE_THRESHOLD = 256;
+    const static int ENTROPY_CACHE_LIMIT = 100000;
+
+    /*
+     * Process-wide memo of zxcvbn results. Passwords are only stored
+     * as an HMAC under a random per-process key, never in plain text.
+     */
+    class EntropyCache
+    {
+    public:
+        EntropyCache()
+            : m_key(randomGen()->randomArray(32))
+        {
+        }
+
+        QByteArray key(const QString& pwd) const
+        {
+            return CryptoHash::hmac(pwd.toUtf8(), m_key, CryptoHash::Sha256);
+        }
+
+        bool lookup(const QByteArray& key, double& entropy) const
+        {
+            QReadLocker locker(&m_lock);
+            auto it = m_entropy.constFind(key);
+            if (it == m_entropy.constEnd()) {
+                return false;
+            }
+            entropy = it.value();
+            return true;
+        }
+
+        void insert(const QByteArray& key, double entropy)
+        {
+            QWriteLocker locker(&m_lock);
+            if (m_entropy.size() >= ENTROPY_CACHE_LIMIT) {
+                m_entropy.clear();
+            }
+            m_entropy.insert(key, entropy);
+        }
+
+    private:
+        const QByteArray m_key;
+        mutable QReadWriteLock m_lock;
+        QHash<QByteArray, double> m_entropy;
+    };
+
+    EntropyCache& entropyCache()
+    {
+        static EntropyCache cache;
+        return cache;
+    }
 } // namespace
 
 PasswordHealth::PasswordHealth(double entropy)
@@ -34,14 +89,37 @@ PasswordHealth::PasswordHealth(double entropy)
 
 PasswordHealth::PasswordHealth(const QString& pwd)
 {
+    init(estimateEntropy(pwd));
+}
+
+/**
+ * Estimate the entropy of a password using zxcvbn.
+ *
+ * Results are memoized for the lifetime of the process, so passwords
+ * that are re-used across entries are only scored once.
+ */
+double PasswordHealth::estimateEntropy(const QString& pwd)
+{
+    if (pwd.isEmpty()) {
+        return 0.0;
+    }
+
+    auto& cache = entropyCache();
+    const auto key = cache.key(pwd);
     auto entropy = 0.0;
+    if (cache.lookup(key, entropy)) {
+        return entropy;
+    }
+
     entropy += ZxcvbnMatch(pwd.left(ZXCVBN_ESTIMATE_THRESHOLD).toUtf8(), nullptr, nullptr);
     if (pwd.length() > ZXCVBN_ESTIMATE_THRESHOLD) {
         // Add the average entropy per character for any characters above the estimate threshold
         auto average = entropy / ZXCVBN_ESTIMATE_THRESHOLD;
         entropy += average * (pwd.length() - ZXCVBN_ESTIMATE_THRESHOLD);
     }
-    init(entropy);
+
+    cache.insert(key, entropy);
+    return entropy;
 }
 
 void PasswordHealth::init(double entropy)
@@ -113,16 +191,17 @@ PasswordHealth::Quality PasswordHealth::quality() const
 /**
  * This class provides additional information about password health
  * than can be derived from the password itself (re-use, expiry).
+ * Must be created on the thread that owns the database, see Database::healthIndex().
  */
 HealthChecker::HealthChecker(QSharedPointer<Database> db)
+    : m_db(db)
+    , m_index(db->healthIndex())
+{
+}
+
+HealthChecker::HealthChecker(QSharedPointer<const DatabaseSnapshot> snapshot)
+    : m_snapshot(std::move(snapshot))
 {
-    // Build the cache of re-used passwords
-    for (const auto* entry : db->rootGroup()->entriesRecursive()) {
-        if (!entry->isRecycled() && !entry->isAttributeReference("Password")) {
-            m_reuse[entry->password()]
-                << QObject::tr("Used in %1/%2").arg(entry->group()->hierarchy().join('/'), entry->title());
-        }
-    }
 }
 
 /**
@@ -138,21 +217,56 @@ QSharedPointer<PasswordHealth> HealthChecker::evaluate(const Entry* entry) const
         return {};
     }
 
-    // First analyse the password itself
+    Q_ASSERT(m_index);
     const auto pwd = entry->password();
+    const auto used = m_index->entriesUsingPassword(pwd);
+    return evaluatePassword(
+        pwd,
+        used.size(),
+        [&used](int i) { return qMakePair(used[i]->group()->hierarchy().join('/'), used[i]->title()); },
+        entry->timeInfo(),
+        entry->isExpired());
+}
+
+/**
+ * Returns the health of a snapshot entry, re-use is determined
+ * from the snapshot the checker was created with.
+ */
+QSharedPointer<PasswordHealth> HealthChecker::evaluate(const DatabaseSnapshot::Entry& entry) const
+{
+    Q_ASSERT(m_snapshot);
+    const auto used = m_snapshot->entriesUsingPassword(entry.password);
+    const auto& entries = m_snapshot->entries();
+    return evaluatePassword(
+        entry.password,
+        used.size(),
+        [this, &used, &entries](int i) {
+            const auto& user = entries.at(used.at(i));
+            return qMakePair(m_snapshot->hierarchy(user.group).join('/'), user.title);
+        },
+        entry.timeInfo,
+        entry.isExpired());
+}
+
+QSharedPointer<PasswordHealth> HealthChecker::evaluatePassword(const QString& pwd,
+                                                               int count,
+                                                               const UsedIn& usedIn,
+                                                               const TimeInfo& timeInfo,
+                                                               bool expired) const
+{
+    // First analyse the password itself
     auto health = QSharedPointer<PasswordHealth>(new PasswordHealth(pwd));
 
     // Second, if the password is in the database more than once,
     // reduce the score accordingly
-    const auto& used = m_reuse[pwd];
-    const auto count = used.size();
     if (count > 1) {
         constexpr auto penalty = 15;
         health->adjustScore(-penalty * (count - 1));
         health->addScoreReason(QObject::tr("Password is used %1 time(s)", "", count).arg(QString::number(count)));
         // Add the first 20 uses of the password to prevent the details display from growing too large
-        for (int i = 0; i < used.size(); ++i) {
-            health->addScoreDetails(used[i]);
+        for (int i = 0; i < count; ++i) {
+            const auto use = usedIn(i);
+            health->addScoreDetails(QObject::tr("Used in %1/%2").arg(use.first, use.second));
             if (i == 19) {
                 health->addScoreDetails("…");
                 break;
@@ -169,13 +283,12 @@ QSharedPointer<PasswordHealth> HealthChecker::evaluate(const Entry* entry) const
     // Third, if the password has already expired, reduce score to 0;
     // or, if the password is going to expire in the next 30 days,
     // reduce score by 2 points per day.
-    if (entry->isExpired()) {
+    if (expired) {
         health->setScore(0);
         health->addScoreReason(QObject::tr("Password has expired"));
-        health->addScoreDetails(
-            QObject::tr("Password expiry was %1").arg(Clock::toString(entry->timeInfo().expiryTime())));
-    } else if (entry->timeInfo().expires()) {
-        const int days = QDateTime::currentDateTime().daysTo(entry->timeInfo().expiryTime());
+        health->addScoreDetails(QObject::tr("Password expiry was %1").arg(Clock::toString(timeInfo.expiryTime())));
+    } else if (timeInfo.expires()) {
+        const int days = QDateTime::currentDateTime().daysTo(timeInfo.expiryTime());
         if (days <= 30) {
             // First bring the score down into the "weak" range
             // so that the entry appears in Health Check. Then
@@ -188,7 +301,7 @@ QSharedPointer<PasswordHealth> HealthChecker::evaluate(const Entry* entry) const
 
             health->adjustScore((30 - days) * -2);
             health->addScoreDetails(
-                QObject::tr("Password expires on %1").arg(Clock::toString(entry->timeInfo().expiryTime())));
+                QObject::tr("Password expires on %1").arg(Clock::toString(timeInfo.expiryTime())));
             if (days <= 2) {
                 health->addScoreReason(QObject::tr("Password is about to expire"));
             } else if (days <= 10) {
@@ -202,3 +315,15 @@ QSharedPointer<PasswordHealth> HealthChecker::evaluate(const Entry* entry) const
     // Return the result
     return health;
 }
+
+/**
+ * Evaluate a list of entries concurrently.
+ *
+ * The result list is in the same order as `entries`. Entries must not
+ * be modified while the evaluation is running.
+ */
+QList<QSharedPointer<PasswordHealth>> HealthChecker::evaluate(const QList<Entry*>& entries) const
+{
+    return QtConcurrent::blockingMapped<QList<QSharedPointer<PasswordHealth>>>(
+        entries, [this](const Entry* entry) { return evaluate(entry); });
+}
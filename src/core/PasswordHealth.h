@@ -21,8 +21,13 @@
 #include <QHash>
 #include <QSharedPointer>
 
+#include <functional>
+
+#include "core/DatabaseSnapshot.h"
+
 class Database;
 class Entry;
+class PasswordHealthIndex;
 
 /**
  * Health status of a single password.
@@ -37,6 +42,8 @@ public:
 
     void init(double entropy);
 
+    static double estimateEntropy(const QString& pwd);
+
     /*
      * The password score is defined to be the greater the better
      * (more secure) the password is. It doesn't have a dimension,
@@ -100,19 +107,34 @@ private:
 /**
  * Password health check for all entries of a database.
  *
+ * A checker created from a snapshot evaluates snapshot entries and
+ * can be used from any thread.
+ *
  * @see PasswordHealth
  */
 class HealthChecker
 {
 public:
     explicit HealthChecker(QSharedPointer<Database>);
+    explicit HealthChecker(QSharedPointer<const DatabaseSnapshot> snapshot);
 
     // Get the health status of an entry in the database
     QSharedPointer<PasswordHealth> evaluate(const Entry* entry) const;
+    QSharedPointer<PasswordHealth> evaluate(const DatabaseSnapshot::Entry& entry) const;
+    // Evaluate many entries at once, spread over the global thread pool
+    QList<QSharedPointer<PasswordHealth>> evaluate(const QList<Entry*>& entries) const;
 
 private:
-    // To determine password re-use: first = password, second = entries that use it
-    QHash<QString, QStringList> m_reuse;
+    // Group path and title of the i-th entry using a password
+    using UsedIn = std::function<QPair<QString, QString>(int)>;
+
+    QSharedPointer<PasswordHealth>
+    evaluatePassword(const QString& pwd, int count, const UsedIn& usedIn, const TimeInfo& timeInfo, bool expired) const;
+
+    QSharedPointer<Database> m_db;
+    QSharedPointer<const DatabaseSnapshot> m_snapshot;
+    // To determine password re-use
+    const PasswordHealthIndex* m_index = nullptr;
 };
 
 #endif // KEEPASSX_PASSWORDHEALTH_H
@@ -0,0 +1,272 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PasswordHealthIndex.h"
+
+#include "core/Database.h"
+#include "core/Group.h"
+#include "core/PasswordHealth.h"
+#include "crypto/CryptoHash.h"
+#include "crypto/Random.h"
+
+#include <QtConcurrent>
+
+PasswordHealthIndex::PasswordHealthIndex(Database* db)
+    : m_key(randomGen()->randomArray(32))
+{
+    QList<const Entry*> entries;
+    for (auto group : db->rootGroup()->groupsRecursive(true)) {
+        trackGroup(group);
+        for (auto entry : group->entries()) {
+            connect(entry, &Entry::modified, this, [this, entry] { updateEntry(entry); });
+            entries << entry;
+        }
+    }
+
+    // Initial password evaluation is spread over the global thread pool
+    const auto records = QtConcurrent::blockingMapped<QList<Record>>(
+        entries, [this](const Entry* entry) { return makeRecord(entry); });
+    for (int i = 0; i < entries.size(); ++i) {
+        insertRecord(entries[i], records[i]);
+    }
+
+    // Groups entering or leaving the database carry their entries with them
+    connect(db, &Database::groupAboutToAdd, this, [this](Group* group) {
+        for (auto child : group->groupsRecursive(true)) {
+            trackGroup(child);
+            for (auto entry : child->entries()) {
+                addEntry(entry);
+            }
+        }
+    });
+    connect(db, &Database::groupAboutToRemove, this, &PasswordHealthIndex::untrackGroup);
+}
+
+PasswordHealthIndex::~PasswordHealthIndex() = default;
+
+/**
+ * Entries that share the given password, excluding recycled entries
+ * and entries whose password is a reference to another entry.
+ */
+QList<const Entry*> PasswordHealthIndex::entriesUsingPassword(const QString& password) const
+{
+    if (password.isEmpty()) {
+        return {};
+    }
+
+    QList<const Entry*> result;
+    for (auto entry : m_reuse.value(digest(password))) {
+        if (!entry->isRecycled()) {
+            result << entry;
+        }
+    }
+    return result;
+}
+
+int PasswordHealthIndex::maxPasswordReuse() const
+{
+    int max = 0;
+    for (const auto& entries : m_reuse) {
+        if (entries.size() <= max) {
+            continue;
+        }
+        int count = 0;
+        for (auto entry : entries) {
+            if (!entry->isRecycled()) {
+                ++count;
+            }
+        }
+        max = qMax(max, count);
+    }
+    return max;
+}
+
+/**
+ * Entries whose password is used by at least one other entry.
+ */
+QList<const Entry*> PasswordHealthIndex::reusedEntries() const
+{
+    QList<const Entry*> result;
+    for (const auto& entries : m_reuse) {
+        if (entries.size() < 2) {
+            continue;
+        }
+        QList<const Entry*> active;
+        for (auto entry : entries) {
+            if (!entry->isRecycled()) {
+                active << entry;
+            }
+        }
+        if (active.size() > 1) {
+            result << active;
+        }
+    }
+    return result;
+}
+
+/**
+ * Entries whose password on its own is weak or worse, without
+ * taking re-use or expiry into account.
+ */
+QList<const Entry*> PasswordHealthIndex::weakEntries() const
+{
+    QList<const Entry*> result;
+    for (auto entry : m_weak) {
+        if (!entry->isRecycled()) {
+            result << entry;
+        }
+    }
+    return result;
+}
+
+/**
+ * Entries that expire before the given time, sorted by expiry time.
+ * Use the current time to get all expired entries.
+ */
+QList<const Entry*> PasswordHealthIndex::expiringEntries(const QDateTime& before) const
+{
+    QList<const Entry*> result;
+    for (auto it = m_expiry.constBegin(); it != m_expiry.constEnd() && it.key() < before; ++it) {
+        if (!it.value()->isRecycled()) {
+            result << it.value();
+        }
+    }
+    return result;
+}
+
+void PasswordHealthIndex::trackGroup(Group* group)
+{
+    connect(group, &Group::entryAdded, this, &PasswordHealthIndex::addEntry, Qt::UniqueConnection);
+    connect(group, &Group::entryAboutToRemove, this, &PasswordHealthIndex::removeEntry, Qt::UniqueConnection);
+}
+
+void PasswordHealthIndex::untrackGroup(Group* group)
+{
+    for (auto child : group->groupsRecursive(true)) {
+        child->disconnect(this);
+        for (auto entry : child->entries()) {
+            removeEntry(entry);
+        }
+    }
+}
+
+void PasswordHealthIndex::addEntry(Entry* entry)
+{
+    if (m_records.contains(entry)) {
+        return;
+    }
+    connect(entry, &Entry::modified, this, [this, entry] { updateEntry(entry); });
+    insertRecord(entry, makeRecord(entry));
+}
+
+void PasswordHealthIndex::removeEntry(Entry* entry)
+{
+    entry->disconnect(this);
+    removeRecord(entry);
+}
+
+void PasswordHealthIndex::updateEntry(Entry* entry)
+{
+    auto it = m_records.constFind(entry);
+    if (it == m_records.constEnd()) {
+        return;
+    }
+
+    auto record = makeRecord(entry, &it.value());
+    removeRecord(entry);
+    insertRecord(entry, record);
+}
+
+void PasswordHealthIndex::insertRecord(const Entry* entry, const Record& record)
+{
+    m_records.insert(entry, record);
+    if (!record.digest.isEmpty() && !record.reference) {
+        m_reuse[record.digest] << entry;
+    }
+    if (record.weak) {
+        m_weak.insert(entry);
+    }
+    if (record.expiry.isValid()) {
+        m_expiry.insert(record.expiry, entry);
+    }
+}
+
+void PasswordHealthIndex::removeRecord(const Entry* entry)
+{
+    auto it = m_records.find(entry);
+    if (it == m_records.end()) {
+        return;
+    }
+
+    const auto& record = it.value();
+    if (!record.digest.isEmpty() && !record.reference) {
+        auto reuse = m_reuse.find(record.digest);
+        if (reuse != m_reuse.end()) {
+            reuse->removeOne(entry);
+            if (reuse->isEmpty()) {
+                m_reuse.erase(reuse);
+            }
+        }
+    }
+    m_weak.remove(entry);
+    if (record.expiry.isValid()) {
+        m_expiry.remove(record.expiry, entry);
+    }
+    m_records.erase(it);
+}
+
+/**
+ * Build the index record of an entry. The weak flag of the previous
+ * record is reused if the password did not change and contains no
+ * placeholders. An entry counts as weak if either its raw or its
+ * resolved password is weak.
+ */
+PasswordHealthIndex::Record PasswordHealthIndex::makeRecord(const Entry* entry, const Record* previous) const
+{
+    const auto isWeak = [](const QString& password) {
+        return !password.isEmpty() && PasswordHealth(password).quality() <= PasswordHealth::Quality::Weak;
+    };
+
+    Record record;
+    const auto password = entry->password();
+    const auto resolvedPassword = entry->resolvePlaceholder(password);
+    record.digest = digest(password);
+    record.reference = entry->isAttributeReference(EntryAttributes::PasswordKey);
+    record.plain = resolvedPassword == password;
+    if (previous && previous->plain && record.plain && previous->digest == record.digest) {
+        record.weak = previous->weak;
+    } else {
+        // Check the raw password as well, it is what the health checker scores
+        record.weak = isWeak(resolvedPassword) || (!record.plain && isWeak(password));
+    }
+    if (entry->timeInfo().expires()) {
+        record.expiry = entry->timeInfo().expiryTime();
+    }
+    return record;
+}
+
+/**
+ * HMAC of a password under the random key of this index, so that no
+ * plaintext password needs to be kept to detect re-use.
+ */
+QByteArray PasswordHealthIndex::digest(const QString& password) const
+{
+    if (password.isEmpty()) {
+        return {};
+    }
+    return CryptoHash::hmac(password.toUtf8(), m_key, CryptoHash::Sha256);
+}
@@ -0,0 +1,86 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEEPASSX_PASSWORDHEALTHINDEX_H
+#define KEEPASSX_PASSWORDHEALTHINDEX_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QMultiMap>
+#include <QObject>
+#include <QSet>
+
+class Database;
+class Entry;
+class Group;
+
+/**
+ * Database-wide password health data that is kept up to date
+ * incrementally from entry and group change signals.
+ *
+ * The index tracks password re-use, expiry dates and weak passwords
+ * so that reports don't need to rescan the whole database. Passwords
+ * are only kept as HMACs under a random key of the index. Queries
+ * skip recycled entries. The index must only be modified from the
+ * thread that owns the database; concurrent const queries are safe.
+ *
+ * @see HealthChecker
+ */
+class PasswordHealthIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PasswordHealthIndex(Database* db);
+    ~PasswordHealthIndex() override;
+
+    QList<const Entry*> entriesUsingPassword(const QString& password) const;
+    int maxPasswordReuse() const;
+    QList<const Entry*> reusedEntries() const;
+    QList<const Entry*> weakEntries() const;
+    QList<const Entry*> expiringEntries(const QDateTime& before) const;
+
+private:
+    struct Record
+    {
+        QByteArray digest;
+        bool reference = false;
+        // Whether the password resolves to itself, only then the weak flag can be reused
+        bool plain = false;
+        bool weak = false;
+        QDateTime expiry;
+    };
+
+    void trackGroup(Group* group);
+    void untrackGroup(Group* group);
+    void addEntry(Entry* entry);
+    void removeEntry(Entry* entry);
+    void updateEntry(Entry* entry);
+
+    void insertRecord(const Entry* entry, const Record& record);
+    void removeRecord(const Entry* entry);
+    Record makeRecord(const Entry* entry, const Record* previous = nullptr) const;
+    QByteArray digest(const QString& password) const;
+
+    const QByteArray m_key;
+    QHash<const Entry*, Record> m_records;
+    QHash<QByteArray, QList<const Entry*>> m_reuse;
+    QSet<const Entry*> m_weak;
+    QMultiMap<QDateTime, const Entry*> m_expiry;
+};
+
+#endif // KEEPASSX_PASSWORDHEALTHINDEX_H
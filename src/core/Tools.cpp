@@ -27,6 +27,8 @@
 #include "git-info.h"
 
 #include "core/Clock.h"
+#include "core/Database.h"
+#include "core/LatencyStats.h"
 
 #include <QCoreApplication>
 #include <QElapsedTimer>
@@ -116,6 +118,12 @@ namespace Tools
         }
 
         debugInfo.append(QObject::tr("Enabled extensions:").append(extensions).append("\n"));
+
+        const auto& saveLatency = Database::saveLatency();
+        if (saveLatency.count() > 0) {
+            debugInfo.append("\n");
+            debugInfo.append(QObject::tr("Database save latency: %1").arg(saveLatency.summary()).append("\n"));
+        }
         return debugInfo;
     }
 
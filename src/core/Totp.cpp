@@ -22,12 +22,13 @@
 #include "core/Clock.h"
 
 #include <QMessageAuthenticationCode>
+#include <QMutex>
 #include <QSharedPointer>
 #include <QUrlQuery>
 #include <QVariant>
 #include <QtEndian>
 
-#include <cmath>
+#include <limits>
 
 static QList<Totp::Encoder> totpEncoders{
     {"", "", "0123456789", Totp::DEFAULT_DIGITS, Totp::DEFAULT_STEP, false},
@@ -210,31 +211,55 @@ QString Totp::writeSettings(const QSharedPointer<Totp::Settings>& settings,
     }
 }
 
-QString Totp::generateTotp(const QSharedPointer<Totp::Settings>& settings, const quint64 time)
+static QMutex& settingsCacheMutex()
 {
-    Q_ASSERT(!settings.isNull());
-    if (settings.isNull()) {
-        return QObject::tr("Invalid Settings", "TOTP");
-    }
-
-    const Encoder& encoder = settings->encoder;
-    uint step = settings->step;
-    uint digits = settings->digits;
+    static QMutex mutex;
+    return mutex;
+}
 
-    quint64 current;
-    if (time == 0) {
-        current = qToBigEndian(static_cast<quint64>(Clock::currentSecondsSinceEpoch()) / step);
-    } else {
-        current = qToBigEndian(time / step);
+/**
+ * Refresh the derived values cached in the settings and return copies of them.
+ * Settings are shared between entries, the cache is only touched under a lock.
+ */
+static bool prepareSettings(const Totp::Settings& settings, QByteArray& decodedKey, quint64& modulus)
+{
+    QMutexLocker locker(&settingsCacheMutex());
+    if (settings.cachedKey.isNull() || settings.cachedKey != settings.key) {
+        QVariant secret = Base32::decode(Base32::sanitizeInput(settings.key.toLatin1()));
+        settings.cachedKey = settings.key.isNull() ? QString("") : settings.key;
+        settings.validKey = !secret.isNull();
+        settings.decodedKey = secret.toByteArray();
     }
 
-    QVariant secret = Base32::decode(Base32::sanitizeInput(settings->key.toLatin1()));
-    if (secret.isNull()) {
-        return QObject::tr("Invalid Key", "TOTP");
+    const int alphabetSize = settings.encoder.alphabet.size();
+    if (settings.cachedDigits != settings.digits || settings.cachedAlphabetSize != alphabetSize) {
+        // The truncated HMAC is a 31 bit value, once the modulus exceeds it
+        // the code is the full value and multiplying further is pointless
+        quint64 value = 1;
+        for (uint i = 0; i < settings.digits && value <= std::numeric_limits<quint32>::max(); ++i) {
+            value *= alphabetSize;
+        }
+        settings.cachedDigits = settings.digits;
+        settings.cachedAlphabetSize = alphabetSize;
+        settings.modulus = value;
     }
 
+    decodedKey = settings.decodedKey;
+    modulus = settings.modulus;
+    return settings.validKey;
+}
+
+static QString generateCode(const Totp::Settings& settings,
+                            const QByteArray& decodedKey,
+                            quint64 modulus,
+                            const quint64 counter)
+{
+    const Totp::Encoder& encoder = settings.encoder;
+    const uint digits = settings.digits;
+    const quint64 current = qToBigEndian(counter);
+
     QCryptographicHash::Algorithm cryptoHash;
-    switch (settings->algorithm) {
+    switch (settings.algorithm) {
     case Totp::Algorithm::Sha512:
         cryptoHash = QCryptographicHash::Sha512;
         break;
@@ -245,9 +270,8 @@ QString Totp::generateTotp(const QSharedPointer<Totp::Settings>& settings, const
         cryptoHash = QCryptographicHash::Sha1;
         break;
     }
-    QMessageAuthenticationCode code(cryptoHash);
-    code.setKey(secret.toByteArray());
-    code.addData(QByteArray(reinterpret_cast<char*>(&current), sizeof(current)));
+    QMessageAuthenticationCode code(cryptoHash, decodedKey);
+    code.addData(reinterpret_cast<const char*>(&current), sizeof(current));
     QByteArray hmac = code.result();
 
     int offset = (hmac[hmac.length() - 1] & 0xf);
@@ -266,9 +290,8 @@ QString Totp::generateTotp(const QSharedPointer<Totp::Settings>& settings, const
         direction = 1;
         startpos = 0;
     }
-    quint32 digitsPower = pow(encoder.alphabet.size(), digits);
 
-    quint64 password = binary % digitsPower;
+    quint64 password = binary % modulus;
     QString retval(int(digits), encoder.alphabet[0]);
     for (quint8 pos = startpos; password > 0; pos += direction) {
         retval[pos] = encoder.alphabet[int(password % encoder.alphabet.size())];
@@ -277,6 +300,56 @@ QString Totp::generateTotp(const QSharedPointer<Totp::Settings>& settings, const
     return retval;
 }
 
+QString Totp::generateTotp(const QSharedPointer<Totp::Settings>& settings, const quint64 time)
+{
+    Q_ASSERT(!settings.isNull());
+    if (settings.isNull()) {
+        return QObject::tr("Invalid Settings", "TOTP");
+    }
+
+    QByteArray decodedKey;
+    quint64 modulus = 0;
+    if (!prepareSettings(*settings, decodedKey, modulus)) {
+        return QObject::tr("Invalid Key", "TOTP");
+    }
+
+    quint64 now = time == 0 ? static_cast<quint64>(Clock::currentSecondsSinceEpoch()) : time;
+    return generateCode(*settings, decodedKey, modulus, now / settings->step);
+}
+
+/**
+ * Generate the current and the next code for each of the given settings.
+ *
+ * All codes are computed against the same point in time, which makes the
+ * result consistent when listing many entries at once.
+ */
+QList<Totp::Code> Totp::generateCodes(const QList<QSharedPointer<Totp::Settings>>& settings, const quint64 time)
+{
+    quint64 now = time == 0 ? static_cast<quint64>(Clock::currentSecondsSinceEpoch()) : time;
+
+    QList<Totp::Code> codes;
+    codes.reserve(settings.size());
+    for (const auto& setting : settings) {
+        if (setting.isNull()) {
+            codes.append({QObject::tr("Invalid Settings", "TOTP"), {}, 0});
+            continue;
+        }
+        QByteArray decodedKey;
+        quint64 modulus = 0;
+        if (!prepareSettings(*setting, decodedKey, modulus)) {
+            codes.append({QObject::tr("Invalid Key", "TOTP"), {}, 0});
+            continue;
+        }
+
+        const quint64 counter = now / setting->step;
+        const auto validFor = static_cast<uint>(setting->step - now % setting->step);
+        codes.append({generateCode(*setting, decodedKey, modulus, counter),
+                      generateCode(*setting, decodedKey, modulus, counter + 1),
+                      validFor});
+    }
+    return codes;
+}
+
 QList<QPair<QString, QString>> Totp::supportedEncoders()
 {
     QList<QPair<QString, QString>> encoders;
@@ -19,6 +19,8 @@
 #ifndef QTOTP_H
 #define QTOTP_H
 
+#include <QByteArray>
+#include <QList>
 #include <QMetaType>
 #include <QString>
 
@@ -58,6 +60,22 @@ namespace Totp
         QString key;
         uint digits;
         uint step;
+
+        // Derived from the fields above on first use and refreshed whenever they change,
+        // only accessed under the cache lock in Totp.cpp
+        mutable QString cachedKey;
+        mutable QByteArray decodedKey;
+        mutable bool validKey = false;
+        mutable uint cachedDigits = 0;
+        mutable int cachedAlphabetSize = 0;
+        mutable quint64 modulus = 0;
+    };
+
+    struct Code
+    {
+        QString current;
+        QString next;
+        uint validFor;
     };
 
     constexpr uint DEFAULT_STEP = 30u;
@@ -93,6 +111,7 @@ namespace Totp
                           bool forceOtp = false);
 
     QString generateTotp(const QSharedPointer<Totp::Settings>& settings, const quint64 time = 0ull);
+    QList<Totp::Code> generateCodes(const QList<QSharedPointer<Totp::Settings>>& settings, const quint64 time = 0ull);
 
     bool hasCustomSettings(const QSharedPointer<Totp::Settings>& settings);
 
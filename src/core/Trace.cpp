@@ -0,0 +1,191 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Trace.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+
+namespace Trace
+{
+    namespace Internal
+    {
+        std::atomic<bool> enabled{false};
+    } // namespace Internal
+
+    namespace
+    {
+        // Events are buffered and written in batches to keep file I/O out of the traced code paths
+        const int FlushThreshold = 64 * 1024;
+
+        struct Sink
+        {
+            QMutex mutex;
+            QFile file;
+            QByteArray buffer;
+            qint64 pid = 0;
+            bool postRoutineAdded = false;
+        };
+
+        Sink& sink()
+        {
+            static Sink instance;
+            return instance;
+        }
+
+        // Started once and never restarted, so spans can read it without locking
+        const QElapsedTimer& clock()
+        {
+            static const QElapsedTimer timer = [] {
+                QElapsedTimer t;
+                t.start();
+                return t;
+            }();
+            return timer;
+        }
+
+        int currentThreadId()
+        {
+            static std::atomic<int> nextId{1};
+            thread_local int id = nextId.fetch_add(1);
+            return id;
+        }
+
+        QByteArray escaped(const char* name)
+        {
+            QByteArray value(name);
+            value.replace('\\', "\\\\");
+            value.replace('"', "\\\"");
+            return value;
+        }
+
+        QByteArray micros(qint64 nsecs)
+        {
+            return QByteArray::number(static_cast<double>(nsecs) / 1000.0, 'f', 3);
+        }
+
+        void flush(Sink& s)
+        {
+            if (!s.buffer.isEmpty()) {
+                s.file.write(s.buffer);
+                s.file.flush();
+                s.buffer.clear();
+            }
+        }
+    } // namespace
+
+    qint64 Internal::now()
+    {
+        return clock().nsecsElapsed();
+    }
+
+    void Internal::record(const char* name, qint64 start, qint64 end)
+    {
+        auto& s = sink();
+        QMutexLocker locker(&s.mutex);
+        // Tracing may have been stopped while the span was open
+        if (!isEnabled()) {
+            return;
+        }
+
+        s.buffer.append(",\n{\"name\":\"")
+            .append(escaped(name))
+            .append("\",\"cat\":\"keepassxc\",\"ph\":\"X\",\"ts\":")
+            .append(micros(start))
+            .append(",\"dur\":")
+            .append(micros(end - start))
+            .append(",\"pid\":")
+            .append(QByteArray::number(s.pid))
+            .append(",\"tid\":")
+            .append(QByteArray::number(currentThreadId()))
+            .append('}');
+
+        if (s.buffer.size() >= FlushThreshold) {
+            flush(s);
+        }
+    }
+
+    /**
+     * Start writing trace events to the given file, replacing its contents.
+     * The trace is finalized by stop(), which also runs when the application exits.
+     *
+     * @param fileName path of the JSON trace file
+     * @param error error message in case of failure
+     * @return true on success
+     */
+    bool start(const QString& fileName, QString* error)
+    {
+        stop();
+
+        auto& s = sink();
+        QMutexLocker locker(&s.mutex);
+        s.file.setFileName(fileName);
+        if (!s.file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            if (error) {
+                *error = QObject::tr("Failed to open trace file %1: %2").arg(fileName, s.file.errorString());
+            }
+            return false;
+        }
+
+        s.pid = QCoreApplication::applicationPid();
+        QString processName = QCoreApplication::applicationName();
+        if (processName.isEmpty()) {
+            processName = "keepassxc";
+        }
+
+        // JSON array format; viewers also accept the file if the process dies before stop()
+        s.buffer = "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":";
+        s.buffer.append(QByteArray::number(s.pid))
+            .append(",\"tid\":0,\"args\":{\"name\":\"")
+            .append(escaped(processName.toUtf8().constData()))
+            .append("\"}}");
+        flush(s);
+
+        if (!s.postRoutineAdded) {
+            qAddPostRoutine(stop);
+            s.postRoutineAdded = true;
+        }
+
+        // Initialize the clock before the first span can read it
+        clock();
+        Internal::enabled.store(true);
+        return true;
+    }
+
+    void stop()
+    {
+        auto& s = sink();
+        QMutexLocker locker(&s.mutex);
+        if (!isEnabled()) {
+            return;
+        }
+
+        Internal::enabled.store(false);
+        s.buffer.append("\n]\n");
+        flush(s);
+        s.file.close();
+    }
+
+    QString fileName()
+    {
+        auto& s = sink();
+        QMutexLocker locker(&s.mutex);
+        return isEnabled() ? s.file.fileName() : QString();
+    }
+} // namespace Trace
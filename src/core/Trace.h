@@ -0,0 +1,84 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEEPASSXC_TRACE_H
+#define KEEPASSXC_TRACE_H
+
+#include <QString>
+
+#include <atomic>
+
+/**
+ * Lightweight scoped tracing of hot paths.
+ *
+ * Spans are recorded as Chrome trace events ("ph": "X") and can be loaded
+ * into chrome://tracing or Perfetto. While tracing is disabled a span costs
+ * a single relaxed atomic load.
+ */
+namespace Trace
+{
+    static const char* const EnvironmentVariable = "KEEPASSXC_TRACE";
+
+    namespace Internal
+    {
+        extern std::atomic<bool> enabled;
+        qint64 now();
+        void record(const char* name, qint64 start, qint64 end);
+    } // namespace Internal
+
+    bool start(const QString& fileName, QString* error = nullptr);
+    void stop();
+    QString fileName();
+
+    inline bool isEnabled()
+    {
+        return Internal::enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Records the lifetime of the enclosing scope. The name must outlive the
+     * trace session, i.e. be a string literal.
+     */
+    class Span
+    {
+    public:
+        explicit Span(const char* name)
+            : m_name(isEnabled() ? name : nullptr)
+            , m_start(m_name ? Internal::now() : 0)
+        {
+        }
+
+        ~Span()
+        {
+            if (m_name) {
+                Internal::record(m_name, m_start, Internal::now());
+            }
+        }
+
+    private:
+        Q_DISABLE_COPY(Span)
+
+        const char* m_name;
+        qint64 m_start;
+    };
+} // namespace Trace
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+#define TRACE_SPAN(name) Trace::Span TRACE_CONCAT(traceSpan, __LINE__)(name)
+
+#endif // KEEPASSXC_TRACE_H
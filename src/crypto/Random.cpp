@@ -21,8 +21,29 @@
 
 #include <QSharedPointer>
 
+#include <botan/mem_ops.h>
+#include <botan/secmem.h>
 #include <botan/system_rng.h>
 
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    // Small random numbers are served from a per-thread buffer that is refilled in
+    // large blocks, instead of querying the system RNG for every 4 bytes
+    constexpr size_t RandomBufferSize = 4096;
+
+    struct RandomBuffer
+    {
+        // secure_vector wipes the remaining bytes when the thread exits
+        Botan::secure_vector<uint8_t> data;
+        size_t pos = 0;
+    };
+
+    thread_local RandomBuffer t_randomBuffer;
+} // namespace
+
 QSharedPointer<Random> Random::m_instance;
 
 QSharedPointer<Random> Random::instance()
@@ -71,12 +92,33 @@ quint32 Random::randomUInt(quint32 limit)
 
     // To avoid modulo bias make sure rand is below the largest number where rand%limit==0
     do {
-        m_rng->randomize(reinterpret_cast<uint8_t*>(&rand), 4);
+        randomizeBuffered(reinterpret_cast<uint8_t*>(&rand), sizeof(rand));
     } while (rand > ceil);
 
     return (rand % limit);
 }
 
+void Random::randomizeBuffered(uint8_t* data, size_t len)
+{
+    auto& buffer = t_randomBuffer;
+    while (len > 0) {
+        if (buffer.pos >= buffer.data.size()) {
+            buffer.data.resize(RandomBufferSize);
+            m_rng->randomize(buffer.data.data(), buffer.data.size());
+            buffer.pos = 0;
+        }
+
+        auto count = std::min(len, buffer.data.size() - buffer.pos);
+        std::memcpy(data, buffer.data.data() + buffer.pos, count);
+        // Bytes handed out are never kept around in the buffer
+        Botan::secure_scrub_memory(buffer.data.data() + buffer.pos, count);
+
+        buffer.pos += count;
+        data += count;
+        len -= count;
+    }
+}
+
 quint32 Random::randomUIntRange(quint32 min, quint32 max)
 {
     return min + randomUInt(max - min);
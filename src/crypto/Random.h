@@ -46,6 +46,8 @@ private:
     explicit Random();
     Q_DISABLE_COPY(Random);
 
+    void randomizeBuffered(uint8_t* data, size_t len);
+
     static QSharedPointer<Random> m_instance;
     QSharedPointer<Botan::RandomNumberGenerator> m_rng;
 };
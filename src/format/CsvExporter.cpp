@@ -18,10 +18,17 @@
 
 #include "CsvExporter.h"
 
+#include <QBuffer>
 #include <QFile>
 
 #include "core/Group.h"
 
+namespace
+{
+    // Rows are collected up to this size before being written to the device
+    constexpr int WriteBufferSize = 64 * 1024;
+} // namespace
+
 bool CsvExporter::exportDatabase(const QString& filename, const QSharedPointer<const Database>& db)
 {
     QFile file(filename);
@@ -34,22 +41,23 @@ bool CsvExporter::exportDatabase(const QString& filename, const QSharedPointer<c
 
 bool CsvExporter::exportDatabase(QIODevice* device, const QSharedPointer<const Database>& db)
 {
-    if (device->write(exportHeader().toUtf8()) == -1) {
-        m_error = device->errorString();
-        return false;
-    }
+    m_rows = 0;
+    m_bytes = 0;
 
-    if (device->write(exportGroup(db->rootGroup()).toUtf8()) == -1) {
-        m_error = device->errorString();
-        return false;
-    }
+    QByteArray buffer;
+    buffer.reserve(WriteBufferSize * 2);
+    buffer.append(exportHeader().toUtf8());
 
-    return true;
+    return exportGroup(device, buffer, db->rootGroup()) && flush(device, buffer);
 }
 
 QString CsvExporter::exportDatabase(const QSharedPointer<const Database>& db)
 {
-    return exportHeader() + exportGroup(db->rootGroup());
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    exportDatabase(&buffer, db);
+    return QString::fromUtf8(data);
 }
 
 QString CsvExporter::errorString() const
@@ -57,6 +65,31 @@ QString CsvExporter::errorString() const
     return m_error;
 }
 
+qint64 CsvExporter::exportedRows() const
+{
+    return m_rows;
+}
+
+qint64 CsvExporter::exportedBytes() const
+{
+    return m_bytes;
+}
+
+bool CsvExporter::flush(QIODevice* device, QByteArray& buffer)
+{
+    if (buffer.isEmpty()) {
+        return true;
+    }
+    if (device->write(buffer) == -1) {
+        m_error = device->errorString();
+        return false;
+    }
+    m_bytes += buffer.size();
+    // Keeps the reserved capacity for the next rows
+    buffer.resize(0);
+    return true;
+}
+
 QString CsvExporter::exportHeader()
 {
     QString header;
@@ -73,9 +106,8 @@ QString CsvExporter::exportHeader()
     return header + QString("\n");
 }
 
-QString CsvExporter::exportGroup(const Group* group, QString groupPath)
+bool CsvExporter::exportGroup(QIODevice* device, QByteArray& buffer, const Group* group, QString groupPath)
 {
-    QString response;
     if (!groupPath.isEmpty()) {
         groupPath.append("/");
     }
@@ -97,15 +129,22 @@ QString CsvExporter::exportGroup(const Group* group, QString groupPath)
         addColumn(line, entry->timeInfo().creationTime().toString(Qt::ISODate));
 
         line.append("\n");
-        response.append(line);
+        buffer.append(line.toUtf8());
+        ++m_rows;
+
+        if (buffer.size() >= WriteBufferSize && !flush(device, buffer)) {
+            return false;
+        }
     }
 
     const QList<Group*>& children = group->children();
     for (const Group* child : children) {
-        response.append(exportGroup(child, groupPath));
+        if (!exportGroup(device, buffer, child, groupPath)) {
+            return false;
+        }
     }
 
-    return response;
+    return true;
 }
 
 void CsvExporter::addColumn(QString& str, const QString& column)
@@ -34,12 +34,19 @@ public:
     QString exportDatabase(const QSharedPointer<const Database>& db);
     QString errorString() const;
 
+    // Statistics of the last export
+    qint64 exportedRows() const;
+    qint64 exportedBytes() const;
+
 private:
-    QString exportGroup(const Group* group, QString groupPath = QString());
+    bool exportGroup(QIODevice* device, QByteArray& buffer, const Group* group, QString groupPath = QString());
+    bool flush(QIODevice* device, QByteArray& buffer);
     QString exportHeader();
     void addColumn(QString& str, const QString& column);
 
     QString m_error;
+    qint64 m_rows = 0;
+    qint64 m_bytes = 0;
 };
 
 #endif // KEEPASSX_CSVEXPORTER_H
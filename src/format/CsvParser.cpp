@@ -24,23 +24,18 @@
 #include "core/Tools.h"
 
 CsvParser::CsvParser()
-    : m_comment('#')
+    : m_codec(QTextCodec::codecForName("UTF-8"))
+    , m_isDecoded(false)
+    , m_comment('#')
     , m_isBackslashSyntax(false)
     , m_isFileLoaded(false)
     , m_qualifier('"')
     , m_separator(',')
 {
     reset();
-    m_csv.setBuffer(&m_array);
-    m_ts.setDevice(&m_csv);
-    m_csv.open(QIODevice::ReadOnly);
-    m_ts.setCodec("UTF-8");
 }
 
-CsvParser::~CsvParser()
-{
-    m_csv.close();
-}
+CsvParser::~CsvParser() = default;
 
 bool CsvParser::isFileLoaded()
 {
@@ -79,8 +74,7 @@ bool CsvParser::readFile(QFile* device)
     } else {
         device->close();
 
-        m_array.replace("\r\n", "\n");
-        m_array.replace("\r", "\n");
+        // line endings are normalized while scanning, see getChar()
         if (m_array.isEmpty()) {
             appendStatusMsg(QObject::tr("file empty").append("\n"));
         }
@@ -96,10 +90,10 @@ void CsvParser::reset()
     m_currRow = 1;
     m_isEof = false;
     m_isGood = true;
+    m_pos = 0;
     m_lastPos = -1;
     m_maxCols = 0;
     m_statusMsg.clear();
-    m_ts.seek(0);
     m_table.clear();
     // the following can be overridden by the user
     // m_comment = '#';
@@ -114,10 +108,27 @@ void CsvParser::clear()
     reset();
     m_isFileLoaded = false;
     m_array.clear();
+    m_text.clear();
+    m_isDecoded = false;
+}
+
+void CsvParser::decode()
+{
+    if (m_isDecoded) {
+        return;
+    }
+    // Decode the whole buffer once, reparsing with other options only rescans it.
+    // A byte order mark takes precedence over the selected codec.
+    m_text = QTextCodec::codecForUtfText(m_array, m_codec)->toUnicode(m_array);
+    if (m_text.startsWith(QChar(0xFEFF))) {
+        m_text.remove(0, 1);
+    }
+    m_isDecoded = true;
 }
 
 bool CsvParser::parseFile()
 {
+    decode();
     parseRecord();
     while (!m_isEof) {
         if (!skipEndline()) {
@@ -173,15 +184,16 @@ void CsvParser::parseField(CsvRow& row)
 
 void CsvParser::parseSimple(QString& s)
 {
-    QChar c;
-    getChar(c);
-    while (c != '\n' && c != m_separator && !m_isEof) {
-        s.append(c);
-        getChar(c);
-    }
-    if (!m_isEof) {
-        ungetChar();
+    // Unquoted fields cannot span lines, so copy the whole span at once
+    const QChar* data = m_text.constData();
+    const int size = m_text.size();
+    int end = m_pos;
+    while (end < size && data[end] != m_separator && data[end] != '\n' && data[end] != '\r') {
+        ++end;
     }
+    s.append(data + m_pos, end - m_pos);
+    m_pos = end;
+    m_isEof = m_pos >= size;
 }
 
 void CsvParser::parseQuoted(QString& s)
@@ -252,22 +264,23 @@ bool CsvParser::processEscapeMark(QString& s, QChar c)
 void CsvParser::fillColumns()
 {
     // fill shorter rows with empty placeholder columns
-    for (int i = 0; i < m_table.size(); ++i) {
-        int gap = m_maxCols - m_table.at(i).size();
-        if (gap > 0) {
-            CsvRow r = m_table.at(i);
-            for (int j = 0; j < gap; ++j) {
-                r.append(QString(""));
-            }
-            m_table.replace(i, r);
+    for (auto& row : m_table) {
+        while (row.size() < m_maxCols) {
+            row.append(QString(""));
         }
     }
 }
 
 void CsvParser::skipLine()
 {
-    m_ts.readLine();
-    m_ts.seek(m_ts.pos() - 1);
+    // stop on the line ending, it is consumed by skipEndline()
+    QChar c;
+    do {
+        getChar(c);
+    } while (c != '\n' && !m_isEof);
+    if (!m_isEof) {
+        ungetChar();
+    }
 }
 
 bool CsvParser::skipEndline()
@@ -278,19 +291,28 @@ bool CsvParser::skipEndline()
 
 void CsvParser::getChar(QChar& c)
 {
-    m_isEof = m_ts.atEnd();
+    m_isEof = m_pos >= m_text.size();
     if (!m_isEof) {
-        m_lastPos = m_ts.pos();
-        m_ts >> c;
+        m_lastPos = m_pos;
+        c = m_text.at(m_pos++);
+        // CRLF and CR are both read as a single LF
+        if (c == '\r') {
+            c = '\n';
+            if (m_pos < m_text.size() && m_text.at(m_pos) == '\n') {
+                ++m_pos;
+            }
+        }
     }
 }
 
 void CsvParser::ungetChar()
 {
-    if (!m_ts.seek(m_lastPos)) {
+    if (m_lastPos < 0) {
         qWarning("CSV Parser: unget lower bound exceeded");
         m_isGood = false;
+        return;
     }
+    m_pos = m_lastPos;
 }
 
 void CsvParser::peek(QChar& c)
@@ -313,7 +335,7 @@ bool CsvParser::isComment()
 {
     bool result = false;
     QChar c2;
-    qint64 pos = m_ts.pos();
+    int pos = m_pos;
 
     do {
         getChar(c2);
@@ -322,7 +344,7 @@ bool CsvParser::isComment()
     if (c2 == m_comment) {
         result = true;
     }
-    m_ts.seek(pos);
+    m_pos = pos;
     return result;
 }
 
@@ -348,7 +370,11 @@ void CsvParser::setComment(const QChar& c)
 
 void CsvParser::setCodec(const QString& s)
 {
-    m_ts.setCodec(QTextCodec::codecForName(s.toLocal8Bit()));
+    auto codec = QTextCodec::codecForName(s.toLocal8Bit());
+    if (codec && codec != m_codec) {
+        m_codec = codec;
+        m_isDecoded = false;
+    }
 }
 
 void CsvParser::setFieldSeparator(const QChar& c)
@@ -363,10 +389,10 @@ void CsvParser::setTextQualifier(const QChar& c)
 
 int CsvParser::getFileSize() const
 {
-    return m_csv.size();
+    return m_array.size();
 }
 
-CsvTable CsvParser::getCsvTable() const
+const CsvTable& CsvParser::getCsvTable() const
 {
     return m_table;
 }
@@ -19,10 +19,10 @@
 #ifndef KEEPASSX_CSVPARSER_H
 #define KEEPASSX_CSVPARSER_H
 
-#include <QBuffer>
-#include <QTextStream>
+#include <QStringList>
 
 class QFile;
+class QTextCodec;
 
 typedef QStringList CsvRow;
 typedef QList<CsvRow> CsvTable;
@@ -47,14 +47,19 @@ public:
     int getCsvRows() const;
     int getCsvCols() const;
     QString getStatus() const;
-    CsvTable getCsvTable() const;
+    const CsvTable& getCsvTable() const;
 
 protected:
     CsvTable m_table;
 
 private:
     QByteArray m_array;
-    QBuffer m_csv;
+    // decoded content of m_array, scanned in place by the parser
+    QString m_text;
+    QTextCodec* m_codec;
+    bool m_isDecoded;
+    int m_pos;
+    int m_lastPos;
     QChar m_ch;
     QChar m_comment;
     unsigned int m_currCol;
@@ -63,13 +68,12 @@ private:
     bool m_isEof;
     bool m_isFileLoaded;
     bool m_isGood;
-    qint64 m_lastPos;
     int m_maxCols;
     QChar m_qualifier;
     QChar m_separator;
     QString m_statusMsg;
-    QTextStream m_ts;
 
+    void decode();
     void getChar(QChar& c);
     void ungetChar();
     void peek(QChar& c);
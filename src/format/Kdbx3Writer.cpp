@@ -25,8 +25,8 @@
 #include "format/KdbxXmlWriter.h"
 #include "format/KeePass2RandomStream.h"
 #include "streams/HashedBlockStream.h"
+#include "streams/ParallelGzipStream.h"
 #include "streams/SymmetricCipherStream.h"
-#include "streams/qtiocompressor.h"
 
 bool Kdbx3Writer::writeDatabase(QIODevice* device, Database* db)
 {
@@ -115,13 +115,12 @@ bool Kdbx3Writer::writeDatabase(QIODevice* device, Database* db)
     }
 
     QIODevice* outputDevice = nullptr;
-    QScopedPointer<QtIOCompressor> ioCompressor;
+    QScopedPointer<ParallelGzipStream> ioCompressor;
 
     if (db->compressionAlgorithm() == Database::CompressionNone) {
         outputDevice = &hashedStream;
     } else {
-        ioCompressor.reset(new QtIOCompressor(&hashedStream));
-        ioCompressor->setStreamFormat(QtIOCompressor::GzipFormat);
+        ioCompressor.reset(new ParallelGzipStream(&hashedStream, db->compressionLevel()));
         if (!ioCompressor->open(QIODevice::WriteOnly)) {
             raiseError(ioCompressor->errorString());
             return false;
@@ -143,6 +142,10 @@ bool Kdbx3Writer::writeDatabase(QIODevice* device, Database* db)
     // Explicitly close/reset streams so they are flushed and we can detect
     // errors. QIODevice::close() resets errorString() etc.
     if (ioCompressor) {
+        if (!ioCompressor->reset()) {
+            raiseError(ioCompressor->errorString());
+            return false;
+        }
         ioCompressor->close();
     }
     if (!hashedStream.reset()) {
@@ -24,8 +24,8 @@
 #include "crypto/Random.h"
 #include "format/KeePass2RandomStream.h"
 #include "streams/HmacBlockStream.h"
+#include "streams/ParallelGzipStream.h"
 #include "streams/SymmetricCipherStream.h"
-#include "streams/qtiocompressor.h"
 
 bool Kdbx4Writer::writeDatabase(QIODevice* device, Database* db)
 {
@@ -132,13 +132,12 @@ bool Kdbx4Writer::writeDatabase(QIODevice* device, Database* db)
     }
 
     QIODevice* outputDevice = nullptr;
-    QScopedPointer<QtIOCompressor> ioCompressor;
+    QScopedPointer<ParallelGzipStream> ioCompressor;
 
     if (db->compressionAlgorithm() == Database::CompressionNone) {
         outputDevice = cipherStream.data();
     } else {
-        ioCompressor.reset(new QtIOCompressor(cipherStream.data()));
-        ioCompressor->setStreamFormat(QtIOCompressor::GzipFormat);
+        ioCompressor.reset(new ParallelGzipStream(cipherStream.data(), db->compressionLevel()));
         if (!ioCompressor->open(QIODevice::WriteOnly)) {
             raiseError(ioCompressor->errorString());
             return false;
@@ -172,6 +171,10 @@ bool Kdbx4Writer::writeDatabase(QIODevice* device, Database* db)
     // Explicitly close/reset streams so they are flushed and we can detect
     // errors. QIODevice::close() resets errorString() etc.
     if (ioCompressor) {
+        if (!ioCompressor->reset()) {
+            raiseError(ioCompressor->errorString());
+            return false;
+        }
         ioCompressor->close();
     }
     if (!cipherStream->reset()) {
@@ -221,32 +224,15 @@ KdbxXmlWriter::BinaryIdxMap Kdbx4Writer::writeAttachments(QIODevice* device, Dat
     for (const Entry* entry : allEntries) {
         const QList<QString> attachmentKeys = entry->attachments()->keys();
         for (const QString& key : attachmentKeys) {
-            QByteArray data("\x01");
-            data.append(entry->attachments()->value(key));
-
-            CryptoHash hash(CryptoHash::Sha256);
-#ifdef WITH_XC_KEESHARE
-            // Namespace KeeShare attachments so they don't get deduplicated together with attachments
-            // from other databases. Prevents potential filesize side channels.
-            auto group = entry->group();
-            if (!group && entry->historyOwner()) {
-                group = entry->historyOwner()->group();
-            }
-            if (group && group->isShared()) {
-                hash.addData(group->uuid().toByteArray());
-            } else {
-                hash.addData(db->uuid().toByteArray());
-            }
-#endif
-            hash.addData(data);
-
-            // Deduplicate attachments with the same hash
-            const auto hashResult = hash.result();
-            if (!writtenAttachments.contains(hashResult)) {
+            // Deduplicate attachments with the same content
+            const auto dedupKey = KdbxXmlWriter::binaryDedupKey(db, entry, key);
+            if (!writtenAttachments.contains(dedupKey)) {
+                QByteArray data("\x01");
+                data.append(entry->attachments()->value(key));
                 writeInnerHeaderField(device, KeePass2::InnerHeaderFieldID::Binary, data);
-                writtenAttachments.insert(hashResult, nextIdx++);
+                writtenAttachments.insert(dedupKey, nextIdx++);
             }
-            idxMap.insert(qMakePair(entry, key), writtenAttachments[hashResult]);
+            idxMap.insert(qMakePair(entry, key), writtenAttachments[dedupKey]);
         }
     }
 
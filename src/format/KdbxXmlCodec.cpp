@@ -0,0 +1,244 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "KdbxXmlCodec.h"
+
+#include <array>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define KDBXXMLCODEC_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define KDBXXMLCODEC_NEON
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+    const char Base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    // Characters that are valid in XML 1.0 on their own. Everything else,
+    // including surrogate pairs and U+0085, is left to the scalar check.
+    inline bool isPlainXml10Char(ushort uc)
+    {
+        return (uc >= 0x20 && uc <= 0x7E) || uc == 0x09 || uc == 0x0A || uc == 0x0D || (uc >= 0xA0 && uc <= 0xD7FF)
+               || (uc >= 0xE000 && uc <= 0xFFFD);
+    }
+
+#if defined(KDBXXMLCODEC_SSE2)
+    inline __m128i inRange(__m128i v, ushort lo, ushort hi)
+    {
+        // SSE2 only compares signed 16-bit lanes, so shift everything into the signed range first
+        const __m128i bias = _mm_set1_epi16(static_cast<short>(0x8000));
+        const __m128i x = _mm_xor_si128(v, bias);
+        const __m128i below = _mm_cmplt_epi16(x, _mm_set1_epi16(static_cast<short>(lo ^ 0x8000)));
+        const __m128i above = _mm_cmpgt_epi16(x, _mm_set1_epi16(static_cast<short>(hi ^ 0x8000)));
+        return _mm_andnot_si128(_mm_or_si128(below, above), _mm_set1_epi16(-1));
+    }
+
+    int plainVectorPrefix(const ushort* text, int size)
+    {
+        int i = 0;
+        for (; i + 8 <= size; i += 8) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+            __m128i ok = _mm_or_si128(inRange(v, 0x20, 0x7E), inRange(v, 0xA0, 0xD7FF));
+            ok = _mm_or_si128(ok, inRange(v, 0xE000, 0xFFFD));
+            ok = _mm_or_si128(ok, _mm_cmpeq_epi16(v, _mm_set1_epi16(0x09)));
+            ok = _mm_or_si128(ok, _mm_cmpeq_epi16(v, _mm_set1_epi16(0x0A)));
+            ok = _mm_or_si128(ok, _mm_cmpeq_epi16(v, _mm_set1_epi16(0x0D)));
+            if (_mm_movemask_epi8(ok) != 0xFFFF) {
+                break;
+            }
+        }
+        return i;
+    }
+#elif defined(KDBXXMLCODEC_NEON)
+    inline uint16x8_t inRange(uint16x8_t v, ushort lo, ushort hi)
+    {
+        return vandq_u16(vcgeq_u16(v, vdupq_n_u16(lo)), vcleq_u16(v, vdupq_n_u16(hi)));
+    }
+
+    int plainVectorPrefix(const ushort* text, int size)
+    {
+        int i = 0;
+        for (; i + 8 <= size; i += 8) {
+            const uint16x8_t v = vld1q_u16(reinterpret_cast<const uint16_t*>(text + i));
+            uint16x8_t ok = vorrq_u16(inRange(v, 0x20, 0x7E), inRange(v, 0xA0, 0xD7FF));
+            ok = vorrq_u16(ok, inRange(v, 0xE000, 0xFFFD));
+            ok = vorrq_u16(ok, vceqq_u16(v, vdupq_n_u16(0x09)));
+            ok = vorrq_u16(ok, vceqq_u16(v, vdupq_n_u16(0x0A)));
+            ok = vorrq_u16(ok, vceqq_u16(v, vdupq_n_u16(0x0D)));
+            if (vminvq_u16(ok) != 0xFFFF) {
+                break;
+            }
+        }
+        return i;
+    }
+#else
+    int plainVectorPrefix(const ushort* text, int size)
+    {
+        Q_UNUSED(text);
+        Q_UNUSED(size);
+        return 0;
+    }
+#endif
+
+    const std::array<qint8, 128>& base64DecodeTable()
+    {
+        static const std::array<qint8, 128> table = [] {
+            std::array<qint8, 128> t;
+            t.fill(-1);
+            for (int i = 0; i < 64; ++i) {
+                t[static_cast<uchar>(Base64Alphabet[i])] = static_cast<qint8>(i);
+            }
+            return t;
+        }();
+        return table;
+    }
+} // namespace
+
+namespace KdbxXmlCodec
+{
+    /**
+     * Length of the leading run of characters that are valid in XML 1.0
+     * without further checks. Clean text is scanned eight characters at a
+     * time where SSE2 or NEON is available.
+     */
+    int plainXml10Prefix(const QChar* text, int size)
+    {
+        const auto* data = reinterpret_cast<const ushort*>(text);
+        int i = plainVectorPrefix(data, size);
+        while (i < size && isPlainXml10Char(data[i])) {
+            ++i;
+        }
+        return i;
+    }
+
+    QString stripInvalidXml10Chars(QString str)
+    {
+        // Nearly all strings are clean, return them without detaching
+        const int plain = plainXml10Prefix(str.constData(), str.size());
+        if (plain == str.size()) {
+            return str;
+        }
+
+        for (int i = str.size() - 1; i >= plain; i--) {
+            const QChar ch = str.at(i);
+            const ushort uc = ch.unicode();
+
+            if (ch.isLowSurrogate() && i != 0 && str.at(i - 1).isHighSurrogate()) {
+                // keep valid surrogate pair
+                i--;
+            } else if ((uc < 0x20 && uc != 0x09 && uc != 0x0A && uc != 0x0D) // control characters
+                       || (uc >= 0x7F && uc <= 0x84) // control characters, valid but discouraged by XML
+                       || (uc >= 0x86 && uc <= 0x9F) // control characters, valid but discouraged by XML
+                       || (uc > 0xFFFD) // noncharacter
+                       || ch.isLowSurrogate() // single low surrogate
+                       || ch.isHighSurrogate()) // single high surrogate
+            {
+                qWarning("Stripping invalid XML 1.0 codepoint %x", uc);
+                str.remove(i, 1);
+            }
+        }
+
+        return str;
+    }
+
+    /**
+     * Encode data as padded base64 directly into out, reusing its allocation.
+     */
+    void toBase64(const QByteArray& data, QString& out)
+    {
+        const auto* src = reinterpret_cast<const uchar*>(data.constData());
+        const int size = data.size();
+        out.resize((size + 2) / 3 * 4);
+        QChar* dst = out.data();
+
+        int i = 0;
+        for (; i + 3 <= size; i += 3) {
+            const quint32 triple = (quint32(src[i]) << 16) | (quint32(src[i + 1]) << 8) | src[i + 2];
+            *dst++ = QLatin1Char(Base64Alphabet[(triple >> 18) & 0x3F]);
+            *dst++ = QLatin1Char(Base64Alphabet[(triple >> 12) & 0x3F]);
+            *dst++ = QLatin1Char(Base64Alphabet[(triple >> 6) & 0x3F]);
+            *dst++ = QLatin1Char(Base64Alphabet[triple & 0x3F]);
+        }
+
+        const int remaining = size - i;
+        if (remaining > 0) {
+            quint32 triple = quint32(src[i]) << 16;
+            if (remaining == 2) {
+                triple |= quint32(src[i + 1]) << 8;
+            }
+            *dst++ = QLatin1Char(Base64Alphabet[(triple >> 18) & 0x3F]);
+            *dst++ = QLatin1Char(Base64Alphabet[(triple >> 12) & 0x3F]);
+            *dst++ = remaining == 2 ? QLatin1Char(Base64Alphabet[(triple >> 6) & 0x3F]) : QLatin1Char('=');
+            *dst++ = QLatin1Char('=');
+        }
+    }
+
+    /**
+     * Decode base64 text without an intermediate Latin-1 copy. Input that is
+     * not canonical padded base64 is handed to QByteArray::fromBase64(), so
+     * the result is always the same as with Qt.
+     */
+    QByteArray fromBase64(const QString& text)
+    {
+        const int size = text.size();
+        if (size % 4 != 0) {
+            return QByteArray::fromBase64(text.toLatin1());
+        }
+
+        const auto* src = reinterpret_cast<const ushort*>(text.constData());
+        int padding = 0;
+        if (size > 0 && src[size - 1] == '=') {
+            padding = src[size - 2] == '=' ? 2 : 1;
+        }
+
+        const auto& table = base64DecodeTable();
+        QByteArray out;
+        out.resize(size / 4 * 3 - padding);
+        auto* dst = reinterpret_cast<uchar*>(out.data());
+
+        for (int i = 0, o = 0; i < size; i += 4) {
+            const bool last = i + 4 == size;
+            const int chars = last ? 4 - padding : 4;
+
+            quint32 quad = 0;
+            for (int j = 0; j < 4; ++j) {
+                quint32 value = 0;
+                if (j < chars) {
+                    const ushort ch = src[i + j];
+                    if (ch >= 128 || table[ch] < 0) {
+                        return QByteArray::fromBase64(text.toLatin1());
+                    }
+                    value = static_cast<quint32>(table[ch]);
+                }
+                quad = (quad << 6) | value;
+            }
+
+            dst[o++] = static_cast<uchar>(quad >> 16);
+            if (chars > 2) {
+                dst[o++] = static_cast<uchar>(quad >> 8);
+            }
+            if (chars > 3) {
+                dst[o++] = static_cast<uchar>(quad);
+            }
+        }
+
+        return out;
+    }
+} // namespace KdbxXmlCodec
@@ -0,0 +1,36 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEEPASSXC_KDBXXMLCODEC_H
+#define KEEPASSXC_KDBXXMLCODEC_H
+
+#include <QByteArray>
+#include <QString>
+
+/**
+ * Text kernels used by the KDBX XML reader and writer.
+ */
+namespace KdbxXmlCodec
+{
+    int plainXml10Prefix(const QChar* text, int size);
+    QString stripInvalidXml10Chars(QString str);
+
+    void toBase64(const QByteArray& data, QString& out);
+    QByteArray fromBase64(const QString& text);
+} // namespace KdbxXmlCodec
+
+#endif // KEEPASSXC_KDBXXMLCODEC_H
@@ -16,12 +16,14 @@
  */
 
 #include "KdbxXmlReader.h"
+#include "KdbxXmlCodec.h"
 #include "KeePass2RandomStream.h"
 #include "core/Clock.h"
 #include "core/Endian.h"
 #include "core/Global.h"
 #include "core/Group.h"
 #include "core/Tools.h"
+#include "core/Trace.h"
 #include "streams/qtiocompressor.h"
 
 #include <QBuffer>
@@ -82,6 +84,8 @@ QSharedPointer<Database> KdbxXmlReader::readDatabase(QIODevice* device)
  */
 void KdbxXmlReader::readDatabase(QIODevice* device, Database* db, KeePass2RandomStream* randomStream)
 {
+    TRACE_SPAN("KdbxXmlReader::readDatabase");
+
     m_error = false;
     m_errorStr.clear();
 
@@ -1020,7 +1024,7 @@ QString KdbxXmlReader::readString(bool& isProtected, bool& protectInMemory)
     QString value = m_xml.readElementText();
 
     if (isProtected && !value.isEmpty()) {
-        QByteArray ciphertext = QByteArray::fromBase64(value.toLatin1());
+        QByteArray ciphertext = KdbxXmlCodec::fromBase64(value);
         bool ok;
         QByteArray plaintext = m_randomStream->process(ciphertext, &ok);
         if (!ok) {
@@ -1133,7 +1137,7 @@ QByteArray KdbxXmlReader::readBinary()
     QXmlStreamAttributes attr = m_xml.attributes();
     bool isProtected = isTrueValue(attr.value("Protected"));
     QString value = m_xml.readElementText();
-    QByteArray data = QByteArray::fromBase64(value.toLatin1());
+    QByteArray data = KdbxXmlCodec::fromBase64(value);
 
     if (isProtected && !data.isEmpty()) {
         bool ok;
@@ -22,7 +22,7 @@
 #include <QMap>
 
 #include "core/Endian.h"
-#include "crypto/CryptoHash.h"
+#include "format/KdbxXmlCodec.h"
 #include "format/KeePass2RandomStream.h"
 #include "streams/qtiocompressor.h"
 
@@ -93,6 +93,36 @@ QString KdbxXmlWriter::errorString()
     return m_errorStr;
 }
 
+/**
+ * Key under which an attachment is deduplicated when saving. This is the
+ * cached content digest of the attachment, so no data is hashed here.
+ *
+ * @param db database being written
+ * @param entry entry or history item owning the attachment
+ * @param key attachment name
+ * @return deduplication key
+ */
+QByteArray KdbxXmlWriter::binaryDedupKey(const Database* db, const Entry* entry, const QString& key)
+{
+    QByteArray dedupKey = entry->attachments()->digest(key);
+#ifdef WITH_XC_KEESHARE
+    // Namespace KeeShare attachments so they don't get deduplicated together with attachments
+    // from other databases. Prevents potential filesize side channels.
+    auto group = entry->group();
+    if (!group && entry->historyOwner()) {
+        group = entry->historyOwner()->group();
+    }
+    if (group && group->isShared()) {
+        dedupKey.append(group->uuid().toRfc4122());
+    } else {
+        dedupKey.append(db->uuid().toRfc4122());
+    }
+#else
+    Q_UNUSED(db);
+#endif
+    return dedupKey;
+}
+
 /**
  * Generate a map of entry attachments to deduplicated attachment index IDs.
  * This is basically duplicated code from Kdbx4Writer.cpp for KDBX 3 compatibility.
@@ -107,28 +137,11 @@ void KdbxXmlWriter::fillBinaryIdxMap()
     for (Entry* entry : allEntries) {
         const QList<QString> attachmentKeys = entry->attachments()->keys();
         for (const QString& key : attachmentKeys) {
-            QByteArray data = entry->attachments()->value(key);
-            CryptoHash hash(CryptoHash::Sha256);
-#ifdef WITH_XC_KEESHARE
-            // Namespace KeeShare attachments so they don't get deduplicated together with attachments
-            // from other databases. Prevents potential filesize side channels.
-            auto group = entry->group();
-            if (!group && entry->historyOwner()) {
-                group = entry->historyOwner()->group();
+            const auto dedupKey = binaryDedupKey(m_db, entry, key);
+            if (!writtenAttachments.contains(dedupKey)) {
+                writtenAttachments.insert(dedupKey, nextIdx++);
             }
-            if (group && group->isShared()) {
-                hash.addData(group->uuid().toByteArray());
-            } else {
-                hash.addData(m_db->uuid().toByteArray());
-            }
-#endif
-            hash.addData(data);
-
-            const auto hashResult = hash.result();
-            if (!writtenAttachments.contains(hashResult)) {
-                writtenAttachments.insert(hashResult, nextIdx++);
-            }
-            m_binaryIdxMap.insert(qMakePair(entry, key), writtenAttachments.value(hashResult));
+            m_binaryIdxMap.insert(qMakePair(entry, key), writtenAttachments.value(dedupKey));
         }
     }
 }
@@ -255,7 +268,8 @@ void KdbxXmlWriter::writeBinaries()
         }
 
         if (!data.isEmpty()) {
-            m_xml.writeCharacters(QString::fromLatin1(data.toBase64()));
+            KdbxXmlCodec::toBase64(data, m_base64Buffer);
+            m_xml.writeCharacters(m_base64Buffer);
         }
         m_xml.writeEndElement();
     }
@@ -441,7 +455,7 @@ void KdbxXmlWriter::writeEntry(const Entry* entry)
                 if (!ok) {
                     raiseError(m_randomStream->errorString());
                 }
-                value = QString::fromLatin1(rawData.toBase64());
+                KdbxXmlCodec::toBase64(rawData, value);
             } else {
                 m_xml.writeAttribute("ProtectInMemory", "True");
                 value = entry->attributes()->value(key);
@@ -451,7 +465,7 @@ void KdbxXmlWriter::writeEntry(const Entry* entry)
         }
 
         if (!value.isEmpty()) {
-            m_xml.writeCharacters(stripInvalidXml10Chars(value));
+            m_xml.writeCharacters(KdbxXmlCodec::stripInvalidXml10Chars(value));
         }
         m_xml.writeEndElement();
 
@@ -528,7 +542,7 @@ void KdbxXmlWriter::writeString(const QString& qualifiedName, const QString& str
     if (string.isEmpty()) {
         m_xml.writeEmptyElement(qualifiedName);
     } else {
-        m_xml.writeTextElement(qualifiedName, stripInvalidXml10Chars(string));
+        m_xml.writeTextElement(qualifiedName, KdbxXmlCodec::stripInvalidXml10Chars(string));
     }
 }
 
@@ -562,14 +576,14 @@ void KdbxXmlWriter::writeDateTime(const QString& qualifiedName, const QDateTime&
     } else {
         qint64 secs = QDateTime(QDate(1, 1, 1), QTime(0, 0, 0, 0), Qt::UTC).secsTo(dateTime);
         QByteArray secsBytes = Endian::sizedIntToBytes(secs, KeePass2::BYTEORDER);
-        dateTimeStr = QString::fromLatin1(secsBytes.toBase64());
+        KdbxXmlCodec::toBase64(secsBytes, dateTimeStr);
     }
     writeString(qualifiedName, dateTimeStr);
 }
 
 void KdbxXmlWriter::writeUuid(const QString& qualifiedName, const QUuid& uuid)
 {
-    writeString(qualifiedName, uuid.toRfc4122().toBase64());
+    writeBinary(qualifiedName, uuid.toRfc4122());
 }
 
 void KdbxXmlWriter::writeUuid(const QString& qualifiedName, const Group* group)
@@ -592,7 +606,8 @@ void KdbxXmlWriter::writeUuid(const QString& qualifiedName, const Entry* entry)
 
 void KdbxXmlWriter::writeBinary(const QString& qualifiedName, const QByteArray& ba)
 {
-    writeString(qualifiedName, QString::fromLatin1(ba.toBase64()));
+    KdbxXmlCodec::toBase64(ba, m_base64Buffer);
+    writeString(qualifiedName, m_base64Buffer);
 }
 
 void KdbxXmlWriter::writeTriState(const QString& qualifiedName, Group::TriState triState)
@@ -620,30 +635,6 @@ QString KdbxXmlWriter::colorPartToString(int value)
     return str;
 }
 
-QString KdbxXmlWriter::stripInvalidXml10Chars(QString str)
-{
-    for (int i = str.size() - 1; i >= 0; i--) {
-        const QChar ch = str.at(i);
-        const ushort uc = ch.unicode();
-
-        if (ch.isLowSurrogate() && i != 0 && str.at(i - 1).isHighSurrogate()) {
-            // keep valid surrogate pair
-            i--;
-        } else if ((uc < 0x20 && uc != 0x09 && uc != 0x0A && uc != 0x0D) // control characters
-                   || (uc >= 0x7F && uc <= 0x84) // control characters, valid but discouraged by XML
-                   || (uc >= 0x86 && uc <= 0x9F) // control characters, valid but discouraged by XML
-                   || (uc > 0xFFFD) // noncharacter
-                   || ch.isLowSurrogate() // single low surrogate
-                   || ch.isHighSurrogate()) // single high surrogate
-        {
-            qWarning("Stripping invalid XML 1.0 codepoint %x", uc);
-            str.remove(i, 1);
-        }
-    }
-
-    return str;
-}
-
 void KdbxXmlWriter::raiseError(const QString& errorMessage)
 {
     m_error = true;
@@ -48,6 +48,8 @@ public:
     bool hasError();
     QString errorString();
 
+    static QByteArray binaryDedupKey(const Database* db, const Entry* entry, const QString& key);
+
 private:
     void fillBinaryIdxMap();
 
@@ -79,7 +81,6 @@ private:
     void writeBinary(const QString& qualifiedName, const QByteArray& ba);
     void writeTriState(const QString& qualifiedName, Group::TriState triState);
     QString colorPartToString(int value);
-    QString stripInvalidXml10Chars(QString str);
 
     void raiseError(const QString& errorMessage);
 
@@ -93,6 +94,8 @@ private:
     KeePass2RandomStream* m_randomStream = nullptr;
     BinaryIdxMap m_binaryIdxMap;
     QByteArray m_headerHash;
+    // Reused for base64 encoding so binaries don't allocate per element
+    QString m_base64Buffer;
 
     bool m_error = false;
 
@@ -33,6 +33,7 @@
 
 #include "autotype/AutoType.h"
 #include "core/AsyncTask.h"
+#include "core/DatabaseReloader.h"
 #include "core/EntrySearcher.h"
 #include "core/Merger.h"
 #include "core/Tools.h"
@@ -474,6 +475,14 @@ void DatabaseWidget::replaceDatabase(QSharedPointer<Database> db)
 {
     Q_ASSERT(!isEntryEditActive() && !isGroupEditActive());
 
+    // Let a background save finish while its result is still reported for the current database.
+    // This processes events, so the widget may be gone afterwards.
+    QPointer<DatabaseWidget> self(this);
+    m_db->waitForBackgroundSave();
+    if (!self) {
+        return;
+    }
+
     // Save off new parent UUID which will be valid when creating a new entry
     QUuid newParentUuid;
     if (m_newParent) {
@@ -609,11 +618,13 @@ void DatabaseWidget::restoreSelectedEntries()
         selectedEntries.append(m_entryView->entryFromIndex(index));
     }
 
+    m_db->beginBulkUpdate();
     for (auto* entry : selectedEntries) {
         if (entry->previousParentGroup()) {
             entry->setGroup(entry->previousParentGroup());
         }
     }
+    m_db->endBulkUpdate();
 }
 
 void DatabaseWidget::deleteEntries(QList<Entry*> selectedEntries, bool confirm)
@@ -1293,6 +1304,7 @@ void DatabaseWidget::connectDatabaseSignals()
     connect(m_db.data(), &Database::modified, this, &DatabaseWidget::databaseModified);
     connect(m_db.data(), &Database::modified, this, &DatabaseWidget::onDatabaseModified);
     connect(m_db.data(), &Database::databaseSaved, this, &DatabaseWidget::databaseSaved);
+    connect(m_db.data(), &Database::saveFinished, this, &DatabaseWidget::onBackgroundSaveFinished);
     connect(m_db.data(), &Database::databaseFileChanged, this, &DatabaseWidget::reloadDatabaseFile);
     connect(m_db.data(), &Database::databaseNonDataChanged, this, &DatabaseWidget::databaseNonDataChanged);
     connect(m_db.data(), &Database::databaseNonDataChanged, this, &DatabaseWidget::onDatabaseNonDataChanged);
@@ -1818,7 +1830,7 @@ void DatabaseWidget::onDatabaseModified()
         return;
     }
     if (!m_blockAutoSave && autosaveAfterEveryChangeConfig) {
-        save();
+        autosave();
     } else {
         // Only block once, then reset
         m_blockAutoSave = false;
@@ -1834,13 +1846,52 @@ void DatabaseWidget::onAutosaveDelayTimeout()
         return;
     }
     if (!m_blockAutoSave) {
-        save();
+        autosave();
     } else {
         // Only block once, then reset
         m_blockAutoSave = false;
     }
 }
 
+/**
+ * Save the database without blocking the user interface.
+ * Errors are reported once the save finished.
+ */
+void DatabaseWidget::autosave()
+{
+    // New databases ask for a filename first
+    if (m_db->filePath().isEmpty()) {
+        save();
+        return;
+    }
+
+    if (isLocked()) {
+        return;
+    }
+
+    m_autosaveTimer->stop();
+    m_db->saveInBackground(saveAction(), backupFilePath());
+}
+
+void DatabaseWidget::onBackgroundSaveFinished(bool success, const QString& error)
+{
+    if (success) {
+        m_saveAttempts = 0;
+        return;
+    }
+
+    ++m_saveAttempts;
+    if (askToDisableSafeSaves()) {
+        m_db->saveInBackground(saveAction(), backupFilePath());
+        return;
+    }
+
+    showMessage(tr("Writing the database failed: %1").arg(error),
+                MessageWidget::Error,
+                true,
+                MessageWidget::LongAutoHideTimeout);
+}
+
 void DatabaseWidget::triggerAutosaveTimer()
 {
     m_autosaveTimer->stop();
@@ -1984,14 +2035,22 @@ bool DatabaseWidget::lock()
         return isLocked();
     }
 
-    // Don't try to lock the database while saving, this will cause a deadlock
-    if (m_db->isSaving()) {
+    m_attemptingLock = true;
+
+    // Let a background save finish before the data is released. Events are processed meanwhile,
+    // m_attemptingLock keeps them from locking again. Don't try to lock the database during a
+    // synchronous save, this will cause a deadlock
+    QPointer<DatabaseWidget> self(this);
+    const bool saveFinished = m_db->waitForBackgroundSave();
+    if (!self) {
+        return false;
+    }
+    if (!saveFinished) {
+        m_attemptingLock = false;
         QTimer::singleShot(200, this, SLOT(lock()));
         return false;
     }
 
-    m_attemptingLock = true;
-
     emit databaseLockRequested();
 
     // Force close any modal widgets associated with this widget
@@ -2116,7 +2175,27 @@ void DatabaseWidget::reloadDatabaseFile()
 
     QString error;
     auto db = QSharedPointer<Database>::create(m_db->filePath());
+    // Skip the KDF if the file header is the one we read or wrote last, e.g. after a sync client touched it
+    db->reuseTransformedKeyFrom(*m_db);
     if (db->open(database()->key(), &error)) {
+        // Without local changes, apply the changes to the open database in place
+        // so models, views and integrations only process what actually changed
+        if (!m_db->isModified() && !db->hasNonDataChanges()) {
+            DatabaseReloader reloader(db.data(), m_db.data());
+            if (reloader.reload()) {
+                // Nothing was saved, keep save handlers such as KeeShare exports from running
+                m_db->markAsUnmodified();
+                m_db->updateCommonUsernames();
+                m_db->updateTagList();
+                processAutoOpen();
+                m_blockAutoSave = false;
+                m_entryView->setDisabled(false);
+                m_groupView->setDisabled(false);
+                m_tagView->setDisabled(false);
+                return;
+            }
+        }
+
         if (m_db->isModified() || db->hasNonDataChanges()) {
             // Ask if we want to merge changes into new database
             auto result = MessageBox::question(
@@ -2325,6 +2404,17 @@ bool DatabaseWidget::save()
         return saveAs();
     }
 
+    // Wait for a running background save, changes made after it started are saved below
+    if (m_db->isSaving()) {
+        QPointer<DatabaseWidget> self(this);
+        if (!m_db->waitForBackgroundSave() || !self) {
+            return false;
+        }
+        if (!m_db->isModified()) {
+            return true;
+        }
+    }
+
     // Prevent recursions and infinite save loops
     m_blockAutoSave = true;
     ++m_saveAttempts;
@@ -2337,6 +2427,25 @@ bool DatabaseWidget::save()
         return true;
     }
 
+    if (askToDisableSafeSaves()) {
+        return save();
+    }
+
+    showMessage(tr("Writing the database failed: %1").arg(errorMessage),
+                MessageWidget::Error,
+                true,
+                MessageWidget::LongAutoHideTimeout);
+
+    return false;
+}
+
+/**
+ * Offer to disable safe saves once saving failed three times in a row.
+ *
+ * @return true if safe saves were disabled and saving should be retried
+ */
+bool DatabaseWidget::askToDisableSafeSaves()
+{
     if (m_saveAttempts > 2 && config()->get(Config::UseAtomicSaves).toBool()) {
         // Saving failed 3 times, issue a warning and attempt to resolve
         auto result = MessageBox::question(this,
@@ -2348,15 +2457,9 @@ bool DatabaseWidget::save()
                                            MessageBox::Disable);
         if (result == MessageBox::Disable) {
             config()->set(Config::UseAtomicSaves, false);
-            return save();
+            return true;
         }
     }
-
-    showMessage(tr("Writing the database failed: %1").arg(errorMessage),
-                MessageWidget::Error,
-                true,
-                MessageWidget::LongAutoHideTimeout);
-
     return false;
 }
 
@@ -2410,15 +2513,38 @@ bool DatabaseWidget::performSave(QString& errorMessage, const QString& fileName)
     }
     QApplication::processEvents();
 
-    Database::SaveAction saveAction = Database::Atomic;
-    if (!config()->get(Config::UseAtomicSaves).toBool()) {
-        if (config()->get(Config::UseDirectWriteSaves).toBool()) {
-            saveAction = Database::DirectWrite;
-        } else {
-            saveAction = Database::TempFile;
-        }
+    bool ok;
+    if (fileName.isEmpty()) {
+        ok = m_db->save(saveAction(), backupFilePath(), &errorMessage);
+    } else {
+        ok = m_db->saveAs(fileName, saveAction(), backupFilePath(), &errorMessage);
+    }
+
+    // Return control
+    if (mainWindow) {
+        mainWindow->setDisabled(false);
+    }
+
+    if (focusWidget && focusWidget->isVisible()) {
+        focusWidget->setFocus();
+    }
+
+    return ok;
+}
+
+Database::SaveAction DatabaseWidget::saveAction() const
+{
+    if (config()->get(Config::UseAtomicSaves).toBool()) {
+        return Database::Atomic;
     }
+    if (config()->get(Config::UseDirectWriteSaves).toBool()) {
+        return Database::DirectWrite;
+    }
+    return Database::TempFile;
+}
 
+QString DatabaseWidget::backupFilePath() const
+{
     QString backupFilePath;
     if (config()->get(Config::BackupBeforeSave).toBool()) {
         backupFilePath = config()->get(Config::BackupFilePathPattern).toString();
@@ -2438,24 +2564,7 @@ bool DatabaseWidget::performSave(QString& errorMessage, const QString& fileName)
             }
         }
     }
-
-    bool ok;
-    if (fileName.isEmpty()) {
-        ok = m_db->save(saveAction, backupFilePath, &errorMessage);
-    } else {
-        ok = m_db->saveAs(fileName, saveAction, backupFilePath, &errorMessage);
-    }
-
-    // Return control
-    if (mainWindow) {
-        mainWindow->setDisabled(false);
-    }
-
-    if (focusWidget && focusWidget->isVisible()) {
-        focusWidget->setFocus();
-    }
-
-    return ok;
+    return backupFilePath;
 }
 
 /**
@@ -277,6 +277,7 @@ private slots:
     void onDatabaseModified();
     void onDatabaseNonDataChanged();
     void onAutosaveDelayTimeout();
+    void onBackgroundSaveFinished(bool success, const QString& error);
     void connectDatabaseSignals();
     void loadDatabase(bool accepted);
     void unlockDatabase(bool accepted);
@@ -297,6 +298,10 @@ private:
     void openDatabaseFromEntry(const Entry* entry, bool inBackground = true);
     void performIconDownloads(const QList<Entry*>& entries, bool force = false, bool downloadInBackground = false);
     bool performSave(QString& errorMessage, const QString& fileName = {});
+    bool askToDisableSafeSaves();
+    void autosave();
+    Database::SaveAction saveAction() const;
+    QString backupFilePath() const;
 
     QSharedPointer<Database> m_db;
 
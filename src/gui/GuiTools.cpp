@@ -124,12 +124,16 @@ namespace GuiTools
             selectedEntries << entry;
         }
 
-        for (auto entry : asConst(selectedEntries)) {
-            if (permanent) {
-                delete entry;
-            } else {
-                entry->database()->recycleEntry(entry);
-            }
+        if (selectedEntries.isEmpty()) {
+            return 0;
+        }
+
+        // All entries belong to the same database, apply the changes as a single bulk update
+        auto db = selectedEntries.first()->database();
+        if (permanent) {
+            db->deleteEntries(selectedEntries);
+        } else {
+            db->recycleEntries(selectedEntries);
         }
         return selectedEntries.size();
     }
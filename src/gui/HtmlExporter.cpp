@@ -26,6 +26,9 @@
 
 namespace
 {
+    // Entry rows are collected up to this size before being written to the device
+    constexpr int WriteBufferSize = 64 * 1024;
+
     QString PixmapToHTML(const QPixmap& pixmap)
     {
         if (pixmap.isNull()) {
@@ -127,6 +130,16 @@ QString HtmlExporter::errorString() const
     return m_error;
 }
 
+bool HtmlExporter::write(QIODevice& device, const QString& html)
+{
+    const auto data = html.toUtf8();
+    if (device.write(data) == -1) {
+        m_error = device.errorString();
+        return false;
+    }
+    return true;
+}
+
 bool HtmlExporter::exportDatabase(QIODevice* device,
                                   const QSharedPointer<const Database>& db,
                                   bool sorted,
@@ -174,8 +187,7 @@ bool HtmlExporter::exportDatabase(QIODevice* device,
     const auto footer = QString("</body>"
                                 "</html>");
 
-    if (device->write(header.toUtf8()) == -1) {
-        m_error = device->errorString();
+    if (!write(*device, header)) {
         return false;
     }
 
@@ -185,12 +197,7 @@ bool HtmlExporter::exportDatabase(QIODevice* device,
         }
     }
 
-    if (device->write(footer.toUtf8()) == -1) {
-        m_error = device->errorString();
-        return false;
-    }
-
-    return true;
+    return write(*device, footer);
 }
 
 bool HtmlExporter::writeGroup(QIODevice& device, const Group& group, QString path, bool sorted, bool ascending)
@@ -225,8 +232,7 @@ bool HtmlExporter::writeGroup(QIODevice& device, const Group& group, QString pat
         }
 
         // Output it
-        if (device.write(header.toUtf8()) == -1) {
-            m_error = device.errorString();
+        if (!write(device, header)) {
             return false;
         }
     }
@@ -259,12 +265,19 @@ bool HtmlExporter::writeGroup(QIODevice& device, const Group& group, QString pat
         table +=
             "<td style=\"padding-bottom: 0.5em;\"><table width=\"100%\">" + caption + formatted_entry + "</table></td>";
         table += "</tr>";
+
+        // Large groups are written out in pieces
+        if (table.size() >= WriteBufferSize) {
+            if (!write(device, table)) {
+                return false;
+            }
+            table.clear();
+        }
     }
 
-    // Output the complete table of this group
+    // Output the remainder of the table of this group
     table.append("</table>\n");
-    if (device.write(table.toUtf8()) == -1) {
-        m_error = device.errorString();
+    if (!write(device, table)) {
         return false;
     }
 
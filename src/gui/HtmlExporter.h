@@ -44,6 +44,7 @@ private:
                     QString path = QString(),
                     bool sorted = true,
                     bool ascending = true);
+    bool write(QIODevice& device, const QString& html);
 
     QString m_error;
 };
@@ -17,6 +17,8 @@
 
 #include "SortFilterHideProxyModel.h"
 
+#include "core/Global.h"
+
 SortFilterHideProxyModel::SortFilterHideProxyModel(QObject* parent)
     : QSortFilterProxyModel(parent)
 {
@@ -36,6 +38,77 @@ void SortFilterHideProxyModel::hideColumn(int column, bool hide)
     invalidateFilter();
 }
 
+void SortFilterHideProxyModel::sort(int column, Qt::SortOrder order)
+{
+    m_requestedSortColumn = column;
+    m_requestedSortOrder = order;
+
+    if (m_sortInSource) {
+        // Keep the order of the source model, which sorts itself
+        QSortFilterProxyModel::sort(-1, order);
+        sourceModel()->sort(column, order);
+    } else {
+        QSortFilterProxyModel::sort(column, order);
+    }
+}
+
+/**
+ * Let the source model sort its rows, e.g. when it only exposes part of them.
+ * The last requested sort order is applied in the new mode.
+ */
+void SortFilterHideProxyModel::setSortInSource(bool sortInSource)
+{
+    if (m_sortInSource == sortInSource) {
+        return;
+    }
+
+    m_sortInSource = sortInSource;
+    sort(m_requestedSortColumn, m_requestedSortOrder);
+}
+
+void SortFilterHideProxyModel::setSourceModel(QAbstractItemModel* sourceModel)
+{
+    // Only drop our own connections, the base class manages its connections to the source model itself
+    for (const auto& connection : asConst(m_sourceConnections)) {
+        disconnect(connection);
+    }
+    m_sourceConnections.clear();
+    invalidateSortKeys();
+
+    // Connect before the base class so the keys are up to date when it sorts in reaction to the same signals
+    if (sourceModel) {
+        const auto invalidate = &SortFilterHideProxyModel::invalidateSortKeys;
+        m_sourceConnections = {
+            connect(sourceModel, &QAbstractItemModel::dataChanged, this, &SortFilterHideProxyModel::sourceDataChanged),
+            connect(sourceModel, &QAbstractItemModel::rowsInserted, this, invalidate),
+            connect(sourceModel, &QAbstractItemModel::rowsRemoved, this, invalidate),
+            connect(sourceModel, &QAbstractItemModel::rowsMoved, this, invalidate),
+            connect(sourceModel, &QAbstractItemModel::layoutChanged, this, invalidate),
+            connect(sourceModel, &QAbstractItemModel::modelReset, this, invalidate)};
+    }
+
+    QSortFilterProxyModel::setSourceModel(sourceModel);
+}
+
+void SortFilterHideProxyModel::invalidateSortKeys()
+{
+    m_sortKeysColumn = -1;
+    m_sortKeys.clear();
+    m_validSortKeys.clear();
+}
+
+void SortFilterHideProxyModel::sourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight)
+{
+    if (topLeft.parent().isValid()) {
+        return;
+    }
+
+    const int last = qMin(bottomRight.row(), m_validSortKeys.size() - 1);
+    if (topLeft.row() <= last) {
+        m_validSortKeys.fill(false, topLeft.row(), last + 1);
+    }
+}
+
 bool SortFilterHideProxyModel::filterAcceptsColumn(int sourceColumn, const QModelIndex& sourceParent) const
 {
     Q_UNUSED(sourceParent)
@@ -45,6 +118,10 @@ bool SortFilterHideProxyModel::filterAcceptsColumn(int sourceColumn, const QMode
 
 bool SortFilterHideProxyModel::lessThan(const QModelIndex& left, const QModelIndex& right) const
 {
+    if (!left.parent().isValid() && !right.parent().isValid()) {
+        return sortKey(left).compare(sortKey(right)) < 0;
+    }
+
     auto leftData = sourceModel()->data(left, sortRole());
     auto rightData = sourceModel()->data(right, sortRole());
     if (leftData.type() == QVariant::String) {
@@ -53,3 +130,31 @@ bool SortFilterHideProxyModel::lessThan(const QModelIndex& left, const QModelInd
 
     return QSortFilterProxyModel::lessThan(left, right);
 }
+
+/**
+ * Sort key of a top level source row, computed on first use and cached per
+ * row until the row changes or another column or sort role is used.
+ */
+const SortKey& SortFilterHideProxyModel::sortKey(const QModelIndex& index) const
+{
+    // sortRoleChanged() requires Qt 5.15, so the role is compared here instead
+    if (index.column() != m_sortKeysColumn || sortRole() != m_sortKeysRole) {
+        m_sortKeysColumn = index.column();
+        m_sortKeysRole = sortRole();
+        m_sortKeys.clear();
+        m_validSortKeys.clear();
+    }
+
+    const int row = index.row();
+    if (row >= m_sortKeys.size()) {
+        const int rows = qMax(row + 1, sourceModel()->rowCount());
+        m_sortKeys.resize(rows);
+        m_validSortKeys.resize(rows);
+    }
+
+    if (!m_validSortKeys.testBit(row)) {
+        m_sortKeys[row] = SortKey(sourceModel()->data(index, sortRole()), m_collator);
+        m_validSortKeys.setBit(row);
+    }
+    return m_sortKeys.at(row);
+}
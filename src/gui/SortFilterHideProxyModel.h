@@ -22,6 +22,8 @@
 #include <QCollator>
 #include <QSortFilterProxyModel>
 
+#include "gui/SortKey.h"
+
 class SortFilterHideProxyModel : public QSortFilterProxyModel
 {
     Q_OBJECT
@@ -30,14 +32,31 @@ public:
     explicit SortFilterHideProxyModel(QObject* parent = nullptr);
     Qt::DropActions supportedDragActions() const override;
     void hideColumn(int column, bool hide);
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+    void setSortInSource(bool sortInSource);
+    void setSourceModel(QAbstractItemModel* sourceModel) override;
 
 protected:
     bool filterAcceptsColumn(int sourceColumn, const QModelIndex& sourceParent) const override;
     bool lessThan(const QModelIndex& left, const QModelIndex& right) const override;
 
+private slots:
+    void invalidateSortKeys();
+    void sourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight);
+
 private:
+    const SortKey& sortKey(const QModelIndex& index) const;
+
     QBitArray m_hiddenColumns;
     QCollator m_collator;
+    bool m_sortInSource = false;
+    int m_requestedSortColumn = -1;
+    Qt::SortOrder m_requestedSortOrder = Qt::AscendingOrder;
+    QList<QMetaObject::Connection> m_sourceConnections;
+    mutable int m_sortKeysColumn = -1;
+    mutable int m_sortKeysRole = -1;
+    mutable QVector<SortKey> m_sortKeys;
+    mutable QBitArray m_validSortKeys;
 };
 
 #endif // KEEPASSX_SORTFILTERHIDEPROXYMODEL_H
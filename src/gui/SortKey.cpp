@@ -0,0 +1,87 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SortKey.h"
+
+#include <QDateTime>
+
+namespace
+{
+    template <typename T> int compareValues(const T& left, const T& right)
+    {
+        return (right < left) - (left < right);
+    }
+} // namespace
+
+SortKey::SortKey(const QVariant& value, const QCollator& collator)
+{
+    if (value.userType() == QMetaType::QString) {
+        m_text = collator.sortKey(value.toString());
+    } else {
+        m_value = value;
+    }
+}
+
+/**
+ * Compare two keys. Invalid values sort last, like in QSortFilterProxyModel::lessThan(),
+ * and text sorts after all other values.
+ *
+ * @return negative, zero or positive if this key sorts before, equal or after the other key
+ */
+int SortKey::compare(const SortKey& other) const
+{
+    const bool invalid = !m_text && !m_value.isValid();
+    const bool otherInvalid = !other.m_text && !other.m_value.isValid();
+    if (invalid || otherInvalid) {
+        return compareValues(invalid, otherInvalid);
+    }
+
+    if (m_text || other.m_text) {
+        if (m_text && other.m_text) {
+            return m_text->compare(*other.m_text);
+        }
+        return m_text ? 1 : -1;
+    }
+
+    switch (m_value.userType()) {
+    case QMetaType::Bool:
+    case QMetaType::Int:
+    case QMetaType::Long:
+    case QMetaType::LongLong:
+    case QMetaType::Short:
+    case QMetaType::Char:
+    case QMetaType::SChar:
+        return compareValues(m_value.toLongLong(), other.m_value.toLongLong());
+    case QMetaType::UInt:
+    case QMetaType::ULong:
+    case QMetaType::ULongLong:
+    case QMetaType::UShort:
+    case QMetaType::UChar:
+        return compareValues(m_value.toULongLong(), other.m_value.toULongLong());
+    case QMetaType::Float:
+    case QMetaType::Double:
+        return compareValues(m_value.toDouble(), other.m_value.toDouble());
+    case QMetaType::QDate:
+        return compareValues(m_value.toDate(), other.m_value.toDate());
+    case QMetaType::QTime:
+        return compareValues(m_value.toTime(), other.m_value.toTime());
+    case QMetaType::QDateTime:
+        return compareValues(m_value.toDateTime(), other.m_value.toDateTime());
+    default:
+        return m_value.toString().compare(other.m_value.toString());
+    }
+}
@@ -0,0 +1,46 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEEPASSXC_SORTKEY_H
+#define KEEPASSXC_SORTKEY_H
+
+#include <QCollator>
+#include <QVariant>
+
+#include <optional>
+
+/**
+ * Precomputed key to sort a model value.
+ *
+ * Strings are turned into collation keys once, comparing two keys is then
+ * a plain byte comparison instead of a locale aware string comparison.
+ * Keys are immutable and can be compared from any thread.
+ */
+class SortKey
+{
+public:
+    SortKey() = default;
+    SortKey(const QVariant& value, const QCollator& collator);
+
+    int compare(const SortKey& other) const;
+
+private:
+    QVariant m_value;
+    std::optional<QCollatorSortKey> m_text;
+};
+
+#endif // KEEPASSXC_SORTKEY_H
@@ -159,6 +159,9 @@ void DatabaseSettingsWidgetEncryption::initialize()
     // Set up KDF algorithms
     loadKdfAlgorithms();
 
+    m_ui->compressionLevelSpinBox->setValue(m_db->compressionLevel());
+    m_ui->compressionLevelSpinBox->setEnabled(m_db->compressionAlgorithm() != Database::CompressionNone);
+
     // Perform Benchmark if requested
     if (isNewDatabase) {
         if (IS_ARGON2(m_ui->kdfComboBox->currentData())) {
@@ -263,6 +266,9 @@ bool DatabaseSettingsWidgetEncryption::saveSettings()
         return false;
     }
 
+    // Compression does not affect the key, save it without re-transforming
+    m_db->setCompressionLevel(m_ui->compressionLevelSpinBox->value());
+
     if (m_initWithAdvanced != isAdvancedMode()) {
         // Switched from basic <-> advanced mode, need to recalculate everything
         m_isDirty = true;
@@ -20,6 +20,9 @@
 #include <QFont>
 #include <QMimeData>
 #include <QPalette>
+#include <QtConcurrent>
+
+#include <numeric>
 
 #include "core/Clock.h"
 #include "core/Entry.h"
@@ -28,6 +31,7 @@
 #include "core/PasswordHealth.h"
 #include "gui/DatabaseIcons.h"
 #include "gui/Icons.h"
+#include "gui/SortKey.h"
 #include "gui/styles/StateColorPalette.h"
 #ifdef Q_OS_MACOS
 #include "gui/osutils/macutils/MacUtils.h"
@@ -39,6 +43,11 @@ EntryModel::EntryModel(QObject* parent)
     , HiddenContentDisplay(QString("\u25cf").repeated(6))
 {
     connect(config(), &Config::changed, this, &EntryModel::onConfigChanged);
+
+    m_sortTimer.setSingleShot(true);
+    m_sortTimer.setInterval(0);
+    connect(&m_sortTimer, &QTimer::timeout, this, &EntryModel::startSort);
+    connect(&m_sortWatcher, &QFutureWatcher<QVector<int>>::finished, this, &EntryModel::applySort);
 }
 
 Entry* EntryModel::entryFromIndex(const QModelIndex& index) const
@@ -49,8 +58,8 @@ Entry* EntryModel::entryFromIndex(const QModelIndex& index) const
 
 QModelIndex EntryModel::indexFromEntry(Entry* entry) const
 {
-    int row = m_entries.indexOf(entry);
-    if (row >= 0) {
+    int row = rowFromEntry(entry);
+    if (row >= 0 && row < rowCount()) {
         return index(row, 1);
     }
     return {};
@@ -62,6 +71,7 @@ void EntryModel::setGroup(Group* group)
         return;
     }
 
+    finishEntriesChange();
     beginResetModel();
 
     severConnections();
@@ -69,7 +79,10 @@ void EntryModel::setGroup(Group* group)
     m_group = group;
     m_allGroups.clear();
     m_entries = group->entries();
+    resetRows();
     m_orgEntries.clear();
+    m_virtualized = false;
+    invalidateSort();
 
     makeConnections(group);
 
@@ -78,6 +91,7 @@ void EntryModel::setGroup(Group* group)
 
 void EntryModel::setEntries(const QList<Entry*>& entries)
 {
+    finishEntriesChange();
     beginResetModel();
 
     severConnections();
@@ -85,27 +99,197 @@ void EntryModel::setEntries(const QList<Entry*>& entries)
     m_group = nullptr;
     m_allGroups.clear();
     m_entries = entries;
-    m_orgEntries = entries;
-
-    for (const auto entry : asConst(m_entries)) {
+    resetRows();
+    m_orgEntries.clear();
+    m_orgEntries.reserve(entries.size());
+    for (const auto entry : entries) {
+        m_orgEntries.insert(entry);
         if (entry->group()) {
             m_allGroups.insert(entry->group());
         }
     }
 
-    for (const auto group : m_allGroups) {
+    for (const auto group : asConst(m_allGroups)) {
         makeConnections(group);
     }
 
+    // Large results are exposed in batches and sorted here instead of the proxy model
+    m_virtualized = entries.size() > VirtualizationThreshold;
+    m_fetchedRows = m_virtualized ? FetchBatchSize : entries.size();
+    invalidateSort();
+    if (m_virtualized && m_sortColumn >= 0) {
+        m_sortTimer.start();
+    }
+
     endResetModel();
 }
 
+/**
+ * Large search results are virtualized: only the first rows are exposed to
+ * views, more rows are provided through fetchMore() while scrolling, and
+ * sorting is done by the model on a background thread, see sort().
+ */
+bool EntryModel::isVirtualized() const
+{
+    return m_virtualized;
+}
+
+bool EntryModel::canFetchMore(const QModelIndex& parent) const
+{
+    return !parent.isValid() && m_virtualized && m_fetchedRows < m_entries.size();
+}
+
+void EntryModel::fetchMore(const QModelIndex& parent)
+{
+    if (!canFetchMore(parent)) {
+        return;
+    }
+
+    const int count = qMin(FetchBatchSize, m_entries.size() - m_fetchedRows);
+    beginInsertRows(QModelIndex(), m_fetchedRows, m_fetchedRows + count - 1);
+    m_fetchedRows += count;
+    endInsertRows();
+}
+
+/**
+ * Sort virtualized search results. Values of the column are read once and
+ * cached, sort keys are built and the rows ordered on a background thread and
+ * the new order is applied as a single layout change. Other models are sorted by
+ * the proxy model, the requested order is only remembered for them.
+ */
+void EntryModel::sort(int column, Qt::SortOrder order)
+{
+    const bool pending = m_sortTimer.isActive() || m_sortWatcher.isRunning();
+    if (column == m_sortColumn && order == m_sortOrder && (m_sorted || pending)) {
+        return;
+    }
+
+    m_sortColumn = column;
+    m_sortOrder = order;
+    m_sorted = false;
+    if (m_virtualized && column >= 0) {
+        // Coalesce requests from the header and the proxy model
+        m_sortTimer.start();
+    }
+}
+
+void EntryModel::startSort()
+{
+    // A running sort is restarted once it finished, see applySort()
+    if (!m_virtualized || m_sortColumn < 0 || m_sorted || m_sortWatcher.isRunning()) {
+        return;
+    }
+
+    // Entries can only be read here, collation keys are built by the worker
+    if (m_sortValuesColumn != m_sortColumn) {
+        m_sortValues.clear();
+        m_sortValues.reserve(m_entries.size());
+        for (int row = 0; row < m_entries.size(); ++row) {
+            m_sortValues.append(data(createIndex(row, m_sortColumn), Qt::UserRole));
+        }
+        m_sortValuesColumn = m_sortColumn;
+    }
+
+    m_runningSort = {m_sortGeneration, m_sortColumn, m_sortOrder};
+
+    const auto values = m_sortValues;
+    const auto order = m_sortOrder;
+    const auto locale = QLocale();
+    m_sortWatcher.setFuture(QtConcurrent::run([values, order, locale] {
+        // A collator of its own, copies share their lazily initialized state
+        QCollator collator(locale);
+        collator.setNumericMode(true);
+        QVector<SortKey> keys;
+        keys.reserve(values.size());
+        for (const auto& value : values) {
+            keys.append(SortKey(value, collator));
+        }
+
+        QVector<int> rows(keys.size());
+        std::iota(rows.begin(), rows.end(), 0);
+        std::stable_sort(rows.begin(), rows.end(), [&](int left, int right) {
+            const int result = keys.at(left).compare(keys.at(right));
+            return order == Qt::AscendingOrder ? result < 0 : result > 0;
+        });
+        return rows;
+    }));
+}
+
+void EntryModel::applySort()
+{
+    if (m_runningSort.generation != m_sortGeneration || m_runningSort.column != m_sortColumn
+        || m_runningSort.order != m_sortOrder || m_bulkUpdateDepth > 0) {
+        // Rows or the requested order changed in the meantime
+        m_sortTimer.start();
+        return;
+    }
+
+    const QVector<int> order = m_sortWatcher.result();
+    Q_ASSERT(order.size() == m_entries.size());
+
+    emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+    QList<Entry*> entries;
+    entries.reserve(order.size());
+    QVector<QVariant> values;
+    values.reserve(order.size());
+    QVector<int> newRows(order.size());
+    for (int row = 0; row < order.size(); ++row) {
+        entries.append(m_entries.at(order.at(row)));
+        values.append(m_sortValues.at(order.at(row)));
+        newRows[order.at(row)] = row;
+    }
+    m_entries = entries;
+    m_sortValues = values;
+    resetRows();
+
+    const auto oldIndexes = persistentIndexList();
+    QModelIndexList newIndexes;
+    newIndexes.reserve(oldIndexes.size());
+    for (const auto& oldIndex : oldIndexes) {
+        const int row = oldIndex.isValid() ? newRows.at(oldIndex.row()) : -1;
+        newIndexes.append(row >= 0 && row < m_fetchedRows ? index(row, oldIndex.column()) : QModelIndex());
+    }
+    changePersistentIndexList(oldIndexes, newIndexes);
+
+    m_sorted = true;
+    emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+/**
+ * Drop cached sort values and mark running sorts as outdated after the rows changed.
+ */
+void EntryModel::invalidateSort()
+{
+    ++m_sortGeneration;
+    m_sortValuesColumn = -1;
+    m_sortValues.clear();
+    m_sorted = false;
+}
+
+/**
+ * Reread the cached sort value of a row, a row past the cached values is appended.
+ */
+void EntryModel::updateSortValue(int row)
+{
+    if (m_sortValuesColumn < 0) {
+        return;
+    }
+
+    const auto value = data(createIndex(row, m_sortValuesColumn), Qt::UserRole);
+    if (row < m_sortValues.size()) {
+        m_sortValues[row] = value;
+    } else {
+        m_sortValues.append(value);
+    }
+}
+
 int EntryModel::rowCount(const QModelIndex& parent) const
 {
     if (parent.isValid()) {
         return 0;
     } else {
-        return m_entries.size();
+        return m_virtualized ? m_fetchedRows : m_entries.size();
     }
 }
 
@@ -129,6 +313,7 @@ QVariant EntryModel::data(const QModelIndex& index, int role) const
     EntryAttributes* attr = entry->attributes();
 
     if (role == Qt::DisplayRole) {
+        const auto settings = config()->snapshot();
         QString result;
         switch (index.column()) {
         case ParentGroup:
@@ -148,7 +333,7 @@ QVariant EntryModel::data(const QModelIndex& index, int role) const
             }
             return result;
         case Username:
-            if (config()->get(Config::GUI_HideUsernames).toBool()) {
+            if (settings->getBool(Config::GUI_HideUsernames)) {
                 result = EntryModel::HiddenContentDisplay;
             } else {
                 result = entry->resolveMultiplePlaceholders(entry->username());
@@ -156,12 +341,12 @@ QVariant EntryModel::data(const QModelIndex& index, int role) const
             if (attr->isReference(EntryAttributes::UserNameKey)) {
                 result.prepend(tr("Ref: ", "Reference abbreviation"));
             }
-            if (entry->username().isEmpty() && !config()->get(Config::Security_PasswordEmptyPlaceholder).toBool()) {
+            if (entry->username().isEmpty() && !settings->getBool(Config::Security_PasswordEmptyPlaceholder)) {
                 result = "";
             }
             return result;
         case Password:
-            if (config()->get(Config::GUI_HidePasswords).toBool()) {
+            if (settings->getBool(Config::GUI_HidePasswords)) {
                 result = EntryModel::HiddenContentDisplay;
             } else {
                 result = entry->resolveMultiplePlaceholders(entry->password());
@@ -169,7 +354,7 @@ QVariant EntryModel::data(const QModelIndex& index, int role) const
             if (attr->isReference(EntryAttributes::PasswordKey)) {
                 result.prepend(tr("Ref: ", "Reference abbreviation"));
             }
-            if (entry->password().isEmpty() && !config()->get(Config::Security_PasswordEmptyPlaceholder).toBool()) {
+            if (entry->password().isEmpty() && !settings->getBool(Config::Security_PasswordEmptyPlaceholder)) {
                 result = "";
             }
             return result;
@@ -181,7 +366,7 @@ QVariant EntryModel::data(const QModelIndex& index, int role) const
             return result;
         case Notes:
             if (!entry->notes().isEmpty()) {
-                if (config()->get(Config::Security_HideNotes).toBool()) {
+                if (settings->getBool(Config::Security_HideNotes)) {
                     result = EntryModel::HiddenContentDisplay;
                 } else {
                     // Display only first line of notes in simplified format if not hidden
@@ -526,15 +711,46 @@ void EntryModel::entryAboutToAdd(Entry* entry)
         return;
     }
 
+    if (m_bulkUpdateDepth > 0) {
+        m_bulkAddedEntries.append(entry);
+        m_bulkContainsEntry.insert(entry, true);
+        return;
+    }
+
+    if (m_virtualized) {
+        // New rows are appended, only their key is needed to sort again in the background
+        ++m_sortGeneration;
+        m_sorted = false;
+        if (m_sortColumn >= 0) {
+            m_sortTimer.start();
+        }
+        if (m_fetchedRows < m_entries.size()) {
+            // The entry becomes visible with the next fetchMore()
+            m_entries.append(entry);
+            updateSortValue(m_entries.size() - 1);
+            m_silentChange = true;
+            return;
+        }
+    }
+
     beginInsertRows(QModelIndex(), m_entries.size(), m_entries.size());
     if (!m_group) {
         m_entries.append(entry);
+        ++m_fetchedRows;
+        if (m_virtualized) {
+            updateSortValue(m_entries.size() - 1);
+        }
     }
 }
 
 void EntryModel::entryAdded(Entry* entry)
 {
-    if (!m_group && !m_orgEntries.contains(entry)) {
+    if (m_bulkUpdateDepth > 0 || (!m_group && !m_orgEntries.contains(entry))) {
+        return;
+    }
+
+    if (m_silentChange) {
+        m_silentChange = false;
         return;
     }
 
@@ -546,14 +762,51 @@ void EntryModel::entryAdded(Entry* entry)
 
 void EntryModel::entryAboutToRemove(Entry* entry)
 {
-    beginRemoveRows(QModelIndex(), m_entries.indexOf(entry), m_entries.indexOf(entry));
+    if (m_bulkUpdateDepth > 0) {
+        m_bulkContainsEntry.insert(entry, false);
+        return;
+    }
+
+    const int row = rowFromEntry(entry);
+    if (row < 0) {
+        // Entry of a connected group that is not part of the search results
+        m_silentChange = true;
+        return;
+    }
+
+    // Removing rows keeps them sorted, the cached values only need to stay aligned
+    ++m_sortGeneration;
+    if (m_sortValuesColumn >= 0) {
+        m_sortValues.remove(row);
+    }
+
+    m_rows.remove(entry);
+    invalidateRows(row);
+    if (row >= rowCount()) {
+        // Not fetched yet, views do not know about the row
+        m_entries.removeAt(row);
+        m_silentChange = true;
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), row, row);
     if (!m_group) {
-        m_entries.removeAll(entry);
+        m_entries.removeAt(row);
+        --m_fetchedRows;
     }
 }
 
 void EntryModel::entryRemoved()
 {
+    if (m_bulkUpdateDepth > 0) {
+        return;
+    }
+
+    if (m_silentChange) {
+        m_silentChange = false;
+        return;
+    }
+
     if (m_group) {
         m_entries = m_group->entries();
     }
@@ -562,7 +815,12 @@ void EntryModel::entryRemoved()
 
 void EntryModel::entryAboutToMoveUp(int row)
 {
+    if (m_bulkUpdateDepth > 0) {
+        return;
+    }
+
     beginMoveRows(QModelIndex(), row, row, QModelIndex(), row - 1);
+    invalidateRows(row - 1);
     if (m_group) {
         m_entries.move(row, row - 1);
     }
@@ -570,6 +828,10 @@ void EntryModel::entryAboutToMoveUp(int row)
 
 void EntryModel::entryMovedUp()
 {
+    if (m_bulkUpdateDepth > 0) {
+        return;
+    }
+
     if (m_group) {
         m_entries = m_group->entries();
     }
@@ -578,7 +840,12 @@ void EntryModel::entryMovedUp()
 
 void EntryModel::entryAboutToMoveDown(int row)
 {
+    if (m_bulkUpdateDepth > 0) {
+        return;
+    }
+
     beginMoveRows(QModelIndex(), row, row, QModelIndex(), row + 2);
+    invalidateRows(row);
     if (m_group) {
         m_entries.move(row, row + 1);
     }
@@ -586,6 +853,10 @@ void EntryModel::entryAboutToMoveDown(int row)
 
 void EntryModel::entryMovedDown()
 {
+    if (m_bulkUpdateDepth > 0) {
+        return;
+    }
+
     if (m_group) {
         m_entries = m_group->entries();
     }
@@ -594,10 +865,220 @@ void EntryModel::entryMovedDown()
 
 void EntryModel::entryDataChanged(Entry* entry)
 {
-    int row = m_entries.indexOf(entry);
+    // The whole layout is refreshed at the end of a bulk update
+    if (m_bulkUpdateDepth > 0) {
+        return;
+    }
+
+    int row = rowFromEntry(entry);
+    if (row >= 0 && m_sortValuesColumn >= 0) {
+        // Move the entry to its new place like the proxy model does for smaller results
+        updateSortValue(row);
+        ++m_sortGeneration;
+        m_sorted = false;
+        if (m_sortColumn >= 0) {
+            m_sortTimer.start();
+        }
+    }
+    if (row >= rowCount()) {
+        return;
+    }
     emit dataChanged(index(row, 0), index(row, columnCount() - 1));
 }
 
+void EntryModel::entriesAboutToChange()
+{
+    // In search mode several groups take part in the same bulk update.
+    // The rows are left as they are until the update ends.
+    ++m_bulkUpdateDepth;
+}
+
+void EntryModel::entriesChanged()
+{
+    if (m_bulkUpdateDepth > 1) {
+        --m_bulkUpdateDepth;
+        return;
+    }
+
+    finishEntriesChange();
+}
+
+/**
+ * Apply the changes collected during a bulk update. Rows of removed entries are
+ * removed range by range, added entries are appended as one range and only a
+ * changed order of the remaining rows is announced as a layout change. Entries
+ * removed during the update may already be deleted, so they are only compared
+ * by address.
+ */
+void EntryModel::finishEntriesChange()
+{
+    if (m_bulkUpdateDepth == 0) {
+        return;
+    }
+    m_bulkUpdateDepth = 0;
+
+    QList<Entry*> entries;
+    if (m_group) {
+        entries = m_group->entries();
+    } else {
+        entries.reserve(m_entries.size() + m_bulkAddedEntries.size());
+        QSet<const Entry*> seen;
+        for (Entry* entry : asConst(m_entries)) {
+            if (m_bulkContainsEntry.value(entry, true)) {
+                entries.append(entry);
+                seen.insert(entry);
+            }
+        }
+        for (Entry* entry : asConst(m_bulkAddedEntries)) {
+            if (m_bulkContainsEntry.value(entry) && !seen.contains(entry)) {
+                entries.append(entry);
+                seen.insert(entry);
+            }
+        }
+    }
+    m_bulkAddedEntries.clear();
+    m_bulkContainsEntry.clear();
+
+    // The cached sort values are aligned with the old rows
+    invalidateSort();
+
+    QSet<const Entry*> remaining;
+    remaining.reserve(entries.size());
+    for (const Entry* entry : asConst(entries)) {
+        remaining.insert(entry);
+    }
+
+    // Remove the last ranges first so the rows of earlier ones stay valid
+    for (int last = m_entries.size() - 1; last >= 0; --last) {
+        if (remaining.contains(m_entries.at(last))) {
+            continue;
+        }
+        int first = last;
+        while (first > 0 && !remaining.contains(m_entries.at(first - 1))) {
+            --first;
+        }
+        removeEntryRows(first, last);
+        last = first;
+    }
+
+    QSet<const Entry*> present;
+    present.reserve(m_entries.size());
+    for (const Entry* entry : asConst(m_entries)) {
+        present.insert(entry);
+    }
+    QList<Entry*> added;
+    for (Entry* entry : asConst(entries)) {
+        if (!present.contains(entry)) {
+            added.append(entry);
+        }
+    }
+    if (!added.isEmpty()) {
+        if (m_virtualized && m_fetchedRows < m_entries.size()) {
+            // Rows past the fetched ones become visible with the next fetchMore()
+            m_entries.append(added);
+            resetRows();
+        } else {
+            beginInsertRows(QModelIndex(), m_entries.size(), m_entries.size() + added.size() - 1);
+            m_entries.append(added);
+            if (m_virtualized) {
+                m_fetchedRows += added.size();
+            }
+            resetRows();
+            endInsertRows();
+        }
+    }
+
+    if (m_entries != entries) {
+        emit layoutAboutToBeChanged();
+        const auto oldIndexes = persistentIndexList();
+        QList<const Entry*> oldEntries;
+        oldEntries.reserve(oldIndexes.size());
+        for (const auto& oldIndex : oldIndexes) {
+            oldEntries.append(oldIndex.isValid() ? m_entries.at(oldIndex.row()) : nullptr);
+        }
+
+        m_entries = entries;
+        resetRows();
+
+        QModelIndexList newIndexes;
+        newIndexes.reserve(oldIndexes.size());
+        for (int i = 0; i < oldIndexes.size(); ++i) {
+            const int row = rowFromEntry(oldEntries.at(i));
+            newIndexes.append(row >= 0 && row < rowCount() ? index(row, oldIndexes.at(i).column()) : QModelIndex());
+        }
+        changePersistentIndexList(oldIndexes, newIndexes);
+        emit layoutChanged();
+    }
+
+    if (m_virtualized && m_sortColumn >= 0) {
+        m_sortTimer.start();
+    }
+}
+
+/**
+ * Remove rows first to last of m_entries, announcing the ones views know about.
+ */
+void EntryModel::removeEntryRows(int first, int last)
+{
+    const int lastVisible = qMin(last, rowCount() - 1);
+    if (first > lastVisible) {
+        m_entries.erase(m_entries.begin() + first, m_entries.begin() + last + 1);
+        resetRows();
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), first, lastVisible);
+    m_entries.erase(m_entries.begin() + first, m_entries.begin() + last + 1);
+    if (m_virtualized) {
+        m_fetchedRows -= lastVisible - first + 1;
+    }
+    resetRows();
+    endRemoveRows();
+}
+
+/**
+ * Look up the row of an entry in constant time on average.
+ * Rows below m_validRows are known to be correct, the remaining entries are
+ * (re)indexed on demand up to the requested one.
+ *
+ * @return row of the entry or -1 if it is not part of the model
+ */
+int EntryModel::rowFromEntry(const Entry* entry) const
+{
+    auto it = m_rows.constFind(entry);
+    if (it != m_rows.constEnd() && it.value() < m_validRows) {
+        if (m_entries.at(it.value()) == entry) {
+            return it.value();
+        }
+        // Should not happen, start over to stay correct
+        m_validRows = 0;
+    }
+
+    while (m_validRows < m_entries.size()) {
+        const Entry* current = m_entries.at(m_validRows);
+        m_rows.insert(current, m_validRows);
+        if (current == entry) {
+            return m_validRows++;
+        }
+        ++m_validRows;
+    }
+    return -1;
+}
+
+/**
+ * Mark the cached rows starting at the given row as outdated.
+ */
+void EntryModel::invalidateRows(int row)
+{
+    m_validRows = qMax(0, qMin(m_validRows, row));
+}
+
+void EntryModel::resetRows()
+{
+    m_rows.clear();
+    m_validRows = 0;
+}
+
 void EntryModel::onConfigChanged(Config::ConfigKey key)
 {
     switch (key) {
@@ -625,15 +1106,18 @@ void EntryModel::severConnections()
 
 void EntryModel::makeConnections(const Group* group)
 {
-    connect(group, SIGNAL(entryAboutToAdd(Entry*)), SLOT(entryAboutToAdd(Entry*)));
-    connect(group, SIGNAL(entryAdded(Entry*)), SLOT(entryAdded(Entry*)));
-    connect(group, SIGNAL(entryAboutToRemove(Entry*)), SLOT(entryAboutToRemove(Entry*)));
-    connect(group, SIGNAL(entryRemoved(Entry*)), SLOT(entryRemoved()));
-    connect(group, SIGNAL(entryAboutToMoveUp(int)), SLOT(entryAboutToMoveUp(int)));
-    connect(group, SIGNAL(entryMovedUp()), SLOT(entryMovedUp()));
-    connect(group, SIGNAL(entryAboutToMoveDown(int)), SLOT(entryAboutToMoveDown(int)));
-    connect(group, SIGNAL(entryMovedDown()), SLOT(entryMovedDown()));
-    connect(group, SIGNAL(entryDataChanged(Entry*)), SLOT(entryDataChanged(Entry*)));
+    // Search results may span thousands of groups, avoid the string based connect()
+    connect(group, &Group::entryAboutToAdd, this, &EntryModel::entryAboutToAdd);
+    connect(group, &Group::entryAdded, this, &EntryModel::entryAdded);
+    connect(group, &Group::entryAboutToRemove, this, &EntryModel::entryAboutToRemove);
+    connect(group, &Group::entryRemoved, this, &EntryModel::entryRemoved);
+    connect(group, &Group::entryAboutToMoveUp, this, &EntryModel::entryAboutToMoveUp);
+    connect(group, &Group::entryMovedUp, this, &EntryModel::entryMovedUp);
+    connect(group, &Group::entryAboutToMoveDown, this, &EntryModel::entryAboutToMoveDown);
+    connect(group, &Group::entryMovedDown, this, &EntryModel::entryMovedDown);
+    connect(group, &Group::entryDataChanged, this, &EntryModel::entryDataChanged);
+    connect(group, &Group::entriesAboutToChange, this, &EntryModel::entriesAboutToChange);
+    connect(group, &Group::entriesChanged, this, &EntryModel::entriesChanged);
 }
 void EntryModel::setBackgroundColorVisible(bool visible)
 {
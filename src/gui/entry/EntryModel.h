@@ -19,8 +19,10 @@
 #define KEEPASSX_ENTRYMODEL_H
 
 #include <QAbstractTableModel>
+#include <QFutureWatcher>
 #include <QPixmap>
 #include <QSet>
+#include <QTimer>
 
 #include "core/Config.h"
 
@@ -53,6 +55,9 @@ public:
         ParentGroupPath = 16
     };
 
+    static constexpr int VirtualizationThreshold = 10000;
+    static constexpr int FetchBatchSize = 1000;
+
     explicit EntryModel(QObject* parent = nullptr);
     Entry* entryFromIndex(const QModelIndex& index) const;
     QModelIndex indexFromEntry(Entry* entry) const;
@@ -66,9 +71,13 @@ public:
     Qt::ItemFlags flags(const QModelIndex& modelIndex) const override;
     QStringList mimeTypes() const override;
     QMimeData* mimeData(const QModelIndexList& indexes) const override;
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
 
     void setGroup(Group* group);
     void setEntries(const QList<Entry*>& entries);
+    bool isVirtualized() const;
     void setBackgroundColorVisible(bool visible);
 
 private slots:
@@ -81,18 +90,60 @@ private slots:
     void entryAboutToMoveDown(int row);
     void entryMovedDown();
     void entryDataChanged(Entry* entry);
+    void entriesAboutToChange();
+    void entriesChanged();
 
     void onConfigChanged(Config::ConfigKey key);
+    void startSort();
+    void applySort();
 
 private:
+    struct SortRequest
+    {
+        quint64 generation = 0;
+        int column = -1;
+        Qt::SortOrder order = Qt::AscendingOrder;
+    };
+
     void severConnections();
     void makeConnections(const Group* group);
+    void finishEntriesChange();
+    void removeEntryRows(int first, int last);
+    int rowFromEntry(const Entry* entry) const;
+    void invalidateRows(int row);
+    void resetRows();
+    void invalidateSort();
+    void updateSortValue(int row);
 
     bool m_backgroundColorVisible = true;
     Group* m_group;
     QList<Entry*> m_entries;
-    QList<Entry*> m_orgEntries;
+    QSet<const Entry*> m_orgEntries;
     QSet<const Group*> m_allGroups;
+    bool m_silentChange = false;
+
+    // Virtualized search results, only m_fetchedRows are visible to views
+    bool m_virtualized = false;
+    int m_fetchedRows = 0;
+    int m_sortColumn = -1;
+    Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
+    bool m_sorted = false;
+    // Values of m_sortValuesColumn, aligned with m_entries
+    int m_sortValuesColumn = -1;
+    QVector<QVariant> m_sortValues;
+    quint64 m_sortGeneration = 0;
+    SortRequest m_runningSort;
+    QTimer m_sortTimer;
+    QFutureWatcher<QVector<int>> m_sortWatcher;
+
+    // Reverse lookup of m_entries, only rows below m_validRows are up to date
+    mutable QHash<const Entry*, int> m_rows;
+    mutable int m_validRows = 0;
+
+    // State of a pending bulk update, see Database::beginBulkUpdate()
+    int m_bulkUpdateDepth = 0;
+    QList<Entry*> m_bulkAddedEntries;
+    QHash<const Entry*, bool> m_bulkContainsEntry;
 
     const QString HiddenContentDisplay;
 };
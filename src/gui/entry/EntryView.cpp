@@ -209,6 +209,7 @@ void EntryView::focusInEvent(QFocusEvent* event)
 void EntryView::displayGroup(Group* group)
 {
     m_model->setGroup(group);
+    m_sortModel->setSortInSource(false);
     header()->hideSection(EntryModel::ParentGroup);
     setFirstEntryActive();
     m_inSearchMode = false;
@@ -217,6 +218,7 @@ void EntryView::displayGroup(Group* group)
 void EntryView::displaySearch(const QList<Entry*>& entries)
 {
     m_model->setEntries(entries);
+    m_sortModel->setSortInSource(m_model->isVirtualized());
     header()->showSection(EntryModel::ParentGroup);
 
     setFirstEntryActive();
@@ -39,6 +39,7 @@ void GroupModel::changeDatabase(Database* newDb)
     beginResetModel();
 
     m_db = newDb;
+    m_rows.clear();
 
     // clang-format off
     connect(m_db, SIGNAL(groupDataChanged(Group*)), SLOT(groupDataChanged(Group*)));
@@ -110,7 +111,7 @@ QModelIndex GroupModel::parent(Group* group) const
             // parent is the root group
             return createIndex(0, 0, parentGroup);
         } else {
-            return createIndex(grandParentGroup->children().indexOf(parentGroup), 0, parentGroup);
+            return createIndex(rowFromGroup(parentGroup), 0, parentGroup);
         }
     }
 }
@@ -160,15 +161,31 @@ QVariant GroupModel::headerData(int section, Qt::Orientation orientation, int ro
 
 QModelIndex GroupModel::index(Group* group) const
 {
-    int row;
+    return createIndex(rowFromGroup(group), 0, group);
+}
 
-    if (!group->parentGroup()) {
-        row = 0;
-    } else {
-        row = group->parentGroup()->children().indexOf(group);
+/**
+ * Look up the row of a group below its parent in constant time on average.
+ * Cached rows are verified against the parent's children, a mismatch after
+ * groups were added, moved or sorted re-indexes all siblings at once.
+ */
+int GroupModel::rowFromGroup(const Group* group) const
+{
+    const Group* parentGroup = group->parentGroup();
+    if (!parentGroup) {
+        return 0;
     }
 
-    return createIndex(row, 0, group);
+    const auto& children = parentGroup->children();
+    const int row = m_rows.value(group, -1);
+    if (row >= 0 && row < children.size() && children.at(row) == group) {
+        return row;
+    }
+
+    for (int i = 0; i < children.size(); ++i) {
+        m_rows.insert(children.at(i), i);
+    }
+    return m_rows.value(group, -1);
 }
 
 Group* GroupModel::groupFromIndex(const QModelIndex& index) const
@@ -277,6 +294,10 @@ bool GroupModel::dropMimeData(const QMimeData* data,
             return false;
         }
 
+        // Move all dropped entries as a single bulk update of the target database
+        Database* targetDb = parentGroup->database();
+        targetDb->beginBulkUpdate();
+
         while (!stream.atEnd()) {
             QUuid dbUuid;
             QUuid entryUuid;
@@ -293,7 +314,6 @@ bool GroupModel::dropMimeData(const QMimeData* data,
             }
 
             Database* sourceDb = dragEntry->group()->database();
-            Database* targetDb = parentGroup->database();
 
             Entry* entry = dragEntry;
 
@@ -314,6 +334,8 @@ bool GroupModel::dropMimeData(const QMimeData* data,
 
             entry->setGroup(parentGroup);
         }
+
+        targetDb->endBulkUpdate();
     }
 
     return true;
@@ -374,7 +396,7 @@ void GroupModel::groupAboutToRemove(Group* group)
 
     QModelIndex parentIndex = parent(group);
     Q_ASSERT(parentIndex.isValid());
-    int pos = group->parentGroup()->children().indexOf(group);
+    int pos = rowFromGroup(group);
     Q_ASSERT(pos != -1);
 
     beginRemoveRows(parentIndex, pos, pos);
@@ -382,6 +404,8 @@ void GroupModel::groupAboutToRemove(Group* group)
 
 void GroupModel::groupRemoved()
 {
+    // Drop rows of deleted groups, the remaining ones are re-indexed on demand
+    m_rows.clear();
     endRemoveRows();
 }
 
@@ -405,7 +429,7 @@ void GroupModel::groupAboutToMove(Group* group, Group* toGroup, int pos)
 
     QModelIndex oldParentIndex = parent(group);
     QModelIndex newParentIndex = index(toGroup);
-    int oldPos = group->parentGroup()->children().indexOf(group);
+    int oldPos = rowFromGroup(group);
     if (group->parentGroup() == toGroup && pos > oldPos) {
         // beginMoveRows() has a bit different semantics than Group::setParent() and
         // QList::move() when the new position is greater than the old
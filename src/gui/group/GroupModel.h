@@ -19,6 +19,7 @@
 #define KEEPASSX_GROUPMODEL_H
 
 #include <QAbstractItemModel>
+#include <QHash>
 
 class Database;
 class Group;
@@ -49,6 +50,7 @@ public:
 
 private:
     QModelIndex parent(Group* group) const;
+    int rowFromGroup(const Group* group) const;
     void collectIndexesRecursively(QList<QModelIndex>& indexes, QList<Group*> groups);
 
 private slots:
@@ -62,6 +64,7 @@ private slots:
 
 private:
     Database* m_db;
+    mutable QHash<const Group*, int> m_rows;
 };
 
 #endif // KEEPASSX_GROUPMODEL_H
@@ -19,14 +19,17 @@
 #include "ui_ReportsWidgetHealthcheck.h"
 
 #include "core/AsyncTask.h"
+#include "core/Clock.h"
 #include "core/Group.h"
 #include "core/Metadata.h"
 #include "core/PasswordHealth.h"
+#include "core/PasswordHealthIndex.h"
 #include "gui/GuiTools.h"
 #include "gui/Icons.h"
 #include "gui/styles/StateColorPalette.h"
 
 #include <QMenu>
+#include <QSet>
 #include <QShortcut>
 #include <QSortFilterProxyModel>
 #include <QStandardItemModel>
@@ -57,7 +60,7 @@ namespace
             }
         };
 
-        explicit Health(QSharedPointer<Database>);
+        Health(QSharedPointer<Database> db, const PasswordHealthIndex* index, const HealthChecker& checker);
 
         const QList<QSharedPointer<Item>>& items() const
         {
@@ -98,10 +101,20 @@ namespace
     };
 } // namespace
 
-Health::Health(QSharedPointer<Database> db)
+Health::Health(QSharedPointer<Database> db, const PasswordHealthIndex* index, const HealthChecker& checker)
     : m_db(db)
-    , m_checker(db)
+    , m_checker(checker)
 {
+    // Only weak, re-used or soon expiring passwords can score below "good",
+    // the health index knows these without evaluating every entry
+    QSet<const Entry*> candidates;
+    for (auto entry : index->weakEntries() + index->reusedEntries()
+                          + index->expiringEntries(Clock::currentDateTime().addDays(31))) {
+        candidates.insert(entry);
+    }
+
+    QList<Group*> groups;
+    QList<Entry*> entries;
     for (auto group : db->rootGroup()->groupsRecursive(true)) {
         // Skip recycle bin
         if (group->isRecycled()) {
@@ -113,21 +126,29 @@ Health::Health(QSharedPointer<Database> db)
                 continue;
             }
 
+            if (entry->excludeFromReports()) {
+                m_anyExcludedEntries = true;
+            }
+
             // Skip entries with empty password
-            if (entry->password().isEmpty()) {
+            if (!candidates.contains(entry) || entry->password().isEmpty()) {
                 continue;
             }
 
-            // Evaluate this entry
-            const auto item = QSharedPointer<Item>(new Item(group, entry, m_checker.evaluate(entry)));
-            if (item->exclude) {
-                m_anyExcludedEntries = true;
-            }
+            groups << group;
+            entries << entry;
+        }
+    }
 
-            // Add entry if its password isn't at least "good"
-            if (item->health->quality() < PasswordHealth::Quality::Good) {
-                m_items.append(item);
-            }
+    // Evaluate all entries in parallel
+    const auto results = m_checker.evaluate(entries);
+
+    for (int i = 0; i < entries.size(); ++i) {
+        const auto item = QSharedPointer<Item>(new Item(groups[i], entries[i], results[i]));
+
+        // Add entry if its password isn't at least "good"
+        if (item->health->quality() < PasswordHealth::Quality::Good) {
+            m_items.append(item);
         }
     }
 
@@ -255,8 +276,14 @@ void ReportsWidgetHealthcheck::calculateHealth()
 {
     m_referencesModel->clear();
 
+    // The health index is built on this thread and follows entry changes from here on,
+    // the worker only reads it
+    const auto index = m_db->healthIndex();
+    const HealthChecker checker(m_db);
+
     // Perform the health check
-    const QScopedPointer<Health> health(AsyncTask::runAndWaitForFuture([this] { return new Health(m_db); }));
+    const QScopedPointer<Health> health(
+        AsyncTask::runAndWaitForFuture([this, index, checker] { return new Health(m_db, index, checker); }));
 
     // Display the entries
     m_rowToEntry.clear();
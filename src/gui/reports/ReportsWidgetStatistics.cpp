@@ -18,7 +18,6 @@
 #include "ReportsWidgetStatistics.h"
 #include "ui_ReportsWidgetStatistics.h"
 
-#include "core/AsyncTask.h"
 #include "core/Clock.h"
 #include "core/DatabaseStats.h"
 #include "core/Group.h"
@@ -27,6 +26,7 @@
 #include "gui/Icons.h"
 
 #include <QStandardItemModel>
+#include <QtConcurrent>
 
 ReportsWidgetStatistics::ReportsWidgetStatistics(QWidget* parent)
     : QWidget(parent)
@@ -40,6 +40,8 @@ ReportsWidgetStatistics::ReportsWidgetStatistics(QWidget* parent)
     m_ui->statisticsTableView->setModel(m_referencesModel.data());
     m_ui->statisticsTableView->setSelectionMode(QAbstractItemView::NoSelection);
     m_ui->statisticsTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+
+    connect(&m_statsWatcher, &QFutureWatcherBase::finished, this, &ReportsWidgetStatistics::showStats);
 }
 
 ReportsWidgetStatistics::~ReportsWidgetStatistics() = default;
@@ -80,9 +82,20 @@ void ReportsWidgetStatistics::showEvent(QShowEvent* event)
 
 void ReportsWidgetStatistics::calculateStats()
 {
-    const QScopedPointer<DatabaseStats> stats(
-        AsyncTask::runAndWaitForFuture([this] { return new DatabaseStats(m_db); }));
+    // Work on a snapshot so the database can be edited while the statistics are calculated
+    const auto snapshot = m_db->snapshot();
+    m_statsWatcher.setFuture(
+        QtConcurrent::run([snapshot] { return QSharedPointer<DatabaseStats>::create(snapshot); }));
+}
+
+void ReportsWidgetStatistics::showStats()
+{
+    // The settings were reloaded in the meantime
+    if (!m_statsCalculated) {
+        return;
+    }
 
+    const auto stats = m_statsWatcher.result();
     m_referencesModel->clear();
     addStatsRow(tr("Database name"), m_db->metadata()->name());
     addStatsRow(tr("Description"), m_db->metadata()->description());
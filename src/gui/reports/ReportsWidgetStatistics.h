@@ -18,10 +18,12 @@
 #ifndef KEEPASSXC_REPORTSWIDGETSTATISTICS_H
 #define KEEPASSXC_REPORTSWIDGETSTATISTICS_H
 
+#include <QFutureWatcher>
 #include <QIcon>
 #include <QWidget>
 
 class Database;
+class DatabaseStats;
 class QStandardItemModel;
 
 namespace Ui
@@ -44,6 +46,7 @@ protected:
 
 private slots:
     void calculateStats();
+    void showStats();
 
 private:
     QScopedPointer<Ui::ReportsWidgetStatistics> m_ui;
@@ -52,6 +55,7 @@ private:
     QIcon m_errIcon;
     QScopedPointer<QStandardItemModel> m_referencesModel;
     QSharedPointer<Database> m_db;
+    QFutureWatcher<QSharedPointer<DatabaseStats>> m_statsWatcher;
 
     void addStatsRow(QString name, QString value, bool bad = false, QString badMsg = "");
 };
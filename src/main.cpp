@@ -25,6 +25,7 @@
 #include "cli/Utils.h"
 #include "config-keepassx.h"
 #include "core/Tools.h"
+#include "core/Trace.h"
 #include "crypto/Crypto.h"
 #include "gui/Application.h"
 #include "gui/MainWindow.h"
@@ -84,6 +85,7 @@ int main(int argc, char** argv)
     QCommandLineOption pwstdinOption("pw-stdin", QObject::tr("read password of the database from stdin"));
     QCommandLineOption allowScreenCaptureOption("allow-screencapture",
                                                 QObject::tr("allow screenshots and app recording (Windows/macOS)"));
+    QCommandLineOption traceOption("trace", QObject::tr("write a performance trace to the given file"), "trace");
 
     QCommandLineOption helpOption = parser.addHelpOption();
     QCommandLineOption versionOption = parser.addVersionOption();
@@ -95,6 +97,7 @@ int main(int argc, char** argv)
     parser.addOption(pwstdinOption);
     parser.addOption(debugInfoOption);
     parser.addOption(allowScreenCaptureOption);
+    parser.addOption(traceOption);
 
     parser.process(app);
 
@@ -166,6 +169,17 @@ int main(int argc, char** argv)
         return EXIT_SUCCESS;
     }
 
+    // Start tracing once this is the only instance, so another launch does not truncate its trace.
+    // The command line takes precedence over the environment.
+    const QString traceFile =
+        parser.isSet(traceOption) ? parser.value(traceOption) : qEnvironmentVariable(Trace::EnvironmentVariable);
+    if (!traceFile.isEmpty()) {
+        QString traceError;
+        if (!Trace::start(traceFile, &traceError)) {
+            qWarning("%s", qPrintable(traceError));
+        }
+    }
+
     if (!Crypto::init()) {
         QString error = QObject::tr("Fatal error while testing the cryptographic functions.");
         error.append("\n");
@@ -19,7 +19,18 @@
 #include "NetworkManager.h"
 
 #include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
 #include <QNetworkReply>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+const QString HibpDownloader::DefaultBaseUrl = QStringLiteral("https://api.pwnedpasswords.com/range/");
+const int HibpDownloader::DefaultCacheTtl = 24 * 60 * 60;
+const int HibpDownloader::DefaultMaxConcurrentRequests = 6;
 
 namespace
 {
@@ -34,38 +45,14 @@ namespace
         const auto sha1 = QCryptographicHash::hash(password.toUtf8(), QCryptographicHash::Sha1);
         return sha1.toHex().toUpper();
     }
-
-    /*
-     * Search a password's hash in the output of the HIBP web service.
-     *
-     * Returns the number of times the password is found in breaches, or
-     * 0 if the password is not in the HIBP result.
-     */
-    int pwnCount(const QString& password, const QString& hibpResult)
-    {
-        // The first 5 characters of the hash are in the URL already,
-        // the HIBP result contains the remainder
-        auto pos = hibpResult.indexOf(sha1Hex(password).mid(5));
-        if (pos < 0) {
-            return 0;
-        }
-
-        // Skip past the sha1 and ':'
-        pos += 36;
-
-        // Find where the count ends
-        auto end = hibpResult.indexOf('\n', pos);
-        if (end < 0) {
-            end = hibpResult.size();
-        }
-
-        // Extract the count, remove remaining whitespace, and convert to int
-        return hibpResult.midRef(pos, end - pos).trimmed().toInt();
-    }
 } // namespace
 
 HibpDownloader::HibpDownloader(QObject* parent)
     : QObject(parent)
+    , m_baseUrl(DefaultBaseUrl)
+    , m_cacheDir(defaultCacheDirectory())
+    , m_cacheTtl(DefaultCacheTtl)
+    , m_maxRequests(DefaultMaxConcurrentRequests)
 {
 }
 
@@ -82,37 +69,36 @@ HibpDownloader::~HibpDownloader()
  */
 void HibpDownloader::add(const QString& password)
 {
-    if (!m_pwdsToTry.contains(password)) {
+    if (!m_pwdsAdded.contains(password)) {
+        m_pwdsAdded.insert(password);
         m_pwdsToTry << password;
     }
 }
 
 /*
  * Start validating the passwords against HIBP.
+ *
+ * Passwords are grouped by the first five characters of their SHA1,
+ * each group is resolved with one range query (or from the cache).
  */
 void HibpDownloader::validate()
 {
-    for (auto password : m_pwdsToTry) {
+    for (const auto& password : m_pwdsToTry) {
         // The URL we query is https://api.pwnedpasswords.com/range/XXXXX,
         // where XXXXX is the first five bytes of the hex representation of
         // the password's SHA1.
-        const auto url = QString("https://api.pwnedpasswords.com/range/") + sha1Hex(password).left(5);
-
-        // HIBP requires clients to specify a user agent in the request
-        // (https://haveibeenpwned.com/API/v3#UserAgent); however, in order
-        // to minimize the amount of information we expose about ourselves,
-        // we don't add the KeePassXC version number or platform.
-        auto request = QNetworkRequest(url);
-        request.setRawHeader("User-Agent", "KeePassXC");
-
-        // Finally, submit the request to HIBP.
-        auto reply = getNetMgr()->get(request);
-        connect(reply, &QNetworkReply::finished, this, &HibpDownloader::fetchFinished);
-        connect(reply, &QIODevice::readyRead, this, &HibpDownloader::fetchReadyRead);
-        m_replies.insert(reply, {password, {}});
+        const auto prefix = sha1Hex(password).left(5);
+        if (!m_pwdsByPrefix.contains(prefix)) {
+            m_prefixQueue << prefix;
+        }
+        m_pwdsByPrefix[prefix] << password;
     }
 
     m_pwdsToTry.clear();
+    m_pwdsAdded.clear();
+
+    // Results are always delivered asynchronously, even from the cache
+    QMetaObject::invokeMethod(this, "processQueue", Qt::QueuedConnection);
 }
 
 int HibpDownloader::passwordsToValidate() const
@@ -122,7 +108,65 @@ int HibpDownloader::passwordsToValidate() const
 
 int HibpDownloader::passwordsRemaining() const
 {
-    return m_replies.size();
+    int remaining = 0;
+    for (const auto& passwords : m_pwdsByPrefix) {
+        remaining += passwords.size();
+    }
+    return remaining;
+}
+
+QString HibpDownloader::baseUrl() const
+{
+    return m_baseUrl;
+}
+
+/*
+ * Set the URL that range prefixes are appended to,
+ * for example to point the downloader at a local mirror.
+ */
+void HibpDownloader::setBaseUrl(const QString& url)
+{
+    m_baseUrl = url;
+}
+
+QString HibpDownloader::cacheDirectory() const
+{
+    return m_cacheDir;
+}
+
+/*
+ * Set the directory used to cache range responses.
+ * An empty path disables the cache.
+ */
+void HibpDownloader::setCacheDirectory(const QString& path)
+{
+    m_cacheDir = path;
+    m_cachePruned = false;
+}
+
+int HibpDownloader::cacheTtl() const
+{
+    return m_cacheTtl;
+}
+
+void HibpDownloader::setCacheTtl(int seconds)
+{
+    m_cacheTtl = seconds;
+}
+
+int HibpDownloader::maxConcurrentRequests() const
+{
+    return m_maxRequests;
+}
+
+void HibpDownloader::setMaxConcurrentRequests(int count)
+{
+    m_maxRequests = qMax(1, count);
+}
+
+QString HibpDownloader::defaultCacheDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + "/keepassxc/hibp";
 }
 
 /*
@@ -130,11 +174,45 @@ int HibpDownloader::passwordsRemaining() const
  */
 void HibpDownloader::abort()
 {
-    for (auto reply : m_replies.keys()) {
+    // Aborting a reply emits finished(), forget the replies first
+    const auto replies = m_replies.keys();
+    m_replies.clear();
+    for (auto reply : replies) {
         reply->abort();
         reply->deleteLater();
     }
-    m_replies.clear();
+    m_prefixQueue.clear();
+    m_pwdsByPrefix.clear();
+}
+
+/*
+ * Resolve queued prefixes from the cache and start new range
+ * requests until the concurrency limit is reached.
+ */
+void HibpDownloader::processQueue()
+{
+    while (!m_prefixQueue.isEmpty() && m_replies.size() < m_maxRequests) {
+        const auto prefix = m_prefixQueue.takeFirst();
+
+        QByteArray response;
+        if (readCache(prefix, response)) {
+            emitResults(prefix, response);
+            continue;
+        }
+
+        // HIBP requires clients to specify a user agent in the request
+        // (https://haveibeenpwned.com/API/v3#UserAgent); however, in order
+        // to minimize the amount of information we expose about ourselves,
+        // we don't add the KeePassXC version number or platform.
+        auto request = QNetworkRequest(QUrl(m_baseUrl + prefix));
+        request.setRawHeader("User-Agent", "KeePassXC");
+
+        // Finally, submit the request to HIBP.
+        auto reply = getNetMgr()->get(request);
+        connect(reply, &QNetworkReply::finished, this, &HibpDownloader::fetchFinished);
+        connect(reply, &QIODevice::readyRead, this, &HibpDownloader::fetchReadyRead);
+        m_replies.insert(reply, {prefix, {}});
+    }
 }
 
 /*
@@ -164,7 +242,7 @@ void HibpDownloader::fetchFinished()
     const auto ok = reply->error() == QNetworkReply::NoError;
     const auto err = reply->errorString();
 
-    const auto password = entry->first;
+    const auto prefix = entry->first;
     const auto hibpReply = entry->second;
 
     reply->deleteLater();
@@ -182,6 +260,127 @@ void HibpDownloader::fetchFinished()
         return;
     }
 
-    // Current password validated, send the result to the caller
-    emit hibpResult(password, pwnCount(password, hibpReply));
+    writeCache(prefix, hibpReply);
+    emitResults(prefix, hibpReply);
+    processQueue();
+}
+
+/*
+ * Send the results for all passwords of a prefix to the caller.
+ */
+void HibpDownloader::emitResults(const QString& prefix, const QByteArray& response)
+{
+    const auto table = parseRange(response);
+
+    // Take the passwords one by one so passwordsRemaining() stays accurate
+    // for the receivers of hibpResult
+    auto passwords = m_pwdsByPrefix.find(prefix);
+    while (passwords != m_pwdsByPrefix.end()) {
+        const auto password = passwords->takeFirst();
+        if (passwords->isEmpty()) {
+            m_pwdsByPrefix.erase(passwords);
+        }
+        emit hibpResult(password, pwnCount(password, table));
+        passwords = m_pwdsByPrefix.find(prefix);
+    }
+}
+
+/*
+ * Parse the output of the HIBP web service. Each line holds the
+ * remaining 35 characters of a hash, a colon and the breach count.
+ * Padding entries with a count of 0 are dropped.
+ */
+HibpDownloader::RangeTable HibpDownloader::parseRange(const QByteArray& response)
+{
+    RangeTable table;
+    table.reserve(response.count('\n') + 1);
+    for (const auto& line : response.split('\n')) {
+        const auto colon = line.indexOf(':');
+        if (colon < 0) {
+            continue;
+        }
+        const auto count = line.mid(colon + 1).trimmed().toInt();
+        if (count > 0) {
+            table.append({line.left(colon).trimmed().toUpper(), count});
+        }
+    }
+
+    std::sort(table.begin(), table.end(), [](const QPair<QByteArray, int>& lhs, const QPair<QByteArray, int>& rhs) {
+        return lhs.first < rhs.first;
+    });
+    return table;
+}
+
+/*
+ * Search a password's hash in a parsed range response.
+ *
+ * Returns the number of times the password is found in breaches, or
+ * 0 if the password is not in the HIBP result.
+ */
+int HibpDownloader::pwnCount(const QString& password, const RangeTable& table)
+{
+    // The first 5 characters of the hash are in the URL already,
+    // the HIBP result contains the remainder
+    const auto suffix = sha1Hex(password).mid(5).toLatin1();
+    const auto it = std::lower_bound(
+        table.constBegin(), table.constEnd(), suffix, [](const QPair<QByteArray, int>& item, const QByteArray& key) {
+            return item.first < key;
+        });
+    if (it == table.constEnd() || it->first != suffix) {
+        return 0;
+    }
+    return it->second;
+}
+
+bool HibpDownloader::readCache(const QString& prefix, QByteArray& response) const
+{
+    if (m_cacheDir.isEmpty() || m_cacheTtl <= 0) {
+        return false;
+    }
+
+    const QFileInfo info(QDir(m_cacheDir).filePath(prefix));
+    if (!info.exists() || info.lastModified().secsTo(QDateTime::currentDateTime()) > m_cacheTtl) {
+        return false;
+    }
+
+    QFile file(info.filePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    response = file.readAll();
+    return true;
+}
+
+void HibpDownloader::writeCache(const QString& prefix, const QByteArray& response)
+{
+    if (m_cacheDir.isEmpty() || m_cacheTtl <= 0 || !QDir().mkpath(m_cacheDir)) {
+        return;
+    }
+
+    if (!m_cachePruned) {
+        m_cachePruned = true;
+        pruneCache();
+    }
+
+    // A failed write only costs a download next time
+    QSaveFile file(QDir(m_cacheDir).filePath(prefix));
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(response);
+        file.commit();
+    }
+}
+
+/*
+ * Remove expired range responses, and any temporary files left
+ * behind by interrupted writes, so the cache does not grow forever.
+ */
+void HibpDownloader::pruneCache() const
+{
+    const auto now = QDateTime::currentDateTime();
+    const auto files = QDir(m_cacheDir).entryInfoList(QDir::Files | QDir::Hidden);
+    for (const auto& info : files) {
+        if (info.lastModified().secsTo(now) > m_cacheTtl) {
+            QFile::remove(info.filePath());
+        }
+    }
 }
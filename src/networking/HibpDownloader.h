@@ -21,6 +21,8 @@
 #include "config-keepassx.h"
 #include <QHash>
 #include <QObject>
+#include <QSet>
+#include <QVector>
 
 #ifndef WITH_XC_NETWORKING
 #error This file requires KeePassXC to be built with network support.
@@ -36,6 +38,11 @@ class QNetworkReply;
  * Usage: Pass the password to check to the ctor and process
  * the `finished` signal to get the result. Process the
  * `failed` signal to handle errors.
+ *
+ * Passwords sharing a hash prefix are checked with a single range
+ * request, at most maxConcurrentRequests() requests are in flight at
+ * once, and range responses are cached on disk for cacheTtl() seconds.
+ * Expired responses are removed the first time the cache is written.
  */
 class HibpDownloader : public QObject
 {
@@ -50,6 +57,21 @@ public:
     int passwordsToValidate() const;
     int passwordsRemaining() const;
 
+    QString baseUrl() const;
+    void setBaseUrl(const QString& url);
+    QString cacheDirectory() const;
+    void setCacheDirectory(const QString& path);
+    int cacheTtl() const;
+    void setCacheTtl(int seconds);
+    int maxConcurrentRequests() const;
+    void setMaxConcurrentRequests(int count);
+
+    static QString defaultCacheDirectory();
+
+    static const QString DefaultBaseUrl;
+    static const int DefaultCacheTtl;
+    static const int DefaultMaxConcurrentRequests;
+
 signals:
     void hibpResult(const QString& password, int count);
     void fetchFailed(const QString& error);
@@ -60,9 +82,30 @@ public slots:
 private slots:
     void fetchFinished();
     void fetchReadyRead();
+    void processQueue();
 
 private:
+    // Range response sorted by hash suffix for binary search
+    using RangeTable = QVector<QPair<QByteArray, int>>;
+
+    static RangeTable parseRange(const QByteArray& response);
+    static int pwnCount(const QString& password, const RangeTable& table);
+
+    bool readCache(const QString& prefix, QByteArray& response) const;
+    void writeCache(const QString& prefix, const QByteArray& response);
+    void pruneCache() const;
+    void emitResults(const QString& prefix, const QByteArray& response);
+
+    QString m_baseUrl;
+    QString m_cacheDir;
+    int m_cacheTtl;
+    int m_maxRequests;
+    bool m_cachePruned = false;
+
     QStringList m_pwdsToTry; // The list of remaining passwords to validate
+    QSet<QString> m_pwdsAdded;
+    QStringList m_prefixQueue; // Hash prefixes waiting to be fetched
+    QHash<QString, QStringList> m_pwdsByPrefix;
     QHash<QNetworkReply*, QPair<QString, QByteArray>> m_replies;
 };
 
@@ -0,0 +1,262 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ParallelGzipStream.h"
+
+#include "core/Endian.h"
+
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <zlib.h>
+
+namespace
+{
+    // Size of the deflate sliding window, the most history a chunk can refer back to
+    const int WindowSize = 32 * 1024;
+
+    // Member header: magic, deflate, no flags, no mtime, no extra flags, unknown OS
+    const QByteArray GzipHeader("\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\xff", 10);
+} // namespace
+
+ParallelGzipStream::ParallelGzipStream(QIODevice* baseDevice, int compressionLevel, int chunkSize)
+    : LayeredStream(baseDevice)
+    , m_compressionLevel(qBound(0, compressionLevel, 9))
+    , m_chunkSize(qMax(WindowSize, chunkSize))
+    , m_maxPending(qMax(2, QThreadPool::globalInstance()->maxThreadCount() * 2))
+{
+    init();
+}
+
+ParallelGzipStream::~ParallelGzipStream()
+{
+    close();
+}
+
+void ParallelGzipStream::init()
+{
+    m_buffer.clear();
+    m_dictionary.clear();
+    m_pending.clear();
+    m_crc = 0;
+    m_inputSize = 0;
+    m_finished = false;
+    m_error = false;
+}
+
+bool ParallelGzipStream::open(QIODevice::OpenMode mode)
+{
+    if (mode & QIODevice::ReadOnly) {
+        qWarning("ParallelGzipStream::open: Reading is not supported.");
+        return false;
+    }
+
+    if (!LayeredStream::open(mode)) {
+        return false;
+    }
+
+    init();
+    if (!writeBase(GzipHeader)) {
+        LayeredStream::close();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Compress all buffered data and write the gzip trailer.
+ *
+ * @return true on success, errorString() is set otherwise
+ */
+bool ParallelGzipStream::reset()
+{
+    if (isWritable()) {
+        return finish();
+    }
+    return !m_error;
+}
+
+void ParallelGzipStream::close()
+{
+    if (isWritable()) {
+        finish();
+    }
+
+    LayeredStream::close();
+}
+
+qint64 ParallelGzipStream::readData(char* data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    return -1;
+}
+
+qint64 ParallelGzipStream::writeData(const char* data, qint64 maxSize)
+{
+    if (m_error || m_finished) {
+        return -1;
+    }
+
+    qint64 offset = 0;
+
+    // Complete the chunk left over from previous writes first
+    if (!m_buffer.isEmpty()) {
+        offset = qMin<qint64>(m_chunkSize - m_buffer.size(), maxSize);
+        m_buffer.append(data, static_cast<int>(offset));
+        if (m_buffer.size() < m_chunkSize) {
+            return maxSize;
+        }
+        dispatch(m_buffer, false);
+        m_buffer.clear();
+        if (!writeFinished(m_maxPending)) {
+            return -1;
+        }
+    }
+
+    // Full chunks are cut straight from the input, only the tail is buffered
+    while (maxSize - offset >= m_chunkSize) {
+        dispatch(QByteArray(data + offset, m_chunkSize), false);
+        offset += m_chunkSize;
+        if (!writeFinished(m_maxPending)) {
+            return -1;
+        }
+    }
+    m_buffer.append(data + offset, static_cast<int>(maxSize - offset));
+
+    return maxSize;
+}
+
+void ParallelGzipStream::dispatch(const QByteArray& input, bool last)
+{
+    QByteArray dictionary = m_dictionary;
+    m_dictionary = input.size() >= WindowSize ? input.right(WindowSize) : (m_dictionary + input).right(WindowSize);
+
+    m_pending.enqueue(
+        QtConcurrent::run(&ParallelGzipStream::deflateChunk, input, dictionary, m_compressionLevel, last));
+}
+
+/**
+ * Write completed chunks in order, waiting for the oldest ones until
+ * no more than maxPending chunks are in flight.
+ */
+bool ParallelGzipStream::writeFinished(int maxPending)
+{
+    while (!m_pending.isEmpty() && (m_pending.size() > maxPending || m_pending.head().isFinished())) {
+        if (!writeChunk(m_pending.dequeue().result())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ParallelGzipStream::writeChunk(const Chunk& chunk)
+{
+    if (!chunk.ok) {
+        m_error = true;
+        setErrorString(tr("Failed to compress data."));
+        return false;
+    }
+
+    m_crc = crc32_combine(m_crc, chunk.crc, chunk.inputSize);
+    m_inputSize += static_cast<quint32>(chunk.inputSize);
+    return writeBase(chunk.data);
+}
+
+bool ParallelGzipStream::finish()
+{
+    if (m_finished) {
+        return !m_error;
+    }
+    m_finished = true;
+
+    if (m_error) {
+        return false;
+    }
+
+    // The final chunk carries the last block marker, even if it is empty
+    dispatch(m_buffer, true);
+    m_buffer.clear();
+    if (!writeFinished(0)) {
+        return false;
+    }
+
+    return writeBase(Endian::sizedIntToBytes<quint32>(m_crc, QSysInfo::LittleEndian))
+           && writeBase(Endian::sizedIntToBytes<quint32>(m_inputSize, QSysInfo::LittleEndian));
+}
+
+bool ParallelGzipStream::writeBase(const QByteArray& data)
+{
+    if (m_baseDevice->write(data) != data.size()) {
+        m_error = true;
+        setErrorString(m_baseDevice->errorString());
+        return false;
+    }
+    return true;
+}
+
+ParallelGzipStream::Chunk
+ParallelGzipStream::deflateChunk(const QByteArray& input, const QByteArray& dictionary, int level, bool last)
+{
+    Chunk chunk;
+    chunk.inputSize = input.size();
+    chunk.crc = crc32(0L, reinterpret_cast<const Bytef*>(input.constData()), static_cast<uInt>(input.size()));
+
+    // Raw deflate, the gzip framing is written by the stream itself
+    z_stream stream = {};
+    if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return chunk;
+    }
+
+    if (!dictionary.isEmpty()
+        && deflateSetDictionary(&stream,
+                                reinterpret_cast<const Bytef*>(dictionary.constData()),
+                                static_cast<uInt>(dictionary.size()))
+               != Z_OK) {
+        deflateEnd(&stream);
+        return chunk;
+    }
+
+    // Non-final chunks end with a sync flush so the next chunk starts on a byte boundary
+    const int flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+    chunk.data.resize(static_cast<int>(deflateBound(&stream, static_cast<uLong>(input.size()))) + 16);
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.constData()));
+    stream.avail_in = static_cast<uInt>(input.size());
+
+    int status;
+    while (true) {
+        const auto written = static_cast<int>(stream.total_out);
+        if (written == chunk.data.size()) {
+            chunk.data.resize(chunk.data.size() * 2);
+        }
+        stream.next_out = reinterpret_cast<Bytef*>(chunk.data.data()) + written;
+        stream.avail_out = static_cast<uInt>(chunk.data.size() - written);
+
+        status = deflate(&stream, flush);
+        if (status != Z_OK && status != Z_BUF_ERROR) {
+            break;
+        }
+        if (stream.avail_out != 0 && (status == Z_BUF_ERROR || (!last && stream.avail_in == 0))) {
+            break;
+        }
+    }
+
+    chunk.ok = last ? status == Z_STREAM_END : status != Z_STREAM_ERROR;
+    chunk.data.resize(static_cast<int>(stream.total_out));
+    deflateEnd(&stream);
+    return chunk;
+}
@@ -0,0 +1,82 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEEPASSX_PARALLELGZIPSTREAM_H
+#define KEEPASSX_PARALLELGZIPSTREAM_H
+
+#include <QFuture>
+#include <QQueue>
+
+#include "streams/LayeredStream.h"
+
+/**
+ * Write-only stream producing a single gzip member.
+ *
+ * Input is split into chunks that are deflated independently on the global
+ * thread pool. Every chunk is primed with the last 32 KiB of the preceding
+ * input and ends on a sync-flush boundary, so the chunks concatenate into one
+ * standard deflate stream that any gzip reader can inflate.
+ */
+class ParallelGzipStream : public LayeredStream
+{
+    Q_OBJECT
+
+public:
+    static const int DefaultChunkSize = 128 * 1024;
+
+    explicit ParallelGzipStream(QIODevice* baseDevice, int compressionLevel = 6, int chunkSize = DefaultChunkSize);
+    ~ParallelGzipStream() override;
+
+    bool open(QIODevice::OpenMode mode) override;
+    bool reset() override;
+    void close() override;
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 maxSize) override;
+
+private:
+    struct Chunk
+    {
+        QByteArray data;
+        quint32 crc = 0;
+        int inputSize = 0;
+        bool ok = false;
+    };
+
+    static Chunk deflateChunk(const QByteArray& input, const QByteArray& dictionary, int level, bool last);
+
+    void init();
+    void dispatch(const QByteArray& input, bool last);
+    bool writeChunk(const Chunk& chunk);
+    bool writeFinished(int maxPending);
+    bool finish();
+    bool writeBase(const QByteArray& data);
+
+    const int m_compressionLevel;
+    const int m_chunkSize;
+    const int m_maxPending;
+    QByteArray m_buffer;
+    QByteArray m_dictionary;
+    QQueue<QFuture<Chunk>> m_pending;
+    quint32 m_crc;
+    quint32 m_inputSize;
+    bool m_finished;
+    bool m_error;
+};
+
+#endif // KEEPASSX_PARALLELGZIPSTREAM_H
@@ -33,6 +33,7 @@
 #include "cli/AttachmentExport.h"
 #include "cli/AttachmentImport.h"
 #include "cli/AttachmentRemove.h"
+#include "cli/Batch.h"
 #include "cli/Clip.h"
 #include "cli/DatabaseCreate.h"
 #include "cli/DatabaseEdit.h"
@@ -42,6 +43,7 @@
 #include "cli/Estimate.h"
 #include "cli/Export.h"
 #include "cli/Generate.h"
+#include "cli/GenerateDatabase.h"
 #include "cli/Help.h"
 #include "cli/Import.h"
 #include "cli/List.h"
@@ -52,9 +54,13 @@
 #include "cli/RemoveGroup.h"
 #include "cli/Search.h"
 #include "cli/Show.h"
+#include "cli/ShowTotp.h"
 #include "cli/Utils.h"
 
 #include <QClipboard>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QSignalSpy>
 #include <QTest>
 #include <QtConcurrent>
@@ -227,6 +233,7 @@ void TestCli::testBatchCommands()
     QVERIFY(Commands::getCommand("attachment-export"));
     QVERIFY(Commands::getCommand("attachment-import"));
     QVERIFY(Commands::getCommand("attachment-rm"));
+    QVERIFY(Commands::getCommand("batch"));
     QVERIFY(Commands::getCommand("clip"));
     QVERIFY(Commands::getCommand("close"));
     QVERIFY(Commands::getCommand("db-create"));
@@ -236,6 +243,7 @@ void TestCli::testBatchCommands()
     QVERIFY(Commands::getCommand("estimate"));
     QVERIFY(Commands::getCommand("export"));
     QVERIFY(Commands::getCommand("generate"));
+    QVERIFY(Commands::getCommand("generate-db"));
     QVERIFY(Commands::getCommand("help"));
     QVERIFY(Commands::getCommand("import"));
     QVERIFY(Commands::getCommand("ls"));
@@ -247,8 +255,9 @@ void TestCli::testBatchCommands()
     QVERIFY(Commands::getCommand("rmdir"));
     QVERIFY(Commands::getCommand("show"));
     QVERIFY(Commands::getCommand("search"));
+    QVERIFY(Commands::getCommand("totp"));
     QVERIFY(!Commands::getCommand("doesnotexist"));
-    QCOMPARE(Commands::getCommands().size(), 26);
+    QCOMPARE(Commands::getCommands().size(), 29);
 }
 
 void TestCli::testInteractiveCommands()
@@ -266,8 +275,10 @@ void TestCli::testInteractiveCommands()
     QVERIFY(Commands::getCommand("diceware"));
     QVERIFY(Commands::getCommand("edit"));
     QVERIFY(Commands::getCommand("estimate"));
+    QVERIFY(!Commands::getCommand("batch"));
     QVERIFY(Commands::getCommand("exit"));
     QVERIFY(Commands::getCommand("generate"));
+    QVERIFY(Commands::getCommand("generate-db"));
     QVERIFY(Commands::getCommand("help"));
     QVERIFY(Commands::getCommand("ls"));
     QVERIFY(Commands::getCommand("merge"));
@@ -279,8 +290,9 @@ void TestCli::testInteractiveCommands()
     QVERIFY(Commands::getCommand("rmdir"));
     QVERIFY(Commands::getCommand("show"));
     QVERIFY(Commands::getCommand("search"));
+    QVERIFY(Commands::getCommand("totp"));
     QVERIFY(!Commands::getCommand("doesnotexist"));
-    QCOMPARE(Commands::getCommands().size(), 26);
+    QCOMPARE(Commands::getCommands().size(), 28);
 }
 
 void TestCli::testAdd()
@@ -628,6 +640,78 @@ void TestCli::testAttachmentRemove()
     QVERIFY(!db->rootGroup()->findEntryByPath("/Sample Entry")->attachments()->hasKey("Sample attachment.txt"));
 }
 
+void TestCli::testBatch()
+{
+    Batch batchCmd;
+    QVERIFY(!batchCmd.name.isEmpty());
+    QVERIFY(batchCmd.getDescriptionLine().contains(batchCmd.name));
+
+    setInput({"a",
+              R"({"op":"show","id":1,"entry":"/Sample Entry","attributes":["UserName","Password"]})",
+              R"({"op":"add","id":2,"entry":"/General/batched","username":"batchuser","password":"batchpass"})",
+              R"({"op":"edit","id":3,"entry":"/Sample Entry","notes":"batched notes"})",
+              R"({"op":"mv","id":4,"entry":"/Sample Entry","group":"/Homebanking"})",
+              R"({"op":"show","id":5,"entry":"/does/not/exist"})",
+              "not json",
+              R"({"op":"attachment-export","id":6,"entry":"/Homebanking/Sample Entry","attachment":"missing"})",
+              R"({"op":"unknown","id":7})"});
+    QCOMPARE(execCmd(batchCmd, {"batch", m_dbFile->fileName()}), EXIT_FAILURE);
+    m_stderr->readLine(); // skip password prompt
+    QCOMPARE(m_stderr->readAll(), QByteArray());
+
+    auto results = m_stdout->readAll().split('\n');
+    results.removeAll({});
+    QCOMPARE(results.size(), 8);
+
+    auto result = QJsonDocument::fromJson(results[0]).object();
+    QCOMPARE(result.value("id").toInt(), 1);
+    QVERIFY(result.value("ok").toBool());
+    QCOMPARE(result.value("attributes").toObject().value("UserName").toString(), QString("User Name"));
+    QCOMPARE(result.value("attributes").toObject().value("Password").toString(), QString("Password"));
+
+    result = QJsonDocument::fromJson(results[1]).object();
+    QCOMPARE(result.value("id").toInt(), 2);
+    QVERIFY(result.value("ok").toBool());
+    QVERIFY(!result.value("uuid").toString().isEmpty());
+
+    for (int i = 2; i < 4; ++i) {
+        QVERIFY(QJsonDocument::fromJson(results[i]).object().value("ok").toBool());
+    }
+
+    result = QJsonDocument::fromJson(results[4]).object();
+    QVERIFY(!result.value("ok").toBool());
+    QCOMPARE(result.value("error").toString(), QString("Could not find entry with path /does/not/exist."));
+    QVERIFY(!QJsonDocument::fromJson(results[5]).object().value("ok").toBool());
+    QVERIFY(!QJsonDocument::fromJson(results[6]).object().value("ok").toBool());
+    QCOMPARE(QJsonDocument::fromJson(results[7]).object().value("error").toString(),
+             QString("Unknown operation unknown."));
+
+    // All modifications are saved at the end, despite the failed operations
+    auto db = readDatabase();
+    QVERIFY(db);
+    auto* entry = db->rootGroup()->findEntryByPath("/General/batched");
+    QVERIFY(entry);
+    QCOMPARE(entry->username(), QString("batchuser"));
+    QCOMPARE(entry->password(), QString("batchpass"));
+    entry = db->rootGroup()->findEntryByPath("/Homebanking/Sample Entry");
+    QVERIFY(entry);
+    QCOMPARE(entry->notes(), QString("batched notes"));
+
+    // Dry run leaves the database untouched and stop on error skips the remaining operations
+    setInput({"a",
+              R"({"op":"rm","entry":"/General/batched"})",
+              R"({"op":"rm","entry":"/does/not/exist"})",
+              R"({"op":"rm","entry":"/Homebanking/Sample Entry"})"});
+    QCOMPARE(execCmd(batchCmd, {"batch", "--dry-run", "--stop-on-error", m_dbFile->fileName()}), EXIT_FAILURE);
+    results = m_stdout->readAll().split('\n');
+    results.removeAll({});
+    QCOMPARE(results.size(), 2);
+
+    db = readDatabase();
+    QVERIFY(db->rootGroup()->findEntryByPath("/General/batched"));
+    QVERIFY(db->rootGroup()->findEntryByPath("/Homebanking/Sample Entry"));
+}
+
 void TestCli::testClip()
 {
     if (QProcessEnvironment::systemEnvironment().contains("WAYLAND_DISPLAY")) {
@@ -1064,6 +1148,12 @@ void TestCli::testDiceware()
     execCmd(dicewareCmd, {"diceware", "-W", "bleuh"});
     QCOMPARE(m_stderr->readLine(), QByteArray("Invalid word count bleuh\n"));
 
+    execCmd(dicewareCmd, {"diceware", "-W", "3", "--count", "4"});
+    for (int i = 0; i < 4; ++i) {
+        QCOMPARE(QString(m_stdout->readLine()).split(" ").size(), 3);
+    }
+    QCOMPARE(m_stdout->readLine(), QByteArray());
+
     TemporaryFile wordFile;
     wordFile.open();
     for (int i = 0; i < 4500; ++i) {
@@ -1311,6 +1401,13 @@ void TestCli::testExport()
     QVERIFY(csvData.contains(QByteArray(
         "\"NewDatabase\",\"Sample Entry\",\"User Name\",\"Password\",\"http://www.somesite.com/\",\"Notes\"")));
 
+    // Export statistics
+    setInput("a");
+    execCmd(exportCmd, {"export", "-f", "csv", "--stats", m_dbFile->fileName()});
+    m_stderr->readLine(); // Skip password prompt
+    QVERIFY(m_stderr->readLine().startsWith("Exported "));
+    QVERIFY(m_stdout->readLine().contains("\"Group\",\"Title\""));
+
     // test invalid format
     setInput("a");
     execCmd(exportCmd, {"export", "-f", "yaml", m_dbFile->fileName()});
@@ -1383,6 +1480,99 @@ void TestCli::testGenerate()
     // Testing with invalid word count format
     execCmd(generateCmd, {"generate", "-L", "bleuh"});
     QCOMPARE(m_stderr->readLine(), QByteArray("Invalid password length bleuh\n"));
+
+    // Generating several passwords at once
+    execCmd(generateCmd, {"generate", "--count", "5", "-L", "12"});
+    for (int i = 0; i < 5; ++i) {
+        QCOMPARE(m_stdout->readLine().trimmed().size(), 12);
+    }
+    QCOMPARE(m_stdout->readLine(), QByteArray());
+
+    execCmd(generateCmd, {"generate", "--count", "0"});
+    QCOMPARE(m_stderr->readLine(), QByteArray("Invalid count 0\n"));
+}
+
+void TestCli::testGenerateDatabase()
+{
+    GenerateDatabase generateDbCmd;
+    QVERIFY(!generateDbCmd.name.isEmpty());
+    QVERIFY(generateDbCmd.getDescriptionLine().contains(generateDbCmd.name));
+
+    QScopedPointer<QTemporaryDir> testDir(new QTemporaryDir());
+    const QStringList options = {"--entries",
+                                 "40",
+                                 "--groups",
+                                 "8",
+                                 "--depth",
+                                 "2",
+                                 "--history",
+                                 "3",
+                                 "--attachments",
+                                 "50",
+                                 "--attachment-size",
+                                 "256",
+                                 "--icons",
+                                 "2",
+                                 "--references",
+                                 "20",
+                                 "--seed",
+                                 "42",
+                                 "-p"};
+
+    QStringList paths;
+    for (const auto& name : {"/generated1.kdbx", "/generated2.kdbx"}) {
+        paths.append(testDir->path() + name);
+        setInput({"a", "a"});
+        execCmd(generateDbCmd, QStringList({"generate-db", paths.last()}) + options);
+        QCOMPARE(m_stderr->readLine(), QByteArray("Enter password to encrypt database (optional): \n"));
+        QCOMPARE(m_stderr->readLine(), QByteArray("Repeat password: \n"));
+        QCOMPARE(m_stdout->readLine(), QByteArray("Successfully generated database with 40 entries.\n"));
+    }
+
+    auto db1 = readDatabase(paths.at(0), "a");
+    auto db2 = readDatabase(paths.at(1), "a");
+    QVERIFY(db1);
+    QVERIFY(db2);
+
+    const auto entries1 = db1->rootGroup()->entriesRecursive();
+    const auto entries2 = db2->rootGroup()->entriesRecursive();
+    QCOMPARE(entries1.size(), 40);
+    QCOMPARE(db1->rootGroup()->groupsRecursive(false).size(), 8);
+    QCOMPARE(db1->metadata()->customIconsOrder().size(), 2);
+
+    // The same seed produces the same content
+    QCOMPARE(entries2.size(), entries1.size());
+    for (int i = 0; i < entries1.size(); ++i) {
+        QCOMPARE(entries2[i]->uuid(), entries1[i]->uuid());
+        QCOMPARE(entries2[i]->password(), entries1[i]->password());
+        QCOMPARE(entries2[i]->attachments()->keys(), entries1[i]->attachments()->keys());
+        QCOMPARE(entries2[i]->historyItems().size(), 3);
+        QCOMPARE(entries2[i]->timeInfo().creationTime(), entries1[i]->timeInfo().creationTime());
+        int depth = 0;
+        for (auto group = entries1[i]->group(); group->parentGroup(); group = group->parentGroup()) {
+            ++depth;
+        }
+        QVERIFY(depth <= 2);
+    }
+
+    // A depth of zero keeps all entries in the root group
+    const auto flatPath = testDir->path() + "/flat.kdbx";
+    setInput({"a", "a"});
+    execCmd(generateDbCmd, {"generate-db", flatPath, "--entries", "10", "--groups", "5", "--depth", "0", "-p"});
+    m_stderr->readAll();
+    QCOMPARE(m_stdout->readLine(), QByteArray("Successfully generated database with 10 entries.\n"));
+    auto flatDb = readDatabase(flatPath, "a");
+    QVERIFY(flatDb);
+    QVERIFY(flatDb->rootGroup()->children().isEmpty());
+    QCOMPARE(flatDb->rootGroup()->entries().size(), 10);
+
+    // Refuses to overwrite an existing file
+    execCmd(generateDbCmd, {"generate-db", paths.at(0), "-p"});
+    QCOMPARE(m_stdout->readAll(), QByteArray());
+    QCOMPARE(m_stderr->readAll(), QString("File " + paths.at(0) + " already exists.\n").toUtf8());
+
+    execCmd(generateDbCmd, {"generate-db", testDir->path() + "/invalid.kdbx", "--entries", "-5", "-p"});
+    QCOMPARE(m_stderr->readAll(), QByteArray("Invalid value -5 for --entries.\n"));
 }
 
 void TestCli::testImport()
@@ -2196,6 +2386,45 @@ void TestCli::testShow()
                         "testattribute1: a\n"));
 }
 
+void TestCli::testShowTotp()
+{
+    ShowTotp totpCmd;
+    QVERIFY(!totpCmd.name.isEmpty());
+    QVERIFY(totpCmd.getDescriptionLine().contains(totpCmd.name));
+
+    setInput("a");
+    execCmd(totpCmd, {"totp", m_dbFile->fileName(), "/Sample Entry"});
+    QVERIFY(isTotp(m_stdout->readAll()));
+
+    setInput("a");
+    execCmd(totpCmd, {"totp", "--all", m_dbFile->fileName()});
+    auto line = QString::fromUtf8(m_stdout->readLine());
+    QVERIFY(line.startsWith("/Sample Entry: "));
+    QVERIFY(isTotp(line.mid(QString("/Sample Entry: ").size())));
+    QCOMPARE(m_stdout->readAll(), QByteArray());
+
+    setInput("a");
+    execCmd(totpCmd, {"totp", "--next", m_dbFile->fileName(), "/Sample Entry"});
+    auto fields = QString::fromUtf8(m_stdout->readAll()).trimmed().split(" ");
+    QCOMPARE(fields.size(), 3);
+    QVERIFY(isTotp(fields[0]));
+    QVERIFY(isTotp(fields[1]));
+    QVERIFY(fields[2].toUInt() >= 1 && fields[2].toUInt() <= 30);
+
+    setInput("a");
+    execCmd(totpCmd, {"totp", m_dbFile2->fileName(), "/Sample Entry"});
+    QCOMPARE(m_stdout->readAll(), QByteArray());
+    QVERIFY(m_stderr->readAll().contains("Entry with path /Sample Entry has no TOTP set up.\n"));
+
+    setInput("a");
+    execCmd(totpCmd, {"totp", "--all", m_dbFile->fileName(), "/Sample Entry"});
+    QVERIFY(m_stderr->readAll().contains("Specify either an entry or --all.\n"));
+
+    setInput("a");
+    execCmd(totpCmd, {"totp", m_dbFile->fileName()});
+    QVERIFY(m_stderr->readAll().contains("Specify either an entry or --all.\n"));
+}
+
 void TestCli::testInvalidDbFiles()
 {
     Show showCmd;
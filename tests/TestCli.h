@@ -50,6 +50,7 @@ private slots:
     void testAttachmentExport();
     void testAttachmentImport();
     void testAttachmentRemove();
+    void testBatch();
     void testClip();
     void testCommandParsing_data();
     void testCommandParsing();
@@ -62,6 +63,7 @@ private slots:
     void testExport();
     void testGenerate_data();
     void testGenerate();
+    void testGenerateDatabase();
     void testImport();
     void testInfo();
     void testKeyFileOption();
@@ -78,6 +80,7 @@ private slots:
     void testRemoveQuiet();
     void testSearch();
     void testShow();
+    void testShowTotp();
     void testInvalidDbFiles();
     void testYubiKeyOption();
     void testNonAscii();
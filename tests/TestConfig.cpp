@@ -40,3 +40,41 @@ void TestConfig::testUpgrade()
 
     tempFile.remove();
 }
+
+void TestConfig::testSnapshot()
+{
+    TemporaryFile tempFile;
+    QVERIFY(tempFile.open());
+    tempFile.write("[General]\nAutoTypeDelay=40\n\n[GUI]\nHideUsernames=true\n");
+    tempFile.close();
+    Config::createConfigFromFile(tempFile.fileName());
+
+    // Values read from the file are converted to the type of their default
+    auto snapshot = config()->snapshot();
+    QCOMPARE(snapshot->get(Config::AutoTypeDelay).userType(), static_cast<int>(QMetaType::Int));
+    QCOMPARE(snapshot->getInt(Config::AutoTypeDelay), 40);
+    QVERIFY(snapshot->getBool(Config::GUI_HideUsernames));
+    QCOMPARE(snapshot->getString(Config::GUI_Language), QString("system"));
+
+    // Changes replace the snapshot, previous snapshots are left untouched
+    config()->set(Config::AutoTypeDelay, 10);
+    QCOMPARE(snapshot->getInt(Config::AutoTypeDelay), 40);
+    QCOMPARE(config()->snapshot()->getInt(Config::AutoTypeDelay), 10);
+    QCOMPARE(config()->get(Config::AutoTypeDelay).toInt(), 10);
+
+    // Superseded snapshots are freed once released
+    std::weak_ptr<const Config::Snapshot> previous = snapshot;
+    snapshot.reset();
+    QVERIFY(previous.expired());
+    previous = config()->snapshot();
+    config()->set(Config::AutoTypeDelay, 20);
+    QVERIFY(previous.expired());
+
+    config()->remove(Config::AutoTypeDelay);
+    QCOMPARE(config()->get(Config::AutoTypeDelay).toInt(), 25);
+
+    config()->resetToDefaults();
+    QVERIFY(!config()->snapshot()->getBool(Config::GUI_HideUsernames));
+
+    tempFile.remove();
+}
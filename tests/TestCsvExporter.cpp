@@ -77,6 +77,8 @@ void TestCsvExporter::testExport()
     exported.remove(expectedResult);
     QVERIFY(exported.contains("otpauth://"));
     QVERIFY(exported.contains(",\"5\","));
+    QCOMPARE(m_csvExporter->exportedRows(), qint64(1));
+    QCOMPARE(m_csvExporter->exportedBytes(), qint64(buffer.size()));
 }
 
 void TestCsvExporter::testEmptyDatabase()
@@ -110,3 +112,32 @@ void TestCsvExporter::testNestedGroups()
             .append(ExpectedHeaderLine)
             .append("\"Passwords/Test Group Name/Test Sub Group Name\",\"Test Entry Title\",\"\",\"\",\"\",\"\"")));
 }
+
+void TestCsvExporter::testLargeExport()
+{
+    // Enough rows to be written out in several chunks
+    const int count = 5000;
+    auto* group = new Group();
+    group->setName("Large Group");
+    group->setParent(m_db->rootGroup());
+    for (int i = 0; i < count; ++i) {
+        auto* entry = new Entry();
+        entry->setGroup(group);
+        entry->setTitle(QString("Entry %1").arg(i));
+        entry->setNotes(QString("Notes with \"quotes\" %1").arg(i));
+    }
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::ReadWrite));
+    QVERIFY(m_csvExporter->exportDatabase(&buffer, m_db));
+    QCOMPARE(m_csvExporter->exportedRows(), qint64(count));
+    QCOMPARE(m_csvExporter->exportedBytes(), buffer.size());
+
+    auto lines = buffer.buffer().split('\n');
+    // header, one line per entry and the empty remainder after the last newline
+    QCOMPARE(lines.size(), count + 2);
+    QVERIFY(lines.at(1).startsWith("\"Passwords/Large Group\",\"Entry 0\""));
+    QVERIFY(lines.at(count).contains(QString("\"Notes with \"\"quotes\"\" %1\"").arg(count - 1).toUtf8()));
+
+    QCOMPARE(m_csvExporter->exportDatabase(m_db), QString::fromUtf8(buffer.buffer()));
+}
@@ -19,6 +19,7 @@
 #include "TestCsvParser.h"
 
 #include <QTest>
+#include <QTextStream>
 
 QTEST_GUILESS_MAIN(TestCsvParser)
 
@@ -341,3 +342,33 @@ void TestCsvParser::testUnicode()
     QVERIFY(t.at(0).at(2) == "3śAż");
     QVERIFY(t.at(0).at(3) == "żac");
 }
+
+void TestCsvParser::benchmarkParse()
+{
+    QByteArray env = qgetenv("BENCHMARK");
+
+    if (env.isEmpty() || env == "0" || env == "no") {
+        QSKIP("Benchmark skipped. Set env variable BENCHMARK=1 to enable.");
+    }
+
+    const int rows = 200000;
+    QTextStream out(file.data());
+    out.setCodec("UTF-8");
+    out << "Group,Title,Username,Password,URL,Notes\r\n";
+    for (int i = 0; i < rows; ++i) {
+        out << "Root/Imported," << "Entry " << i << ",user" << i << "@example.com,"
+            << "\"p4ss,\"\"word\"\"" << i << "\",https://example.com/" << i << ","
+            << "\"multi\r\nline notes\"\r\n";
+    }
+    out.flush();
+
+    QVERIFY(parser->parse(file.data()));
+    QCOMPARE(parser->getCsvRows(), rows + 1);
+
+    QBENCHMARK
+    {
+        Q_UNUSED(parser->reparse());
+    };
+
+    qInfo("Parsed %d bytes in %d rows", parser->getFileSize(), parser->getCsvRows());
+}
@@ -56,6 +56,7 @@ private slots:
     void testQuoted();
     void testMultiline();
     void testColumns();
+    void benchmarkParse();
 
 private:
     QScopedPointer<QTemporaryFile> file;
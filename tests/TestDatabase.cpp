@@ -23,7 +23,10 @@
 #include <QTest>
 
 #include "config-keepassx-tests.h"
+#include "core/DatabaseReloader.h"
+#include "core/DatabaseSnapshot.h"
 #include "core/Group.h"
+#include "core/LatencyStats.h"
 #include "core/Metadata.h"
 #include "core/Tools.h"
 #include "crypto/Crypto.h"
@@ -39,6 +42,27 @@ QTEST_GUILESS_MAIN(TestDatabase)
 
 static QString dbFileName = QStringLiteral(KEEPASSX_TEST_DATA_DIR).append("/NewDatabase.kdbx");
 
+namespace
+{
+    // Password key counting how often its raw key is read, once per key transformation
+    class CountingPasswordKey : public PasswordKey
+    {
+    public:
+        explicit CountingPasswordKey(const QString& password)
+            : PasswordKey(password)
+        {
+        }
+
+        QByteArray rawKey() const override
+        {
+            ++transforms;
+            return PasswordKey::rawKey();
+        }
+
+        mutable int transforms = 0;
+    };
+} // namespace
+
 void TestDatabase::initTestCase()
 {
     QVERIFY(Crypto::init());
@@ -138,6 +162,248 @@ void TestDatabase::testSaveAs()
     QCOMPARE(error, QString("Could not save, database has not been initialized!"));
 }
 
+void TestDatabase::testSaveInBackground()
+{
+    TemporaryFile tempFile;
+    QVERIFY(tempFile.copyFromFile(dbFileName));
+
+    auto db = QSharedPointer<Database>::create();
+    auto key = QSharedPointer<CompositeKey>::create();
+    key->addKey(QSharedPointer<PasswordKey>::create("a"));
+
+    QString error;
+    QVERIFY(db->open(tempFile.fileName(), key, &error));
+
+    const auto oldSeed = db->kdf()->seed();
+    const int latencySamples = Database::saveLatency().count();
+    QSignalSpy spySaveFinished(db.data(), SIGNAL(saveFinished(bool, const QString&)));
+
+    db->metadata()->setName("background1");
+    db->saveInBackground();
+    QVERIFY(db->isSaving());
+    QVERIFY(!db->saveAs(tempFile.fileName(), Database::Atomic, QString(), &error));
+    QCOMPARE(error, QString("Database save is already in progress."));
+
+    // Requests made while saving are coalesced into a single save
+    db->metadata()->setName("background2");
+    db->saveInBackground(Database::TempFile);
+    db->metadata()->setName("background3");
+    db->saveInBackground(Database::TempFile);
+
+    QTRY_VERIFY(!db->isSaving());
+    QCOMPARE(spySaveFinished.count(), 1);
+    QVERIFY2(spySaveFinished.first().at(0).toBool(), spySaveFinished.first().at(1).toString().toLatin1());
+    QVERIFY(!db->isModified());
+    QVERIFY(db->kdf()->seed() != oldSeed);
+    QCOMPARE(Database::saveLatency().count(), qMin(latencySamples + 1, 128));
+
+    // The file is readable with the key that was transformed in the background
+    auto reloaded = QSharedPointer<Database>::create();
+    QVERIFY2(reloaded->open(tempFile.fileName(), key, &error), error.toLatin1());
+    QCOMPARE(reloaded->metadata()->name(), QString("background3"));
+
+    // Changes made after a save started are not part of it
+    db->saveInBackground();
+    db->metadata()->setName("background4");
+    QTRY_VERIFY(!db->isSaving());
+    QCOMPARE(spySaveFinished.count(), 2);
+    QVERIFY(db->isModified());
+    reloaded = QSharedPointer<Database>::create();
+    QVERIFY2(reloaded->open(tempFile.fileName(), key, &error), error.toLatin1());
+    QCOMPARE(reloaded->metadata()->name(), QString("background3"));
+
+    // Releasing the data waits for a running save
+    const auto entries = db->rootGroup()->entriesRecursive();
+    QVERIFY(!entries.isEmpty());
+    const auto entryUuid = entries.first()->uuid();
+    const auto locationChanged = entries.first()->timeInfo().locationChanged();
+    db->saveInBackground();
+    QVERIFY(db->isSaving());
+    db->releaseData();
+    QVERIFY(!db->isSaving());
+    QCOMPARE(spySaveFinished.count(), 3);
+    QVERIFY(spySaveFinished.last().at(0).toBool());
+    db = QSharedPointer<Database>::create();
+    QVERIFY2(db->open(tempFile.fileName(), key, &error), error.toLatin1());
+    QCOMPARE(db->metadata()->name(), QString("background4"));
+    QCOMPARE(db->rootGroup()->entriesRecursive().size(), entries.size());
+    // Copying the entries for the save does not touch their timestamps
+    QCOMPARE(db->rootGroup()->findEntryByUuid(entryUuid)->timeInfo().locationChanged(), locationChanged);
+
+    // Errors are reported through the signal
+    QSignalSpy spySaveFailed(db.data(), SIGNAL(saveFinished(bool, const QString&)));
+    db->metadata()->setName("background5");
+    db->setFilePath(QStringLiteral("/nonexistent/directory/NewDatabase.kdbx"));
+    db->saveInBackground();
+    QTRY_COMPARE(spySaveFailed.count(), 1);
+    QVERIFY(!spySaveFailed.first().at(0).toBool());
+    QVERIFY(!spySaveFailed.first().at(1).toString().isEmpty());
+    QVERIFY(db->isModified());
+}
+
+void TestDatabase::testReuseTransformedKey()
+{
+    TemporaryFile tempFile;
+    QVERIFY(tempFile.copyFromFile(dbFileName));
+
+    // Every key transformation derives the KDF input from the password key
+    auto passwordKey = QSharedPointer<CountingPasswordKey>::create("a");
+    auto key = QSharedPointer<CompositeKey>::create();
+    key->addKey(passwordKey);
+
+    auto db = QSharedPointer<Database>::create();
+    QString error;
+    QVERIFY2(db->open(tempFile.fileName(), key, &error), error.toLatin1());
+    QCOMPARE(passwordKey->transforms, 1);
+
+    // Reload an unchanged file using the transformed key of the open database
+    auto reloaded = QSharedPointer<Database>::create(tempFile.fileName());
+    reloaded->reuseTransformedKeyFrom(*db);
+    QVERIFY2(reloaded->open(key, &error), error.toLatin1());
+    QCOMPARE(passwordKey->transforms, 1);
+    QCOMPARE(reloaded->transformedDatabaseKey(), db->transformedDatabaseKey());
+    QCOMPARE(reloaded->rootGroup()->entriesRecursive().size(), db->rootGroup()->entriesRecursive().size());
+
+    // Without an offered key the KDF runs
+    reloaded = QSharedPointer<Database>::create(tempFile.fileName());
+    QVERIFY2(reloaded->open(key, &error), error.toLatin1());
+    QCOMPARE(passwordKey->transforms, 2);
+
+    // Saving randomizes the KDF seed, the saving database holds the key for the new seed
+    db->metadata()->setName("reuse");
+    QVERIFY2(db->save(Database::Atomic, {}, &error), error.toLatin1());
+    QCOMPARE(passwordKey->transforms, 3);
+    reloaded = QSharedPointer<Database>::create(tempFile.fileName());
+    reloaded->reuseTransformedKeyFrom(*db);
+    QVERIFY2(reloaded->open(key, &error), error.toLatin1());
+    QCOMPARE(passwordKey->transforms, 3);
+    QCOMPARE(reloaded->metadata()->name(), QString("reuse"));
+
+    // A file saved by another copy has a new seed, the offered key does not fit
+    QVERIFY2(reloaded->save(Database::Atomic, {}, &error), error.toLatin1());
+    QCOMPARE(passwordKey->transforms, 4);
+    auto reloadedAgain = QSharedPointer<Database>::create(tempFile.fileName());
+    reloadedAgain->reuseTransformedKeyFrom(*db);
+    QVERIFY2(reloadedAgain->open(key, &error), error.toLatin1());
+    QCOMPARE(passwordKey->transforms, 5);
+
+    // A different key object never reuses the cached key
+    auto wrongKey = QSharedPointer<CompositeKey>::create();
+    wrongKey->addKey(QSharedPointer<PasswordKey>::create("b"));
+    reloaded = QSharedPointer<Database>::create(tempFile.fileName());
+    reloaded->reuseTransformedKeyFrom(*db);
+    QVERIFY(!reloaded->open(wrongKey, &error));
+}
+
+void TestDatabase::testReloadInPlace()
+{
+    auto key = QSharedPointer<CompositeKey>::create();
+    key->addKey(QSharedPointer<PasswordKey>::create("a"));
+
+    auto target = QSharedPointer<Database>::create();
+    auto source = QSharedPointer<Database>::create();
+    QString error;
+    QVERIFY2(target->open(dbFileName, key, &error), error.toLatin1());
+    QVERIFY2(source->open(dbFileName, key, &error), error.toLatin1());
+
+    auto targetEntries = target->rootGroup()->entriesRecursive();
+    QVERIFY(targetEntries.size() >= 2);
+    auto unchanged = targetEntries.at(0);
+    const auto unchangedUuid = unchanged->uuid();
+    auto edited = targetEntries.at(1);
+
+    // Change the source the way another client would
+    auto sourceEdited = source->rootGroup()->findEntryByUuid(edited->uuid());
+    sourceEdited->setTitle("Edited remotely");
+
+    auto sourceGroup = new Group();
+    sourceGroup->setUuid(QUuid::createUuid());
+    sourceGroup->setName("Added remotely");
+    sourceGroup->setParent(source->rootGroup());
+
+    auto sourceAdded = new Entry();
+    sourceAdded->setUuid(QUuid::createUuid());
+    sourceAdded->setTitle("New entry");
+    sourceAdded->setGroup(sourceGroup);
+
+    QVERIFY(!target->isModified());
+    QSignalSpy groupAdded(target.data(), SIGNAL(groupAdded()));
+
+    DatabaseReloader reloader(source.data(), target.data());
+    QVERIFY(reloader.canReloadInPlace());
+    QVERIFY(reloader.reload());
+    QCOMPARE(reloader.changes(), 3);
+    QCOMPARE(groupAdded.count(), 1);
+
+    // Existing objects are kept and updated in place
+    QCOMPARE(target->rootGroup()->findEntryByUuid(unchanged->uuid()), unchanged);
+    QCOMPARE(target->rootGroup()->findEntryByUuid(edited->uuid()), edited);
+    QCOMPARE(edited->title(), QString("Edited remotely"));
+    QCOMPARE(edited->timeInfo().lastModificationTime(), sourceEdited->timeInfo().lastModificationTime());
+
+    auto targetGroup = target->rootGroup()->findGroupByUuid(sourceGroup->uuid());
+    QVERIFY(targetGroup);
+    QCOMPARE(targetGroup->name(), QString("Added remotely"));
+    QCOMPARE(targetGroup->entries().size(), 1);
+    QCOMPARE(targetGroup->entries().first()->title(), QString("New entry"));
+
+    // Removing items on the source removes them from the target
+    delete sourceAdded;
+    delete source->rootGroup()->findEntryByUuid(unchangedUuid);
+    QVERIFY(reloader.reload());
+    QCOMPARE(reloader.changes(), 2);
+    QVERIFY(!target->rootGroup()->findEntryByUuid(unchangedUuid));
+    QVERIFY(targetGroup->entries().isEmpty());
+    QCOMPARE(target->rootGroup()->entriesRecursive().size(), source->rootGroup()->entriesRecursive().size());
+    QCOMPARE(target->deletedObjects(), source->deletedObjects());
+
+    // Entries follow the order of the source within their group
+    auto sourceFirst = new Entry();
+    sourceFirst->setUuid(QUuid::createUuid());
+    sourceFirst->setGroup(sourceGroup);
+    auto sourceSecond = new Entry();
+    sourceSecond->setUuid(QUuid::createUuid());
+    sourceSecond->setGroup(sourceGroup);
+    QVERIFY(reloader.reload());
+    QCOMPARE(reloader.changes(), 2);
+
+    sourceSecond->moveUp();
+    QVERIFY(reloader.reload());
+    QCOMPARE(reloader.changes(), 1);
+    QCOMPARE(targetGroup->entries().size(), 2);
+    QCOMPARE(targetGroup->entries().at(0)->uuid(), sourceSecond->uuid());
+    QCOMPARE(targetGroup->entries().at(1)->uuid(), sourceFirst->uuid());
+
+    // Icons deleted on the source are deleted from the target
+    const auto icon = QUuid::createUuid();
+    source->metadata()->addCustomIcon(icon, QByteArray("icon"));
+    QVERIFY(reloader.reload());
+    QVERIFY(target->metadata()->hasCustomIcon(icon));
+
+    source->metadata()->removeCustomIcon(icon);
+    QVERIFY(reloader.reload());
+    QVERIFY(!target->metadata()->hasCustomIcon(icon));
+    QCOMPARE(target->metadata()->customIconsOrder(), source->metadata()->customIconsOrder());
+    QCOMPARE(target->deletedObjects(), source->deletedObjects());
+
+    // Nothing changed, nothing to do
+    QVERIFY(reloader.reload());
+    QCOMPARE(reloader.changes(), 0);
+
+    // A reload is not a save
+    QSignalSpy databaseSaved(target.data(), SIGNAL(databaseSaved()));
+    QVERIFY(target->isModified());
+    target->markAsUnmodified();
+    QVERIFY(!target->isModified());
+    QCOMPARE(databaseSaved.count(), 0);
+
+    // A different root group cannot be reloaded in place
+    auto other = QSharedPointer<Database>::create();
+    DatabaseReloader otherReloader(other.data(), target.data());
+    QVERIFY(!otherReloader.canReloadInPlace());
+    QVERIFY(!otherReloader.reload());
+}
+
 void TestDatabase::testSignals()
 {
     TemporaryFile tempFile;
@@ -268,3 +534,86 @@ void TestDatabase::testCustomIcons()
     QCOMPARE(iconData.name, QString("Test"));
     QCOMPARE(iconData.lastModified, date);
 }
+
+void TestDatabase::testSnapshot()
+{
+    Database db;
+    db.metadata()->setRecycleBinEnabled(true);
+    auto group = new Group();
+    group->setName("Group");
+    group->setParent(db.rootGroup());
+
+    auto entry1 = new Entry();
+    entry1->setTitle("Entry 1");
+    entry1->setPassword("password");
+    entry1->setGroup(group);
+    auto entry2 = new Entry();
+    entry2->setTitle("Entry 2");
+    entry2->setPassword("password");
+    entry2->setGroup(db.rootGroup());
+
+    auto snapshot = db.snapshot();
+    QCOMPARE(snapshot->groups().size(), 2);
+    QCOMPARE(snapshot->entries().size(), 2);
+    QCOMPARE(snapshot->groups().at(1).uuid, group->uuid());
+    QCOMPARE(snapshot->hierarchy(1), group->hierarchy());
+    QCOMPARE(snapshot->entriesUsingPassword("password").size(), 2);
+
+    // The snapshot is reused until the database changes
+    QCOMPARE(db.snapshot(), snapshot);
+
+    entry1->setTitle("Changed");
+    auto changed = db.snapshot();
+    QVERIFY(changed != snapshot);
+    QCOMPARE(snapshot->entries().at(1).title, QString("Entry 1"));
+    QCOMPARE(changed->entries().at(1).title, QString("Changed"));
+
+    // Recycled entries are kept but marked
+    db.recycleEntry(entry2);
+    snapshot = db.snapshot();
+    QCOMPARE(snapshot->groups().size(), 3);
+    QVERIFY(snapshot->groups().at(2).recycled);
+    QCOMPARE(snapshot->entries().size(), 2);
+    QVERIFY(snapshot->entries().at(1).recycled);
+    QCOMPARE(snapshot->entriesUsingPassword("password").size(), 1);
+}
+
+void TestDatabase::testCompressionLevel()
+{
+    TemporaryFile tempFile;
+    QVERIFY(tempFile.copyFromFile(dbFileName));
+
+    auto key = QSharedPointer<CompositeKey>::create();
+    key->addKey(QSharedPointer<PasswordKey>::create("a"));
+
+    QString error;
+    auto db = QSharedPointer<Database>::create();
+    QVERIFY2(db->open(tempFile.fileName(), key, &error), error.toLatin1());
+    QCOMPARE(db->compressionLevel(), int(Database::DefaultCompressionLevel));
+    QVERIFY(!db->metadata()->customData()->contains(CustomData::CompressionLevel));
+
+    // The level survives a save and reopen
+    db->setCompressionLevel(9);
+    QCOMPARE(db->metadata()->customData()->value(CustomData::CompressionLevel), QString("9"));
+    QVERIFY2(db->save(Database::Atomic, {}, &error), error.toLatin1());
+
+    auto reopened = QSharedPointer<Database>::create();
+    QVERIFY2(reopened->open(tempFile.fileName(), key, &error), error.toLatin1());
+    QCOMPARE(reopened->compressionLevel(), 9);
+
+    // Out of range levels are clamped, both when set and when read
+    reopened->setCompressionLevel(42);
+    QCOMPARE(reopened->compressionLevel(), 9);
+    reopened->setCompressionLevel(-3);
+    QCOMPARE(reopened->compressionLevel(), 1);
+    reopened->metadata()->customData()->set(CustomData::CompressionLevel, "17");
+    QCOMPARE(reopened->compressionLevel(), 9);
+    reopened->metadata()->customData()->set(CustomData::CompressionLevel, "fast");
+    QCOMPARE(reopened->compressionLevel(), int(Database::DefaultCompressionLevel));
+
+    // The default level is not stored
+    reopened->setCompressionLevel(4);
+    QCOMPARE(reopened->metadata()->customData()->value(CustomData::CompressionLevel), QString("4"));
+    reopened->setCompressionLevel(Database::DefaultCompressionLevel);
+    QVERIFY(!reopened->metadata()->customData()->contains(CustomData::CompressionLevel));
+}
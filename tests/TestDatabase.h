@@ -30,12 +30,17 @@ private slots:
     void testOpen();
     void testSave();
     void testSaveAs();
+    void testSaveInBackground();
+    void testReuseTransformedKey();
+    void testReloadInPlace();
     void testSignals();
     void testEmptyRecycleBinOnDisabled();
     void testEmptyRecycleBinOnNotCreated();
     void testEmptyRecycleBinOnEmpty();
     void testEmptyRecycleBinWithHierarchicalData();
     void testCustomIcons();
+    void testSnapshot();
+    void testCompressionLevel();
 };
 
 #endif // KEEPASSX_TESTDATABASE_H
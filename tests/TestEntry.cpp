@@ -24,6 +24,7 @@
 #include "core/Metadata.h"
 #include "core/TimeInfo.h"
 #include "crypto/Crypto.h"
+#include "crypto/CryptoHash.h"
 
 QTEST_GUILESS_MAIN(TestEntry)
 
@@ -82,6 +83,34 @@ void TestEntry::testCopyDataFrom()
     QCOMPARE(entry2->autoTypeAssociations()->get(1).window, QString("3"));
 }
 
+void TestEntry::testAttachmentDigest()
+{
+    QScopedPointer<Entry> entry(new Entry());
+    auto* attachments = entry->attachments();
+    QVERIFY(attachments->digest("a").isEmpty());
+
+    attachments->set("a", "first");
+    QCOMPARE(attachments->digest("a"), CryptoHash::hash("first", CryptoHash::Sha256));
+
+    // Digest follows the content
+    attachments->set("a", "second");
+    QCOMPARE(attachments->digest("a"), CryptoHash::hash("second", CryptoHash::Sha256));
+
+    attachments->rename("a", "b");
+    QVERIFY(attachments->digest("a").isEmpty());
+    QCOMPARE(attachments->digest("b"), CryptoHash::hash("second", CryptoHash::Sha256));
+
+    // Clones and history items start with the same digests
+    QScopedPointer<Entry> clone(entry->clone(Entry::CloneNoFlags));
+    QCOMPARE(clone->attachments()->digest("b"), attachments->digest("b"));
+
+    attachments->remove("b");
+    QVERIFY(attachments->digest("b").isEmpty());
+    attachments->set("c", "third");
+    attachments->clear();
+    QVERIFY(attachments->digest("c").isEmpty());
+}
+
 void TestEntry::testClone()
 {
     QScopedPointer<Entry> entryOrg(new Entry());
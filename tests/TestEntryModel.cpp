@@ -18,10 +18,13 @@
 #include "TestEntryModel.h"
 
 #include <QSignalSpy>
+#include <QSortFilterProxyModel>
+#include <QStandardItemModel>
 #include <QTest>
 
 #include "core/Entry.h"
 #include "core/Group.h"
+#include "core/Metadata.h"
 #include "crypto/Crypto.h"
 #include "gui/DatabaseIcons.h"
 #include "gui/IconModels.h"
@@ -376,3 +379,302 @@ void TestEntryModel::testDatabaseDelete()
     delete modelTest;
     delete model;
 }
+
+void TestEntryModel::testBulkUpdate()
+{
+    auto model = new EntryModel(this);
+    auto modelTest = new ModelTest(model, this);
+
+    Database db;
+    db.metadata()->setRecycleBinEnabled(true);
+    auto group1 = new Group();
+    group1->setParent(db.rootGroup());
+    auto group2 = new Group();
+    group2->setParent(db.rootGroup());
+
+    QList<Entry*> entries;
+    for (int i = 0; i < 10; ++i) {
+        auto entry = new Entry();
+        entry->setTitle(QString("entry%1").arg(i));
+        entry->setGroup(group1);
+        entries << entry;
+    }
+
+    model->setGroup(group1);
+    QPersistentModelIndex lastIndex = model->index(9, 1);
+    QPersistentModelIndex firstIndex = model->index(0, 1);
+
+    QSignalSpy spyAboutToRemove(model, SIGNAL(rowsAboutToBeRemoved(QModelIndex, int, int)));
+    QSignalSpy spyAboutToAdd(model, SIGNAL(rowsAboutToBeInserted(QModelIndex, int, int)));
+    QSignalSpy spyLayoutAboutToChange(model, SIGNAL(layoutAboutToBeChanged()));
+    QSignalSpy spyLayoutChanged(model, SIGNAL(layoutChanged()));
+
+    // A bulk move removes the rows as one range, no layout change is needed
+    db.moveEntries(entries.mid(0, 5), group2);
+    QCOMPARE(model->rowCount(), 5);
+    QCOMPARE(spyAboutToRemove.count(), 1);
+    QCOMPARE(spyAboutToRemove.last().at(1).toInt(), 0);
+    QCOMPARE(spyAboutToRemove.last().at(2).toInt(), 4);
+    QCOMPARE(spyLayoutAboutToChange.count(), 0);
+    QCOMPARE(spyLayoutChanged.count(), 0);
+    QVERIFY(!firstIndex.isValid());
+    QCOMPARE(lastIndex.row(), 4);
+    QCOMPARE(model->entryFromIndex(lastIndex), entries.at(9));
+
+    // Separate ranges are removed last to first
+    db.deleteEntries({entries.at(5), entries.at(7)});
+    QCOMPARE(model->rowCount(), 3);
+    QCOMPARE(model->entryFromIndex(lastIndex), entries.at(9));
+    QCOMPARE(spyAboutToRemove.count(), 3);
+    QCOMPARE(spyAboutToRemove.at(1).at(1).toInt(), 2);
+    QCOMPARE(spyAboutToRemove.at(2).at(1).toInt(), 0);
+    QCOMPARE(spyLayoutChanged.count(), 0);
+
+    // Search results drop recycled entries and pick up restored ones
+    model->setEntries(entries.mid(0, 5) + QList<Entry*>{entries.at(6), entries.at(8), entries.at(9)});
+    QCOMPARE(model->rowCount(), 8);
+    lastIndex = model->index(7, 1);
+    spyAboutToRemove.clear();
+
+    db.recycleEntries(entries.mid(0, 5));
+    QCOMPARE(model->rowCount(), 3);
+    QCOMPARE(model->entryFromIndex(lastIndex), entries.at(9));
+    QCOMPARE(spyAboutToRemove.count(), 1);
+
+    db.moveEntries(entries.mid(0, 2), group2);
+    QCOMPARE(model->rowCount(), 5);
+    QCOMPARE(model->entryFromIndex(model->index(3, 1)), entries.at(0));
+    QCOMPARE(model->entryFromIndex(model->index(4, 1)), entries.at(1));
+    QCOMPARE(spyAboutToAdd.count(), 1);
+    QCOMPARE(spyAboutToAdd.last().at(1).toInt(), 3);
+    QCOMPARE(spyAboutToAdd.last().at(2).toInt(), 4);
+    QCOMPARE(spyLayoutChanged.count(), 0);
+
+    delete modelTest;
+    delete model;
+}
+
+void TestEntryModel::testRowLookup()
+{
+    auto model = new EntryModel(this);
+    auto modelTest = new ModelTest(model, this);
+
+    Database db;
+    auto group = db.rootGroup();
+
+    QList<Entry*> entries;
+    for (int i = 0; i < 20; ++i) {
+        auto entry = new Entry();
+        entry->setGroup(group);
+        entries << entry;
+    }
+
+    auto verifyRows = [&](const QList<Entry*>& expected) {
+        QCOMPARE(model->rowCount(), expected.size());
+        for (int row = expected.size() - 1; row >= 0; --row) {
+            QCOMPARE(model->indexFromEntry(expected.at(row)).row(), row);
+        }
+    };
+
+    model->setGroup(group);
+    verifyRows(group->entries());
+
+    group->moveEntryUp(entries.at(10));
+    group->moveEntryDown(entries.at(3));
+    verifyRows(group->entries());
+
+    delete entries.takeAt(0);
+    delete entries.takeAt(7);
+    verifyRows(group->entries());
+
+    auto entry = new Entry();
+    entry->setGroup(group);
+    verifyRows(group->entries());
+
+    // Search results keep their own order
+    QList<Entry*> results = {entries.at(15), entries.at(2), entries.at(9), entries.at(4)};
+    model->setEntries(results);
+    verifyRows(results);
+
+    delete results.takeAt(1);
+    verifyRows(results);
+    QVERIFY(!model->indexFromEntry(entry).isValid());
+
+    delete modelTest;
+    delete model;
+}
+
+void TestEntryModel::testVirtualizedSearch()
+{
+    Database db;
+    auto group = db.rootGroup();
+
+    const int count = EntryModel::VirtualizationThreshold + EntryModel::FetchBatchSize / 2;
+    QList<Entry*> entries;
+    for (int i = 0; i < count; ++i) {
+        auto entry = new Entry();
+        entry->setTitle(QString("entry%1").arg(count - i, 6, 10, QChar('0')));
+        entry->setGroup(group);
+        entries << entry;
+    }
+
+    auto model = new EntryModel(this);
+    model->setEntries(entries);
+    QVERIFY(model->isVirtualized());
+    QCOMPARE(model->rowCount(), EntryModel::FetchBatchSize);
+    QVERIFY(model->canFetchMore({}));
+
+    QSignalSpy spyInserted(model, SIGNAL(rowsInserted(QModelIndex, int, int)));
+    model->fetchMore({});
+    QCOMPARE(model->rowCount(), EntryModel::FetchBatchSize * 2);
+    QCOMPARE(spyInserted.count(), 1);
+
+    // Sorting happens in the background and is applied as a layout change
+    QPersistentModelIndex first = model->index(0, EntryModel::Title);
+    QSignalSpy spyLayoutChanged(model, SIGNAL(layoutChanged()));
+    model->sort(EntryModel::Title, Qt::AscendingOrder);
+    model->sort(EntryModel::Title, Qt::AscendingOrder);
+    QVERIFY(spyLayoutChanged.wait());
+    QCOMPARE(spyLayoutChanged.count(), 1);
+    QCOMPARE(model->data(model->index(0, EntryModel::Title)).toString(), QString("entry000001"));
+    QCOMPARE(model->data(model->index(1, EntryModel::Title)).toString(), QString("entry000002"));
+    QVERIFY(!first.isValid());
+
+    model->sort(EntryModel::Title, Qt::DescendingOrder);
+    QVERIFY(spyLayoutChanged.wait());
+    QCOMPARE(model->entryFromIndex(model->index(0, EntryModel::Title)), entries.first());
+    QCOMPARE(model->indexFromEntry(entries.at(1)).row(), 1);
+    QVERIFY(!model->indexFromEntry(entries.last()).isValid());
+
+    // Removing rows that were not fetched yet is invisible to views
+    QSignalSpy spyRemoved(model, SIGNAL(rowsRemoved(QModelIndex, int, int)));
+    delete entries.takeLast();
+    QCOMPARE(spyRemoved.count(), 0);
+    delete entries.takeFirst();
+    QCOMPARE(spyRemoved.count(), 1);
+    QCOMPARE(model->rowCount(), EntryModel::FetchBatchSize * 2 - 1);
+    QCOMPARE(model->entryFromIndex(model->index(0, EntryModel::Title)), entries.first());
+
+    // Edited entries are moved to their new place
+    entries.first()->setTitle("entry000000");
+    QVERIFY(spyLayoutChanged.wait());
+    QCOMPARE(model->entryFromIndex(model->index(0, EntryModel::Title)), entries.at(1));
+    QVERIFY(!model->indexFromEntry(entries.first()).isValid());
+
+    // Sorting is left to the proxy model for groups
+    model->setGroup(group);
+    QVERIFY(!model->isVirtualized());
+    QCOMPARE(model->rowCount(), entries.size());
+    QVERIFY(!model->canFetchMore({}));
+
+    delete model;
+}
+
+void TestEntryModel::testProxySortKeys()
+{
+    Database db;
+    auto group = db.rootGroup();
+
+    QList<Entry*> entries;
+    for (const auto& title : {"Entry 10", "entry 2", "Entry 9", "Entry 1"}) {
+        auto entry = new Entry();
+        entry->setTitle(title);
+        entry->setGroup(group);
+        entries << entry;
+    }
+
+    auto modelSource = new EntryModel(this);
+    auto modelProxy = new SortFilterHideProxyModel(this);
+    modelProxy->setSourceModel(modelSource);
+    modelProxy->setSortRole(Qt::UserRole);
+    modelProxy->setDynamicSortFilter(true);
+    auto modelTest = new ModelTest(modelProxy, this);
+
+    modelSource->setGroup(group);
+    modelProxy->sort(EntryModel::Title, Qt::AscendingOrder);
+
+    auto titles = [&] {
+        QStringList result;
+        for (int row = 0; row < modelProxy->rowCount(); ++row) {
+            result << modelProxy->index(row, EntryModel::Title).data().toString();
+        }
+        return result;
+    };
+    QCOMPARE(titles(), QStringList({"Entry 1", "entry 2", "Entry 9", "Entry 10"}));
+
+    // Cached keys must follow changes of the entries
+    entries.at(2)->setTitle("Entry 0");
+    QCOMPARE(titles(), QStringList({"Entry 0", "Entry 1", "entry 2", "Entry 10"}));
+
+    auto entry = new Entry();
+    entry->setTitle("Entry 3");
+    entry->setGroup(group);
+    QCOMPARE(titles(), QStringList({"Entry 0", "Entry 1", "entry 2", "Entry 3", "Entry 10"}));
+
+    delete entries.at(0);
+    QCOMPARE(titles(), QStringList({"Entry 0", "Entry 1", "entry 2", "Entry 3"}));
+
+    modelProxy->sort(EntryModel::Title, Qt::DescendingOrder);
+    QCOMPARE(titles(), QStringList({"Entry 3", "entry 2", "Entry 1", "Entry 0"}));
+
+    // Keys are computed again for another source model
+    auto modelSource2 = new EntryModel(this);
+    modelSource2->setGroup(group);
+    modelProxy->setSourceModel(modelSource2);
+    modelProxy->sort(EntryModel::Title, Qt::AscendingOrder);
+    QCOMPARE(titles(), QStringList({"Entry 0", "Entry 1", "entry 2", "Entry 3"}));
+
+    entries.at(1)->setTitle("Entry 4");
+    QCOMPARE(titles(), QStringList({"Entry 0", "Entry 1", "Entry 3", "Entry 4"}));
+
+    delete modelTest;
+    delete modelProxy;
+    delete modelSource2;
+    delete modelSource;
+}
+
+void TestEntryModel::testProxySortEmptyValues()
+{
+    // Rows without a sort value must be placed like QSortFilterProxyModel places them
+    QStandardItemModel modelSource;
+    const QVariantList texts({"cherry", QVariant(), "apple", QVariant(), "banana"});
+    const QVariantList numbers({3, QVariant(), 1, 2, QVariant()});
+    for (int row = 0; row < texts.size(); ++row) {
+        auto text = new QStandardItem();
+        text->setData(texts.at(row), Qt::UserRole);
+        text->setData(row, Qt::DisplayRole);
+        auto number = new QStandardItem();
+        number->setData(numbers.at(row), Qt::UserRole);
+        modelSource.appendRow({text, number});
+    }
+
+    SortFilterHideProxyModel modelProxy;
+    modelProxy.setSourceModel(&modelSource);
+    modelProxy.setSortRole(Qt::UserRole);
+    QSortFilterProxyModel modelExpected;
+    modelExpected.setSourceModel(&modelSource);
+    modelExpected.setSortRole(Qt::UserRole);
+
+    auto rows = [](const QAbstractItemModel& model) {
+        QList<int> result;
+        for (int row = 0; row < model.rowCount(); ++row) {
+            result << model.index(row, 0).data().toInt();
+        }
+        return result;
+    };
+
+    modelProxy.sort(0, Qt::AscendingOrder);
+    modelExpected.sort(0, Qt::AscendingOrder);
+    QCOMPARE(rows(modelProxy), QList<int>({2, 4, 0, 1, 3}));
+    QCOMPARE(rows(modelProxy), rows(modelExpected));
+
+    modelProxy.sort(0, Qt::DescendingOrder);
+    modelExpected.sort(0, Qt::DescendingOrder);
+    QCOMPARE(rows(modelProxy), QList<int>({1, 3, 0, 4, 2}));
+    QCOMPARE(rows(modelProxy), rows(modelExpected));
+
+    modelProxy.sort(1, Qt::AscendingOrder);
+    modelExpected.sort(1, Qt::AscendingOrder);
+    QCOMPARE(rows(modelProxy), QList<int>({2, 3, 0, 1, 4}));
+    QCOMPARE(rows(modelProxy), rows(modelExpected));
+}
@@ -34,6 +34,11 @@ private slots:
     void testAutoTypeAssociationsModel();
     void testProxyModel();
     void testDatabaseDelete();
+    void testBulkUpdate();
+    void testRowLookup();
+    void testVirtualizedSearch();
+    void testProxySortKeys();
+    void testProxySortEmptyValues();
 };
 
 #endif // KEEPASSX_TESTENTRYMODEL_H
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestFileWatcher.h"
+#include "core/FileWatcher.h"
+
+#include <QSignalSpy>
+#include <QTest>
+
+QTEST_GUILESS_MAIN(TestFileWatcher)
+
+void TestFileWatcher::init()
+{
+    m_dir.reset(new QTemporaryDir());
+    QVERIFY(m_dir->isValid());
+    m_path = m_dir->filePath("watched.kdbx");
+    writeFile(QByteArray(64 * 1024, 'a'));
+}
+
+void TestFileWatcher::writeFile(const QByteArray& data)
+{
+    QFile file(m_path);
+    QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+    QCOMPARE(file.write(data), data.size());
+    file.close();
+}
+
+void TestFileWatcher::testBoundedChecksum()
+{
+    FileWatcher watcher;
+    watcher.start(m_path, 0, 1);
+    // Only the head and the tail are read
+    QCOMPARE(watcher.lastCheckBytesRead(), qint64(2048));
+    QVERIFY(watcher.hasSameFileChecksum());
+
+    // A change in the tail is detected without reading the rest of the file
+    auto data = QByteArray(64 * 1024, 'a');
+    data[data.size() - 1] = 'b';
+    writeFile(data);
+    QVERIFY(!watcher.hasSameFileChecksum());
+    QCOMPARE(watcher.lastCheckBytesRead(), qint64(2048));
+
+    // Size changes are detected even if head and tail are identical
+    writeFile(QByteArray(32 * 1024, 'a'));
+    watcher.start(m_path, 0, 1);
+    writeFile(QByteArray(48 * 1024, 'a'));
+    QVERIFY(!watcher.hasSameFileChecksum());
+}
+
+void TestFileWatcher::testFullChecksum()
+{
+    FileWatcher watcher;
+    watcher.start(m_path);
+    QCOMPARE(watcher.lastCheckBytesRead(), qint64(64 * 1024));
+
+    auto data = QByteArray(64 * 1024, 'a');
+    data[data.size() / 2] = 'b';
+    writeFile(data);
+    QVERIFY(!watcher.hasSameFileChecksum());
+    QCOMPARE(watcher.totalBytesRead(), qint64(2 * 64 * 1024));
+}
+
+void TestFileWatcher::testSkipUnchangedMetadata()
+{
+    FileWatcher watcher;
+    QSignalSpy spy(&watcher, &FileWatcher::fileChanged);
+    watcher.start(m_path, 1, 1);
+    auto bytesRead = watcher.totalBytesRead();
+
+    // The metadata is hashed once more after it was first seen, then trusted
+    QTRY_VERIFY_WITH_TIMEOUT(watcher.skippedChecksums() > 0, 5000);
+    QCOMPARE(watcher.lastCheckBytesRead(), qint64(0));
+    QVERIFY(watcher.totalBytesRead() > bytesRead);
+    bytesRead = watcher.totalBytesRead();
+
+    QTRY_VERIFY_WITH_TIMEOUT(watcher.skippedChecksums() > 1, 5000);
+    QCOMPARE(watcher.totalBytesRead(), bytesRead);
+    QCOMPARE(spy.count(), 0);
+
+    writeFile(QByteArray(64 * 1024, 'b'));
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), 1, 5000);
+    QVERIFY(watcher.totalBytesRead() > bytesRead);
+}
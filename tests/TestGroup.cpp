@@ -1319,3 +1319,66 @@ void TestGroup::testAutoTypeState()
     QVERIFY(!entry1->groupAutoTypeEnabled());
     QVERIFY(entry2->groupAutoTypeEnabled());
 }
+
+void TestGroup::testBulkUpdate()
+{
+    Database db;
+    auto* root = db.rootGroup();
+
+    auto* group1 = new Group();
+    group1->setParent(root);
+    auto* group2 = new Group();
+    group2->setParent(root);
+
+    QList<Entry*> entries;
+    for (int i = 0; i < 10; ++i) {
+        auto* entry = new Entry();
+        entry->setGroup(group1);
+        entries << entry;
+    }
+
+    QSignalSpy spyAboutToChange1(group1, SIGNAL(entriesAboutToChange()));
+    QSignalSpy spyChanged1(group1, SIGNAL(entriesChanged()));
+    QSignalSpy spyRemoved1(group1, SIGNAL(entryRemoved(Entry*)));
+    QSignalSpy spyModified1(group1, SIGNAL(modified()));
+    QSignalSpy spyAboutToChange2(group2, SIGNAL(entriesAboutToChange()));
+    QSignalSpy spyChanged2(group2, SIGNAL(entriesChanged()));
+    QSignalSpy spyAdded2(group2, SIGNAL(entryAdded(Entry*)));
+
+    // Changes are announced once per group, per-entry signals are still emitted
+    db.moveEntries(entries.mid(0, 5), group2);
+    QVERIFY(!db.isBulkUpdating());
+    QCOMPARE(group1->entries(), entries.mid(5));
+    QCOMPARE(group2->entries(), entries.mid(0, 5));
+    QCOMPARE(spyAboutToChange1.count(), 1);
+    QCOMPARE(spyChanged1.count(), 1);
+    QCOMPARE(spyRemoved1.count(), 5);
+    QCOMPARE(spyModified1.count(), 1);
+    QCOMPARE(spyAboutToChange2.count(), 1);
+    QCOMPARE(spyChanged2.count(), 1);
+    QCOMPARE(spyAdded2.count(), 5);
+
+    // Nested updates are finished by the outermost call
+    db.beginBulkUpdate();
+    db.deleteEntries(entries.mid(5, 2));
+    QCOMPARE(spyChanged1.count(), 1);
+    QCOMPARE(group1->entries().size(), 3);
+    db.endBulkUpdate();
+    QCOMPARE(spyAboutToChange1.count(), 2);
+    QCOMPARE(spyChanged1.count(), 2);
+
+    // Groups deleted during a bulk update finish it on destruction
+    QSignalSpy spyChanged1Deleted(group1, SIGNAL(entriesChanged()));
+    db.beginBulkUpdate();
+    db.deleteEntries({group1->entries().first()});
+    delete group1;
+    QCOMPARE(spyChanged1Deleted.count(), 1);
+    db.endBulkUpdate();
+
+    // Recycled entries are moved into the recycle bin in a single update
+    db.metadata()->setRecycleBinEnabled(true);
+    db.recycleEntries(group2->entries());
+    QVERIFY(group2->entries().isEmpty());
+    QCOMPARE(db.metadata()->recycleBin()->entries(), entries.mid(0, 5));
+    QCOMPARE(spyChanged2.count(), 2);
+}
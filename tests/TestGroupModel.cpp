@@ -149,3 +149,50 @@ void TestGroupModel::test()
     delete modelTest;
     delete model;
 }
+
+void TestGroupModel::testRowLookup()
+{
+    Database db;
+    auto root = db.rootGroup();
+
+    QList<Group*> groups;
+    for (int i = 0; i < 20; ++i) {
+        auto group = new Group();
+        group->setName(QString("group%1").arg(i, 2, 10, QChar('0')));
+        group->setParent(root);
+        groups << group;
+    }
+    auto child = new Group();
+    child->setParent(groups.at(10));
+
+    auto model = new GroupModel(&db, this);
+    auto modelTest = new ModelTest(model, this);
+
+    auto verifyRows = [&] {
+        for (auto group : root->children()) {
+            QCOMPARE(model->index(group).row(), root->children().indexOf(group));
+            QCOMPARE(model->groupFromIndex(model->index(group)), group);
+        }
+        QCOMPARE(model->parent(model->index(child)), model->index(child->parentGroup()));
+    };
+
+    verifyRows();
+
+    // Insert at the front so every cached row is outdated
+    auto group = new Group();
+    group->setName("group");
+    group->setParent(root, 0);
+    verifyRows();
+
+    groups.at(10)->setParent(root);
+    verifyRows();
+
+    model->sortChildren(root, true);
+    verifyRows();
+
+    delete groups.at(5);
+    verifyRows();
+
+    delete modelTest;
+    delete model;
+}
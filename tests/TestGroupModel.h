@@ -27,6 +27,7 @@ class TestGroupModel : public QObject
 private slots:
     void initTestCase();
     void test();
+    void testRowLookup();
 };
 
 #endif // KEEPASSX_TESTGROUPMODEL_H
@@ -0,0 +1,235 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestHibpDownloader.h"
+#include "crypto/Crypto.h"
+#include "networking/HibpDownloader.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QTimer>
+
+QTEST_GUILESS_MAIN(TestHibpDownloader)
+
+namespace
+{
+    QString sha1Hex(const QString& password)
+    {
+        return QCryptographicHash::hash(password.toUtf8(), QCryptographicHash::Sha1).toHex().toUpper();
+    }
+
+    // Find two distinct passwords whose hashes share the 5 character range prefix
+    QPair<QString, QString> passwordsWithSharedPrefix()
+    {
+        QHash<QString, QString> seen;
+        for (int i = 0;; ++i) {
+            const auto password = QString("password%1").arg(i);
+            const auto prefix = sha1Hex(password).left(5);
+            if (seen.contains(prefix)) {
+                return {seen.value(prefix), password};
+            }
+            seen.insert(prefix, password);
+        }
+    }
+} // namespace
+
+void TestHibpDownloader::initTestCase()
+{
+    QVERIFY(Crypto::init());
+
+    // Local stand-in for the HIBP range API, answers every request
+    // after a short delay so that concurrent requests overlap
+    m_server = new QTcpServer(this);
+    QVERIFY(m_server->listen(QHostAddress::LocalHost));
+    connect(m_server, &QTcpServer::newConnection, this, [this] {
+        while (auto socket = m_server->nextPendingConnection()) {
+            connect(socket, &QTcpSocket::readyRead, socket, [this, socket] {
+                const auto request = socket->readAll();
+                if (!request.startsWith("GET ")) {
+                    return;
+                }
+                const auto path = request.mid(4, request.indexOf(' ', 4) - 4);
+                const auto prefix = QString::fromLatin1(path.mid(path.lastIndexOf('/') + 1));
+                m_requests << prefix;
+                m_maxOpenRequests = qMax(m_maxOpenRequests, ++m_openRequests);
+
+                QTimer::singleShot(20, socket, [this, socket, prefix] {
+                    --m_openRequests;
+                    QByteArray body = m_ranges.value(prefix);
+                    // Padding entries as sent by the real service
+                    body += "0000000000000000000000000000000000A:0\r\n";
+                    QByteArray status = m_fail ? "500 Internal Server Error" : "200 OK";
+                    socket->write("HTTP/1.1 " + status + "\r\nContent-Type: text/plain\r\nContent-Length: "
+                                  + QByteArray::number(body.size()) + "\r\nConnection: close\r\n\r\n" + body);
+                    socket->disconnectFromHost();
+                });
+            });
+            connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        }
+    });
+}
+
+void TestHibpDownloader::init()
+{
+    m_ranges.clear();
+    m_requests.clear();
+    m_openRequests = 0;
+    m_maxOpenRequests = 0;
+    m_fail = false;
+}
+
+void TestHibpDownloader::testSharedPrefix()
+{
+    const auto passwords = passwordsWithSharedPrefix();
+    const auto hash = sha1Hex(passwords.second);
+    m_ranges.insert(hash.left(5),
+                    QString("00000000000000000000000000000000001:3\r\n%1:42\r\nFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF:7\r\n")
+                        .arg(hash.mid(5))
+                        .toLatin1());
+
+    HibpDownloader downloader;
+    downloader.setBaseUrl(QString("http://127.0.0.1:%1/range/").arg(m_server->serverPort()));
+    downloader.setCacheDirectory({});
+    QSignalSpy results(&downloader, &HibpDownloader::hibpResult);
+
+    downloader.add(passwords.first);
+    downloader.add(passwords.second);
+    downloader.add(passwords.second);
+    QCOMPARE(downloader.passwordsToValidate(), 2);
+    downloader.validate();
+    QCOMPARE(downloader.passwordsRemaining(), 2);
+
+    QTRY_COMPARE(results.size(), 2);
+    QCOMPARE(downloader.passwordsRemaining(), 0);
+    QCOMPARE(m_requests, QStringList() << hash.left(5));
+
+    QHash<QString, int> counts;
+    for (const auto& result : results) {
+        counts.insert(result[0].toString(), result[1].toInt());
+    }
+    QCOMPARE(counts.value(passwords.first), 0);
+    QCOMPARE(counts.value(passwords.second), 42);
+}
+
+void TestHibpDownloader::testCache()
+{
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+
+    const QString password("correct horse battery staple");
+    const auto hash = sha1Hex(password);
+    m_ranges.insert(hash.left(5), QString("%1:5\r\n").arg(hash.mid(5)).toLatin1());
+
+    HibpDownloader downloader;
+    downloader.setBaseUrl(QString("http://127.0.0.1:%1/range/").arg(m_server->serverPort()));
+    downloader.setCacheDirectory(cacheDir.path());
+    QSignalSpy results(&downloader, &HibpDownloader::hibpResult);
+
+    downloader.add(password);
+    downloader.validate();
+    QTRY_COMPARE(results.size(), 1);
+    QCOMPARE(results[0][1].toInt(), 5);
+    QCOMPARE(m_requests.size(), 1);
+
+    // The second run is answered from the cache
+    downloader.add(password);
+    downloader.validate();
+    QTRY_COMPARE(results.size(), 2);
+    QCOMPARE(results[1][1].toInt(), 5);
+    QCOMPARE(m_requests.size(), 1);
+
+    // Expired cache entries are fetched again
+    downloader.setCacheTtl(-1);
+    downloader.add(password);
+    downloader.validate();
+    QTRY_COMPARE(results.size(), 3);
+    QCOMPARE(m_requests.size(), 2);
+}
+
+void TestHibpDownloader::testCachePruned()
+{
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    const QDir dir(cacheDir.path());
+
+    // One response that is still fresh and one that expired two days ago
+    const auto writeFile = [&dir](const QString& name, const QDateTime& modified) {
+        QFile file(dir.filePath(name));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("0000000000000000000000000000000000A:0\r\n");
+        QVERIFY(file.flush());
+        QVERIFY(file.setFileTime(modified, QFileDevice::FileModificationTime));
+    };
+    writeFile("FFFFF", QDateTime::currentDateTime());
+    writeFile("00000", QDateTime::currentDateTime().addDays(-2));
+
+    const QString password("correct horse battery staple");
+    HibpDownloader downloader;
+    downloader.setBaseUrl(QString("http://127.0.0.1:%1/range/").arg(m_server->serverPort()));
+    downloader.setCacheDirectory(cacheDir.path());
+    QSignalSpy results(&downloader, &HibpDownloader::hibpResult);
+
+    downloader.add(password);
+    downloader.validate();
+    QTRY_COMPARE(results.size(), 1);
+
+    QVERIFY(dir.exists(sha1Hex(password).left(5)));
+    QVERIFY(dir.exists("FFFFF"));
+    QVERIFY(!dir.exists("00000"));
+}
+
+void TestHibpDownloader::testConcurrencyLimit()
+{
+    HibpDownloader downloader;
+    downloader.setBaseUrl(QString("http://127.0.0.1:%1/range/").arg(m_server->serverPort()));
+    downloader.setCacheDirectory({});
+    downloader.setMaxConcurrentRequests(2);
+    QSignalSpy results(&downloader, &HibpDownloader::hibpResult);
+
+    for (int i = 0; i < 10; ++i) {
+        downloader.add(QString("limit%1").arg(i));
+    }
+    downloader.validate();
+
+    QTRY_COMPARE(results.size(), 10);
+    QVERIFY(m_maxOpenRequests <= 2);
+    QCOMPARE(downloader.passwordsRemaining(), 0);
+}
+
+void TestHibpDownloader::testFetchFailed()
+{
+    m_fail = true;
+
+    HibpDownloader downloader;
+    downloader.setBaseUrl(QString("http://127.0.0.1:%1/range/").arg(m_server->serverPort()));
+    downloader.setCacheDirectory({});
+    QSignalSpy results(&downloader, &HibpDownloader::hibpResult);
+    QSignalSpy failed(&downloader, &HibpDownloader::fetchFailed);
+
+    downloader.add("secret");
+    downloader.add("password");
+    downloader.validate();
+
+    QTRY_COMPARE(failed.size(), 1);
+    QCOMPARE(results.size(), 0);
+    QCOMPARE(downloader.passwordsRemaining(), 0);
+}
@@ -0,0 +1,48 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEEPASSXC_TESTHIBPDOWNLOADER_H
+#define KEEPASSXC_TESTHIBPDOWNLOADER_H
+
+#include <QHash>
+#include <QObject>
+
+class QTcpServer;
+
+class TestHibpDownloader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void testSharedPrefix();
+    void testCache();
+    void testCachePruned();
+    void testConcurrencyLimit();
+    void testFetchFailed();
+
+private:
+    QTcpServer* m_server = nullptr;
+    QHash<QString, QByteArray> m_ranges;
+    QStringList m_requests;
+    int m_openRequests = 0;
+    int m_maxOpenRequests = 0;
+    bool m_fail = false;
+};
+
+#endif // KEEPASSXC_TESTHIBPDOWNLOADER_H
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestKdbxXmlCodec.h"
+
+#include <QRandomGenerator>
+#include <QTest>
+
+#include "format/KdbxXmlCodec.h"
+
+QTEST_GUILESS_MAIN(TestKdbxXmlCodec)
+
+void TestKdbxXmlCodec::testPlainPrefix()
+{
+    // Place a single control character at every offset to cover vector and scalar paths
+    const QString clean = QString("Plain text\twith é中 and more text to span vectors").repeated(3);
+    QCOMPARE(KdbxXmlCodec::plainXml10Prefix(clean.constData(), clean.size()), clean.size());
+
+    for (int i = 0; i < clean.size(); ++i) {
+        QString text = clean;
+        text[i] = QChar(0x01);
+        QCOMPARE(KdbxXmlCodec::plainXml10Prefix(text.constData(), text.size()), i);
+    }
+
+    // Surrogate pairs and U+0085 are valid but left to the scalar check
+    const QString emoji = QString("abcdefghij") + QString::fromUcs4(U"\U0001F600");
+    QCOMPARE(KdbxXmlCodec::plainXml10Prefix(emoji.constData(), emoji.size()), 10);
+    const QString nel = QString("abcdefghij") + QChar(0x85);
+    QCOMPARE(KdbxXmlCodec::plainXml10Prefix(nel.constData(), nel.size()), 10);
+}
+
+void TestKdbxXmlCodec::testStripInvalidChars()
+{
+    const QString clean("An entry title that needs no changes");
+    const QString stripped = KdbxXmlCodec::stripInvalidXml10Chars(clean);
+    QCOMPARE(stripped, clean);
+    // Clean strings are returned without a copy
+    QVERIFY(stripped.isSharedWith(clean));
+
+    QString dirty = QString("0123456789abcdef") + QChar(0x02) + QChar(0x85) + QChar(0xD800) + "x"
+                    + QString::fromUcs4(U"\U0001F600") + QChar(0xFFFE) + QChar(0xDC00);
+    QCOMPARE(KdbxXmlCodec::stripInvalidXml10Chars(dirty),
+             QString("0123456789abcdef") + QChar(0x85) + "x" + QString::fromUcs4(U"\U0001F600"));
+}
+
+void TestKdbxXmlCodec::testBase64RoundTrip()
+{
+    QRandomGenerator random(7);
+    QString encoded;
+    for (int size = 0; size < 200; ++size) {
+        QByteArray data(size, Qt::Uninitialized);
+        for (int i = 0; i < size; ++i) {
+            data[i] = static_cast<char>(random.bounded(256));
+        }
+
+        KdbxXmlCodec::toBase64(data, encoded);
+        QCOMPARE(encoded, QString::fromLatin1(data.toBase64()));
+        QCOMPARE(KdbxXmlCodec::fromBase64(encoded), data);
+    }
+}
+
+void TestKdbxXmlCodec::testBase64NonCanonical()
+{
+    // Anything that is not canonical padded base64 must decode exactly as Qt does
+    const QStringList inputs = {"QUJD\nREVG", "QUJDRA", "QU JD", "QUJ=RA==", "====", "QUJDR*==", "éQUJ"};
+    for (const auto& input : inputs) {
+        QCOMPARE(KdbxXmlCodec::fromBase64(input), QByteArray::fromBase64(input.toLatin1()));
+    }
+}
@@ -0,0 +1,138 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestParallelGzipStream.h"
+
+#include <QRandomGenerator>
+#include <QTest>
+
+#include "FailDevice.h"
+#include "core/Endian.h"
+#include "streams/ParallelGzipStream.h"
+#include "streams/qtiocompressor.h"
+
+QTEST_GUILESS_MAIN(TestParallelGzipStream)
+
+namespace
+{
+    // XML-like input that is compressible but not trivially so
+    QByteArray sampleData(int size)
+    {
+        QRandomGenerator random(42);
+        QByteArray data;
+        while (data.size() < size) {
+            data.append("<Entry><String><Key>Password</Key><Value>");
+            for (int i = 0; i < 16; ++i) {
+                data.append(static_cast<char>('a' + random.bounded(26)));
+            }
+            data.append("</Value></String></Entry>\n");
+        }
+        data.truncate(size);
+        return data;
+    }
+
+    QByteArray inflate(QByteArray compressed)
+    {
+        QBuffer buffer(&compressed);
+        QtIOCompressor reader(&buffer);
+        reader.setStreamFormat(QtIOCompressor::GzipFormat);
+        if (!reader.open(QIODevice::ReadOnly)) {
+            return {};
+        }
+        return reader.readAll();
+    }
+
+    QByteArray deflate(const QByteArray& data, int level, int chunkSize)
+    {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        ParallelGzipStream writer(&buffer, level, chunkSize);
+        if (!writer.open(QIODevice::WriteOnly)) {
+            return {};
+        }
+        // Uneven writes so chunk boundaries don't line up with them
+        for (int pos = 0; pos < data.size(); pos += 7001) {
+            if (writer.write(data.mid(pos, 7001)) < 0) {
+                return {};
+            }
+        }
+        if (!writer.reset()) {
+            return {};
+        }
+        writer.close();
+        return buffer.data();
+    }
+} // namespace
+
+void TestParallelGzipStream::testRoundTrip()
+{
+    const QByteArray data = sampleData(1024 * 1024 + 123);
+    const QByteArray compressed = deflate(data, 6, 32 * 1024);
+
+    QVERIFY(compressed.size() > 18);
+    QVERIFY(compressed.size() < data.size());
+    QCOMPARE(compressed.left(3), QByteArray("\x1f\x8b\x08"));
+    QCOMPARE(Endian::bytesToSizedInt<quint32>(compressed.right(4), QSysInfo::LittleEndian),
+             static_cast<quint32>(data.size()));
+    QCOMPARE(inflate(compressed), data);
+
+    // Default chunk size, partially filled final chunk
+    QCOMPARE(inflate(deflate(data, 6, ParallelGzipStream::DefaultChunkSize)), data);
+
+    // A single write spanning several chunks after a partial one
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    ParallelGzipStream writer(&buffer, 6, 32 * 1024);
+    QVERIFY(writer.open(QIODevice::WriteOnly));
+    QCOMPARE(writer.write(data.left(1000)), qint64(1000));
+    QCOMPARE(writer.write(data.mid(1000)), qint64(data.size() - 1000));
+    QVERIFY(writer.reset());
+    writer.close();
+    QCOMPARE(inflate(buffer.data()), data);
+}
+
+void TestParallelGzipStream::testEmpty()
+{
+    const QByteArray compressed = deflate({}, 6, ParallelGzipStream::DefaultChunkSize);
+    QVERIFY(!compressed.isEmpty());
+    QVERIFY(inflate(compressed).isEmpty());
+}
+
+void TestParallelGzipStream::testCompressionLevels()
+{
+    const QByteArray data = sampleData(512 * 1024);
+    const QByteArray fast = deflate(data, 1, 64 * 1024);
+    const QByteArray best = deflate(data, 9, 64 * 1024);
+
+    QCOMPARE(inflate(fast), data);
+    QCOMPARE(inflate(best), data);
+    QVERIFY(best.size() <= fast.size());
+}
+
+void TestParallelGzipStream::testWriteFailure()
+{
+    FailDevice failDevice(1500);
+    QVERIFY(failDevice.open(QIODevice::WriteOnly));
+
+    ParallelGzipStream writer(&failDevice, 6, 32 * 1024);
+    QVERIFY(writer.open(QIODevice::WriteOnly));
+
+    const QByteArray data = sampleData(256 * 1024);
+    writer.write(data);
+    QVERIFY(!writer.reset());
+    QCOMPARE(writer.errorString(), QString("FAILDEVICE"));
+}
@@ -22,6 +22,7 @@
 
 #include <QRegularExpression>
 #include <QTest>
+#include <cmath>
 
 QTEST_GUILESS_MAIN(TestPassphraseGenerator)
 
@@ -68,3 +69,27 @@ void TestPassphraseGenerator::testUniqueEntriesInWordlist()
     // so this fails
     QVERIFY(!generator.isValid());
 }
+
+void TestPassphraseGenerator::testSharedWordlist()
+{
+    PassphraseGenerator generator1;
+    PassphraseGenerator generator2;
+    QVERIFY(generator1.isValid());
+
+    // Both generators use the same compiled default wordlist
+    QVERIFY(generator1.m_wordlist);
+    QCOMPARE(generator1.m_wordlist.data(), generator2.m_wordlist.data());
+    QCOMPARE(generator1.estimateEntropy(1), generator2.estimateEntropy(1));
+
+    generator1.setWordCount(5);
+    generator1.setWordSeparator("-");
+    QCOMPARE(generator1.generatePassphrase().split("-").size(), 5);
+
+    // Duplicates are dropped when compiling the wordlist
+    generator2.m_minimum_wordlist_length = 1;
+    generator2.setWordList(QString(KEEPASSX_TEST_DATA_DIR).append("/wordlists/bad_wordlist_with_duplicate_entries.wordlist"));
+    QVERIFY(generator2.isValid());
+    QVERIFY(generator2.m_wordlist.data() != generator1.m_wordlist.data());
+    QCOMPARE(generator2.estimateEntropy(1), std::log2(3));
+    QVERIFY(!generator2.generatePassphrase().isEmpty());
+}
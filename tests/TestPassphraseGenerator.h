@@ -28,6 +28,7 @@ private slots:
     void initTestCase();
     void testWordCase();
     void testUniqueEntriesInWordlist();
+    void testSharedWordlist();
 };
 
 #endif // KEEPASSXC_TESTPASSPHRASEGENERATOR_H
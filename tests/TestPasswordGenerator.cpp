@@ -281,3 +281,27 @@ void TestPasswordGenerator::testReset()
     QCOMPARE(m_generator.getExcludedCharacterSet(), default_generator.getExcludedCharacterSet());
     QCOMPARE(m_generator.getLength(), default_generator.getLength());
 }
+
+void TestPasswordGenerator::testSettingsChange()
+{
+    // Character tables are reused between passwords, but must follow setting changes
+    m_generator.setCharClasses(PasswordGenerator::CharClass::Numbers);
+    m_generator.setFlags(PasswordGenerator::GeneratorFlag::NoFlags);
+    m_generator.setLength(100);
+    QVERIFY(QRegularExpression("^[0-9]{100}$").match(m_generator.generatePassword()).hasMatch());
+
+    m_generator.setExcludedCharacterSet("0123456");
+    QVERIFY(QRegularExpression("^[789]{100}$").match(m_generator.generatePassword()).hasMatch());
+
+    m_generator.setCharClasses(PasswordGenerator::CharClass::LowerLetters);
+    QVERIFY(QRegularExpression("^[a-z]{100}$").match(m_generator.generatePassword()).hasMatch());
+
+    m_generator.setFlags(PasswordGenerator::GeneratorFlag::ExcludeLookAlike);
+    QVERIFY(!m_generator.generatePassword().contains('l'));
+
+    const auto passwords = m_generator.generatePasswords(1000);
+    QCOMPARE(passwords.size(), 1000);
+    for (const auto& password : passwords) {
+        QCOMPARE(password.size(), 100);
+    }
+}
@@ -17,7 +17,13 @@
 
 #include "TestPasswordHealth.h"
 
+#include "core/Database.h"
+#include "core/DatabaseSnapshot.h"
+#include "core/Entry.h"
+#include "core/Group.h"
 #include "core/PasswordHealth.h"
+#include "core/PasswordHealthIndex.h"
+#include "crypto/Crypto.h"
 
 #include <QTest>
 
@@ -25,6 +31,7 @@ QTEST_GUILESS_MAIN(TestPasswordHealth)
 
 void TestPasswordHealth::initTestCase()
 {
+    QVERIFY(Crypto::init());
 }
 
 void TestPasswordHealth::testNoDb()
@@ -64,3 +71,139 @@ void TestPasswordHealth::testNoDb()
     QVERIFY(excellent.scoreReason().isEmpty());
     QVERIFY(excellent.scoreDetails().isEmpty());
 }
+
+void TestPasswordHealth::testEntropyCache()
+{
+    // Memoized results must match a fresh evaluation
+    const auto first = PasswordHealth::estimateEntropy("Yohb2ChR4");
+    const auto second = PasswordHealth::estimateEntropy("Yohb2ChR4");
+    QCOMPARE(first, second);
+    QCOMPARE(int(first), 47);
+    QCOMPARE(PasswordHealth::estimateEntropy(""), 0.0);
+    QVERIFY(PasswordHealth::estimateEntropy("Yohb2ChR5") != 0.0);
+}
+
+void TestPasswordHealth::testParallelEvaluate()
+{
+    auto db = QSharedPointer<Database>::create();
+    QList<Entry*> entries;
+    const QStringList passwords = {"secret", "Yohb2ChR4", "MIhIN9UKrgtPL2hp", "secret", "", "MIhIN9UKrgtPL2hp"};
+    for (const auto& password : passwords) {
+        auto entry = new Entry();
+        entry->setUuid(QUuid::createUuid());
+        entry->setTitle(password);
+        entry->setPassword(password);
+        entry->setGroup(db->rootGroup());
+        entries << entry;
+    }
+
+    HealthChecker checker(db);
+    const auto results = checker.evaluate(entries);
+    QCOMPARE(results.size(), entries.size());
+    for (int i = 0; i < entries.size(); ++i) {
+        const auto expected = checker.evaluate(entries[i]);
+        QCOMPARE(results[i]->score(), expected->score());
+        QCOMPARE(results[i]->scoreReason(), expected->scoreReason());
+    }
+
+    // Re-used passwords are capped below "good"
+    QCOMPARE(results[2]->quality(), PasswordHealth::Quality::Weak);
+    QVERIFY(results[2]->scoreReason().contains("2"));
+}
+
+void TestPasswordHealth::testHealthIndex()
+{
+    auto db = QSharedPointer<Database>::create();
+    auto createEntry = [&db](Group* group, const QString& password) {
+        auto entry = new Entry();
+        entry->setUuid(QUuid::createUuid());
+        entry->setPassword(password);
+        entry->setGroup(group);
+        return entry;
+    };
+
+    auto entry1 = createEntry(db->rootGroup(), "MIhIN9UKrgtPL2hp");
+    auto entry2 = createEntry(db->rootGroup(), "MIhIN9UKrgtPL2hp");
+    auto entry3 = createEntry(db->rootGroup(), "secret");
+
+    auto index = db->healthIndex();
+    QVERIFY(index);
+    QCOMPARE(index->entriesUsingPassword("MIhIN9UKrgtPL2hp").size(), 2);
+    QCOMPARE(index->maxPasswordReuse(), 2);
+    QCOMPARE(index->reusedEntries().size(), 2);
+    QVERIFY(index->entriesUsingPassword("mihin9ukrgtpl2hp").isEmpty());
+    QVERIFY(index->entriesUsingPassword("").isEmpty());
+    QCOMPARE(index->weakEntries(), QList<const Entry*>() << entry3);
+    QVERIFY(index->expiringEntries(QDateTime::currentDateTimeUtc().addYears(1)).isEmpty());
+
+    // Editing an entry updates the index
+    entry2->setPassword("prompter-ream-oversleep-step-extortion-quarrel-reflected-prefix");
+    QCOMPARE(index->entriesUsingPassword("MIhIN9UKrgtPL2hp"), QList<const Entry*>() << entry1);
+    QCOMPARE(index->maxPasswordReuse(), 1);
+    QVERIFY(index->reusedEntries().isEmpty());
+
+    entry3->setPassword("oversleep-step-extortion-quarrel-reflected-prompter");
+    QVERIFY(index->weakEntries().isEmpty());
+
+    // Expiry dates are tracked
+    entry1->setExpiryTime(QDateTime::currentDateTimeUtc().addDays(10));
+    entry1->setExpires(true);
+    QCOMPARE(index->expiringEntries(QDateTime::currentDateTimeUtc().addDays(30)), QList<const Entry*>() << entry1);
+    QVERIFY(index->expiringEntries(QDateTime::currentDateTimeUtc()).isEmpty());
+
+    // Entries in new groups are tracked, removed entries are dropped
+    auto group = new Group();
+    group->setUuid(QUuid::createUuid());
+    auto entry4 = createEntry(group, "MIhIN9UKrgtPL2hp");
+    group->setParent(db->rootGroup());
+    QCOMPARE(index->entriesUsingPassword("MIhIN9UKrgtPL2hp").size(), 2);
+
+    delete entry4;
+    QCOMPARE(index->entriesUsingPassword("MIhIN9UKrgtPL2hp").size(), 1);
+
+    auto entry5 = createEntry(group, "secret");
+    QCOMPARE(index->weakEntries(), QList<const Entry*>() << entry5);
+    delete group;
+    QVERIFY(index->weakEntries().isEmpty());
+
+    // Recycled entries are ignored
+    entry2->setPassword("MIhIN9UKrgtPL2hp");
+    QCOMPARE(index->maxPasswordReuse(), 2);
+    db->recycleEntry(entry2);
+    QCOMPARE(index->maxPasswordReuse(), 1);
+}
+
+void TestPasswordHealth::testSnapshotEvaluate()
+{
+    auto db = QSharedPointer<Database>::create();
+    auto group = new Group();
+    group->setName("Sub");
+    group->setParent(db->rootGroup());
+
+    QList<Entry*> entries;
+    const QStringList passwords = {"secret", "Yohb2ChR4", "MIhIN9UKrgtPL2hp", "secret", "MIhIN9UKrgtPL2hp"};
+    for (const auto& password : passwords) {
+        auto entry = new Entry();
+        entry->setUuid(QUuid::createUuid());
+        entry->setTitle(password);
+        entry->setPassword(password);
+        entry->setGroup(entries.size() % 2 ? group : db->rootGroup());
+        entries << entry;
+    }
+    entries[1]->setExpires(true);
+    entries[1]->setExpiryTime(QDateTime::currentDateTime().addDays(5));
+
+    HealthChecker checker(db);
+    HealthChecker snapshotChecker(db->snapshot());
+    const auto snapshotEntries = db->snapshot()->entries();
+    QCOMPARE(snapshotEntries.size(), entries.size());
+    for (const auto& snapshotEntry : snapshotEntries) {
+        const auto entry = db->rootGroup()->findEntryByUuid(snapshotEntry.uuid);
+        QVERIFY(entry);
+        const auto expected = checker.evaluate(entry);
+        const auto health = snapshotChecker.evaluate(snapshotEntry);
+        QCOMPARE(health->score(), expected->score());
+        QCOMPARE(health->scoreReason(), expected->scoreReason());
+        QCOMPARE(health->scoreDetails(), expected->scoreDetails());
+    }
+}
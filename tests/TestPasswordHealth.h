@@ -27,6 +27,10 @@ class TestPasswordHealth : public QObject
 private slots:
     void initTestCase();
     void testNoDb();
+    void testEntropyCache();
+    void testParallelEvaluate();
+    void testHealthIndex();
+    void testSnapshotEvaluate();
 };
 
 #endif // KEEPASSX_TESTPASSWORDHEALTH_H
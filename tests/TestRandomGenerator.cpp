@@ -20,7 +20,9 @@
 #include "core/Global.h"
 #include "crypto/Random.h"
 
+#include <QSet>
 #include <QTest>
+#include <QtConcurrent>
 
 QTEST_GUILESS_MAIN(TestRandomGenerator)
 
@@ -58,3 +60,23 @@ void TestRandomGenerator::testUIntRange()
         QVERIFY(rand < 200);
     }
 }
+
+void TestRandomGenerator::testUIntBuffered()
+{
+    // Draw well past a single refill of the per-thread buffer
+    QSet<quint32> values;
+    for (int i = 0; i < 10000; ++i) {
+        values.insert(randomGen()->randomUInt(QUINT32_MAX));
+    }
+    QVERIFY(values.size() > 9990);
+
+    // Every thread draws from its own buffer
+    auto future = QtConcurrent::run([] {
+        QSet<quint32> threadValues;
+        for (int i = 0; i < 10000; ++i) {
+            threadValues.insert(randomGen()->randomUInt(QUINT32_MAX));
+        }
+        return threadValues;
+    });
+    QVERIFY(future.result().size() > 9990);
+}
@@ -18,6 +18,7 @@
 #include "TestTools.h"
 
 #include "core/Clock.h"
+#include "core/LatencyStats.h"
 
 #include <QRegularExpression>
 #include <QTest>
@@ -339,3 +340,29 @@ void TestTools::testMimeTypes()
         QCOMPARE(Tools::toMimeType(mime), Tools::MimeType::Unknown);
     }
 }
+
+void TestTools::testLatencyStats()
+{
+    LatencyStats stats(4);
+    QCOMPARE(stats.count(), 0);
+    QCOMPARE(stats.percentile(50), qint64(0));
+
+    for (qint64 msecs : {40, 10, 30, 20}) {
+        stats.record(msecs);
+    }
+    QCOMPARE(stats.count(), 4);
+    QCOMPARE(stats.percentile(50), qint64(20));
+    QCOMPARE(stats.percentile(95), qint64(40));
+    QCOMPARE(stats.maximum(), qint64(40));
+
+    // Only the most recent samples are kept
+    stats.record(50);
+    stats.record(60);
+    QCOMPARE(stats.count(), 4);
+    QCOMPARE(stats.percentile(0), qint64(30));
+    QCOMPARE(stats.percentile(50), qint64(40));
+    QCOMPARE(stats.maximum(), qint64(60));
+
+    stats.clear();
+    QCOMPARE(stats.count(), 0);
+}
@@ -127,6 +127,39 @@ void TestTotp::testTotpCode()
 
     time = 2000000000;
     QCOMPARE(Totp::generateTotp(settings, time), QString("69279037"));
+
+    // Test 10 digit TOTP, the whole truncated value is shown
+    settings->digits = 10;
+    time = 1111111111;
+    QCOMPARE(Totp::generateTotp(settings, time), QString("0414050471"));
+
+    time = 2000000000;
+    QCOMPARE(Totp::generateTotp(settings, time), QString("2069279037"));
+}
+
+void TestTotp::testBatchCodes()
+{
+    auto settings = Totp::createSettings("GEZDGNBVGY3TQOJQGEZDGNBVGY3TQOJQ", Totp::DEFAULT_DIGITS, Totp::DEFAULT_STEP);
+    auto steam = Totp::parseSettings("30;S", "63BEDWCQZKTQWPESARIERL5DTTQFCJTK");
+
+    // Current and next code share the same point in time
+    auto codes = Totp::generateCodes({settings, steam, {}}, 1111111109);
+    QCOMPARE(codes.size(), 3);
+    QCOMPARE(codes[0].current, QString("081804"));
+    QCOMPARE(codes[0].next, Totp::generateTotp(settings, 1111111109 + 30));
+    QCOMPARE(codes[0].validFor, 1u);
+    QCOMPARE(codes[1].current, Totp::generateTotp(steam, 1111111109));
+    QCOMPARE(codes[1].next, Totp::generateTotp(steam, 1111111109 + 30));
+    QCOMPARE(codes[2].current, QObject::tr("Invalid Settings", "TOTP"));
+    QVERIFY(codes[2].next.isEmpty());
+
+    // Changing the key or the digits invalidates the cached values
+    settings->key = "63BEDWCQZKTQWPESARIERL5DTTQFCJTK";
+    auto expected = Totp::createSettings(settings->key, Totp::DEFAULT_DIGITS, Totp::DEFAULT_STEP);
+    QCOMPARE(Totp::generateTotp(settings, 1111111109), Totp::generateTotp(expected, 1111111109));
+    settings->key = "GEZDGNBVGY3TQOJQGEZDGNBVGY3TQOJQ";
+    settings->digits = 8;
+    QCOMPARE(Totp::generateTotp(settings, 1111111111), QString("14050471"));
 }
 
 void TestTotp::testSteamTotp()
@@ -29,6 +29,7 @@ private slots:
     void initTestCase();
     void testParseSecret();
     void testTotpCode();
+    void testBatchCodes();
     void testSteamTotp();
     void testEntryHistory();
     void testKeePass2();
@@ -0,0 +1,155 @@
+/*
+ *  Copyright (C) 2026 KeePassXC Team <team@keepassxc.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 or (at your option)
+ *  version 3 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestTrace.h"
+#include "core/Database.h"
+#include "core/Merger.h"
+#include "core/Trace.h"
+#include "crypto/Crypto.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTest>
+#include <QtConcurrent>
+
+QTEST_GUILESS_MAIN(TestTrace)
+
+void TestTrace::initTestCase()
+{
+    QVERIFY(Crypto::init());
+}
+
+void TestTrace::init()
+{
+    m_dir.reset(new QTemporaryDir());
+    QVERIFY(m_dir->isValid());
+    m_path = m_dir->filePath("trace.json");
+}
+
+void TestTrace::cleanup()
+{
+    Trace::stop();
+}
+
+QJsonArray TestTrace::readTrace()
+{
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    QJsonParseError error;
+    auto doc = QJsonDocument::fromJson(file.readAll(), &error);
+    if (error.error != QJsonParseError::NoError) {
+        qWarning("Invalid trace: %s", qPrintable(error.errorString()));
+    }
+    return doc.array();
+}
+
+void TestTrace::testDisabled()
+{
+    QVERIFY(!Trace::isEnabled());
+    QVERIFY(Trace::fileName().isEmpty());
+    {
+        TRACE_SPAN("TestTrace::disabled");
+    }
+    QVERIFY(!QFile::exists(m_path));
+}
+
+void TestTrace::testSpans()
+{
+    QVERIFY(Trace::start(m_path));
+    QVERIFY(Trace::isEnabled());
+    QCOMPARE(Trace::fileName(), m_path);
+
+    {
+        TRACE_SPAN("TestTrace::outer");
+        {
+            TRACE_SPAN("TestTrace::inner");
+            QTest::qSleep(5);
+        }
+        QtConcurrent::run([] { TRACE_SPAN("TestTrace::worker"); }).waitForFinished();
+    }
+
+    Trace::stop();
+    QVERIFY(!Trace::isEnabled());
+
+    // Spans created after stopping are dropped
+    {
+        TRACE_SPAN("TestTrace::dropped");
+    }
+
+    QJsonObject outer, inner, worker;
+    int processNames = 0;
+    for (const auto& value : readTrace()) {
+        auto event = value.toObject();
+        auto name = event["name"].toString();
+        if (name == "process_name") {
+            QCOMPARE(event["ph"].toString(), QString("M"));
+            ++processNames;
+            continue;
+        }
+        QCOMPARE(event["ph"].toString(), QString("X"));
+        QCOMPARE(event["pid"].toInt(), static_cast<int>(QCoreApplication::applicationPid()));
+        if (name == "TestTrace::outer") {
+            outer = event;
+        } else if (name == "TestTrace::inner") {
+            inner = event;
+        } else if (name == "TestTrace::worker") {
+            worker = event;
+        } else {
+            QFAIL(qPrintable(QString("Unexpected event %1").arg(name)));
+        }
+    }
+
+    QCOMPARE(processNames, 1);
+    QVERIFY(!outer.isEmpty());
+    QVERIFY(!inner.isEmpty());
+    QVERIFY(!worker.isEmpty());
+
+    // Inner span is nested within the outer span on the same thread
+    QCOMPARE(inner["tid"].toInt(), outer["tid"].toInt());
+    QVERIFY(inner["dur"].toDouble() >= 5000.0);
+    QVERIFY(inner["ts"].toDouble() >= outer["ts"].toDouble());
+    QVERIFY(inner["ts"].toDouble() + inner["dur"].toDouble()
+            <= outer["ts"].toDouble() + outer["dur"].toDouble());
+    QVERIFY(worker["tid"].toInt() != outer["tid"].toInt());
+}
+
+void TestTrace::testInstrumentedMerge()
+{
+    Database source;
+    Database target;
+
+    QVERIFY(Trace::start(m_path));
+    Merger merger(&source, &target);
+    merger.merge();
+    Trace::stop();
+
+    bool found = false;
+    for (const auto& value : readTrace()) {
+        found |= value.toObject()["name"].toString() == "Merger::merge";
+    }
+    QVERIFY(found);
+}
+
+void TestTrace::testInvalidFile()
+{
+    QString error;
+    QVERIFY(!Trace::start(m_dir->filePath("missing/trace.json"), &error));
+    QVERIFY(!error.isEmpty());
+    QVERIFY(!Trace::isEnabled());
+}
@@ -1901,6 +1901,30 @@ void TestGui::testDatabaseLocking()
     QCOMPARE(actionDatabaseMerge->isEnabled(), true);
 }
 
+void TestGui::testLockDuringBackgroundSave()
+{
+    m_db->metadata()->setName("testLockDuringBackgroundSave");
+    QTRY_VERIFY(m_db->isModified());
+    QSignalSpy saveSpy(m_db.data(), &Database::saveFinished);
+    QSignalSpy lockSpy(m_dbWidget.data(), &DatabaseWidget::databaseLockRequested);
+
+    // Try to lock again from within the wait for the save
+    bool nestedLocked = true;
+    connect(m_db.data(), &Database::saveFinished, m_dbWidget.data(), [&] { nestedLocked = m_dbWidget->lock(); });
+
+    m_db->saveInBackground();
+    QVERIFY(m_db->isSaving());
+    QVERIFY(m_dbWidget->lock());
+    QVERIFY(m_dbWidget->isLocked());
+
+    // The save completed before the data was released, the nested attempt was turned away
+    QCOMPARE(saveSpy.count(), 1);
+    QVERIFY(saveSpy.first().at(0).toBool());
+    QVERIFY(!nestedLocked);
+    QCOMPARE(lockSpy.count(), 1);
+    checkDatabase(m_dbFilePath, "testLockDuringBackgroundSave");
+}
+
 void TestGui::testDragAndDropKdbxFiles()
 {
     const int openedDatabasesCount = m_tabWidget->count();